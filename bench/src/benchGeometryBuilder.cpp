@@ -5,6 +5,7 @@
 
 #include "util/builders.h"
 #include "glm/glm.hpp"
+#include <cmath>
 #include <vector>
 
 using namespace Tangram;
@@ -57,4 +58,48 @@ static void BM_Tangram_BuildRoundRoundLine(benchmark::State& state) {
 }
 BENCHMARK(BM_Tangram_BuildRoundRoundLine);
 
+static Polygon ringPolygon() {
+    Polygon polygon(2);
+    for (int i = 0; i < 256; i++) {
+        float a = 2.f * M_PI * i / 256.f;
+        polygon[0].emplace_back(0.5f + 0.4f * std::cos(a), 0.5f + 0.4f * std::sin(a));
+        polygon[1].emplace_back(0.5f + 0.2f * std::cos(-a), 0.5f + 0.2f * std::sin(-a));
+    }
+    return polygon;
+}
+
+static void BM_Tangram_BuildPolygon(benchmark::State& state) {
+    Polygon polygon = ringPolygon();
+    std::vector<glm::vec3> vertices;
+    PolygonBuilder builder {
+        [&](const glm::vec3& coord, const glm::vec3& normal, const glm::vec2& uv) {
+            vertices.push_back(coord);
+        }
+    };
+    while(state.KeepRunning()) {
+        vertices.clear();
+        builder.clear();
+        Builders::buildPolygon(polygon, 0.f, builder);
+    }
+}
+BENCHMARK(BM_Tangram_BuildPolygon);
+
+static void BM_Tangram_BuildPolygonCached(benchmark::State& state) {
+    Polygon polygon = ringPolygon();
+    TessellationCache cache;
+    std::vector<glm::vec3> vertices;
+    PolygonBuilder builder {
+        [&](const glm::vec3& coord, const glm::vec3& normal, const glm::vec2& uv) {
+            vertices.push_back(coord);
+        }
+    };
+    builder.tessellationCache = &cache;
+    while(state.KeepRunning()) {
+        vertices.clear();
+        builder.clear();
+        Builders::buildPolygon(polygon, 0.f, builder);
+    }
+}
+BENCHMARK(BM_Tangram_BuildPolygonCached);
+
 BENCHMARK_MAIN();
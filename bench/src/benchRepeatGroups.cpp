@@ -0,0 +1,84 @@
+#include "benchmark/benchmark.h"
+
+#include "labels/repeatGroupIndex.h"
+
+#include "glm/gtx/norm.hpp"
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace Tangram;
+
+// Synthetic label-dense viewport: road labels of a few long streets, each street
+// being one repeat group with labels spread along the whole viewport.
+struct RepeatLabel {
+    size_t group;
+    glm::vec2 position;
+};
+
+static const glm::vec2 viewport{1920, 1080};
+static const float repeat_distance = 32.f;
+
+static std::vector<RepeatLabel> makeLabels(size_t _count, size_t _groups) {
+    std::vector<RepeatLabel> labels;
+    std::mt19937 random(0);
+    std::uniform_real_distribution<float> x(0, viewport.x);
+    std::uniform_real_distribution<float> y(0, viewport.y);
+
+    for (size_t i = 0; i < _count; i++) {
+        labels.push_back({ i % _groups, { x(random), y(random) } });
+    }
+    return labels;
+}
+
+// Previous implementation: all placed labels of a group are checked
+static void BM_Tangram_RepeatGroupsLinear(benchmark::State& state) {
+    auto labels = makeLabels(state.range(0), 8);
+    float threshold2 = repeat_distance * repeat_distance;
+
+    while (state.KeepRunning()) {
+        std::unordered_map<size_t, std::vector<glm::vec2>> groups;
+        size_t placed = 0;
+
+        for (auto& label : labels) {
+            bool within = false;
+            auto it = groups.find(label.group);
+            if (it != groups.end()) {
+                for (auto& position : it->second) {
+                    if (glm::distance2(label.position, position) < threshold2) {
+                        within = true;
+                        break;
+                    }
+                }
+            }
+            if (!within) {
+                groups[label.group].push_back(label.position);
+                placed++;
+            }
+        }
+        benchmark::DoNotOptimize(placed);
+    }
+}
+BENCHMARK(BM_Tangram_RepeatGroupsLinear)->Range(1 << 10, 1 << 14);
+
+static void BM_Tangram_RepeatGroupIndex(benchmark::State& state) {
+    auto labels = makeLabels(state.range(0), 8);
+    RepeatGroupIndex index;
+
+    while (state.KeepRunning()) {
+        index.clear();
+        size_t placed = 0;
+
+        for (auto& label : labels) {
+            if (!index.within(label.group, label.position, repeat_distance)) {
+                index.insert(label.group, label.position, repeat_distance);
+                placed++;
+            }
+        }
+        benchmark::DoNotOptimize(placed);
+    }
+}
+BENCHMARK(BM_Tangram_RepeatGroupIndex)->Range(1 << 10, 1 << 14);
+
+BENCHMARK_MAIN();
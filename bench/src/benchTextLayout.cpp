@@ -0,0 +1,73 @@
+#include "benchmark/benchmark.h"
+
+#include "data/tileSource.h"
+#include "gl.h"
+#include "log.h"
+#include "map.h"
+#include "mockPlatform.h"
+#include "scene/scene.h"
+#include "style/style.h"
+#include "text/fontContext.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileTask.h"
+#include "util/builders.h"
+
+#include <mutex>
+#include <vector>
+
+using namespace Tangram;
+
+const char scene_file[] = "res/scene.yaml";
+const char tile_file[] = "res/tile.mvt";
+
+std::shared_ptr<Scene> scene;
+std::shared_ptr<TileSource> source;
+std::shared_ptr<TileData> tileData;
+MockPlatform platform;
+
+void globalSetup() {
+    SceneOptions sceneOptions{platform.resolveUrl(Url(scene_file))};
+    sceneOptions.numTileWorkers = 0;
+    sceneOptions.prefetchTiles = false;
+
+    scene = std::make_shared<Scene>(platform, std::move(sceneOptions));
+    if (!scene->load()) { exit(-1); }
+
+    for (auto& s : scene->tileSources()) {
+        source = s;
+        if (source->generateGeometry()) { break; }
+    }
+
+    Tile tile({0,0,10,10});
+    auto task = source->createTask(tile.getID());
+    auto& t = dynamic_cast<BinaryTileTask&>(*task);
+
+    auto rawTileData = MockPlatform::getBytesFromFile(tile_file);
+    t.rawTileData = std::make_shared<std::vector<char>>(rawTileData);
+    tileData = source->parse(*task);
+    if (!tileData) {
+        LOGE("Invalid tile file '%s'", tile_file);
+        exit(-1);
+    }
+    // Shared by all builders below, as for TileData retained across scenes
+    tileData->tessellations = std::make_shared<TessellationCache>();
+}
+
+// Build the same tile on each thread, with one TileBuilder per thread like
+// the TileWorkers. All builders shape text with the same FontContext.
+static void BM_Tangram_BuildTileThreads(benchmark::State& state) {
+    static std::once_flag setup;
+    std::call_once(setup, globalSetup);
+
+    TileBuilder tileBuilder(*scene, new StyleContext());
+    tileBuilder.init();
+
+    while (state.KeepRunning()) {
+        auto tile = tileBuilder.build({0,0,10,10}, *tileData, *source);
+        benchmark::DoNotOptimize(tile);
+    }
+}
+BENCHMARK(BM_Tangram_BuildTileThreads)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#include "benchmark/benchmark.h"
+
+#include "data/tileSource.h"
+#include "mockPlatform.h"
+#include "tile/tile.h"
+#include "tile/tileManager.h"
+#include "tile/tileTask.h"
+#include "view/view.h"
+
+using namespace Tangram;
+
+// Drives TileManager::updateTileSets with a tilted perspective view over several
+// sources, as in a scene with a tile source per data layer.
+
+static const int source_count = 6;
+
+struct BenchTileSource : TileSource {
+
+    class Task : public TileTask {
+    public:
+        Task(TileID& _tileId, std::shared_ptr<TileSource> _source) : TileTask(_tileId, _source) {}
+
+        bool hasData() const override { return true; }
+    };
+
+    explicit BenchTileSource(int _index) : TileSource("source" + std::to_string(_index), nullptr) {
+        m_generateGeometry = true;
+    }
+
+    void loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override {
+        _task->startedLoading();
+        _cb.func(std::move(_task));
+    }
+
+    void cancelLoadingTile(TileTask& _task) override {}
+
+    std::shared_ptr<TileData> parse(const TileTask& _task) const override { return nullptr; }
+
+    void clearData() override {}
+
+    std::shared_ptr<TileTask> createTask(TileID _tileId) override {
+        return std::make_shared<Task>(_tileId, shared_from_this());
+    }
+};
+
+// Completes every task immediately
+struct BenchTileWorker : TileTaskQueue {
+    void enqueue(std::shared_ptr<TileTask> _task) override {
+        _task->setTile(std::make_unique<Tile>(_task->tileId(), _task->source()->id(),
+                                              _task->source()->generation()));
+    }
+};
+
+static void updateTileSets(benchmark::State& state) {
+    MockPlatform platform;
+    BenchTileWorker worker;
+    TileManager tileManager(platform, worker);
+
+    std::vector<std::shared_ptr<TileSource>> sources;
+    for (int i = 0; i < source_count; i++) {
+        sources.push_back(std::make_shared<BenchTileSource>(i));
+    }
+    tileManager.setTileSources(sources);
+
+    View view(1920, 1080);
+    view.setZoom(16.5f);
+    view.setPitch(state.range(0) * PI / 180.f);
+    view.setCenterCoordinates(LngLat(-74.00, 40.71));
+
+    // Load the tiles of the initial view
+    view.update();
+    tileManager.updateTileSets(view);
+    tileManager.updateTileSets(view);
+
+    size_t frame = 0;
+    while (state.KeepRunning()) {
+        // Pan slowly, so that tiles enter and leave the view from time to time
+        view.translate(frame++ % 2 ? 2.0 : -1.0, 0.0);
+        view.update();
+        tileManager.updateTileSets(view);
+    }
+
+    state.counters["tiles"] = tileManager.getVisibleTiles().size();
+}
+BENCHMARK(updateTileSets)->Arg(0)->Arg(45)->Arg(70);
+
+// Frames of an idle view, as drawn by continuously rendering displays
+static void updateTileSetsIdle(benchmark::State& state) {
+    MockPlatform platform;
+    BenchTileWorker worker;
+    TileManager tileManager(platform, worker);
+
+    std::vector<std::shared_ptr<TileSource>> sources;
+    for (int i = 0; i < source_count; i++) {
+        sources.push_back(std::make_shared<BenchTileSource>(i));
+    }
+    tileManager.setTileSources(sources);
+
+    View view(1920, 1080);
+    view.setZoom(16.5f);
+    view.setPitch(45 * PI / 180.f);
+    view.setCenterCoordinates(LngLat(-74.00, 40.71));
+
+    view.update();
+    tileManager.updateTileSets(view);
+    tileManager.updateTileSets(view);
+
+    while (state.KeepRunning()) {
+        view.update();
+        if (tileManager.needsUpdate(view)) {
+            tileManager.updateTileSets(view);
+        }
+    }
+}
+BENCHMARK(updateTileSetsIdle);
+
+BENCHMARK_MAIN();
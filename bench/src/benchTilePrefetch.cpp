@@ -0,0 +1,157 @@
+#include "benchmark/benchmark.h"
+
+#include "data/tileSource.h"
+#include "mockPlatform.h"
+#include "tile/tile.h"
+#include "tile/tileManager.h"
+#include "tile/tileTask.h"
+#include "util/inputHandler.h"
+#include "util/mapProjection.h"
+#include "view/view.h"
+
+#include <algorithm>
+#include <deque>
+#include <set>
+
+using namespace Tangram;
+
+// Replays scripted flings and measures for how long visible tiles are blank, i.e.
+// not loaded yet, with and without prefetching tiles along the predicted fling path.
+
+static const float frame_time = 1.f / 60.f;
+static const int frames_per_fling = 120;
+
+// Simulated network: requests complete after a fixed latency, at most a few per frame
+static const int request_latency_frames = 12;
+static const size_t requests_per_frame = 4;
+
+struct Fling {
+    glm::vec2 velocity;
+};
+
+static const Fling flings[] = {
+    {{ 3000.f, 0.f }}, {{ 0.f, -2500.f }}, {{ -2000.f, 2000.f }},
+    {{ 4000.f, 1000.f }}, {{ -1500.f, -3500.f }},
+};
+
+struct ReplayTileSource : TileSource {
+
+    class Task : public TileTask {
+    public:
+        bool gotData = false;
+        int requestFrame = 0;
+
+        Task(TileID& _tileId, std::shared_ptr<TileSource> _source)
+            : TileTask(_tileId, _source) {}
+
+        bool hasData() const override { return gotData; }
+    };
+
+    std::deque<std::pair<std::shared_ptr<TileTask>, TileTaskCb>> requests;
+    int frame = 0;
+    size_t requestCount = 0;
+
+    ReplayTileSource() : TileSource("replay", nullptr) {
+        m_generateGeometry = true;
+    }
+
+    void loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override {
+        _task->startedLoading();
+        static_cast<Task&>(*_task).requestFrame = frame;
+        requests.emplace_back(std::move(_task), std::move(_cb));
+        requestCount++;
+    }
+
+    void cancelLoadingTile(TileTask& _task) override {
+        requests.erase(std::remove_if(requests.begin(), requests.end(),
+                                      [&](auto& r) { return r.first.get() == &_task; }),
+                       requests.end());
+    }
+
+    // Completes the requests that are due in this frame
+    void update() {
+        frame++;
+        for (size_t i = 0; i < requests_per_frame && !requests.empty(); i++) {
+            auto& task = static_cast<Task&>(*requests.front().first);
+            if (frame - task.requestFrame < request_latency_frames) { break; }
+
+            task.gotData = true;
+            requests.front().second.func(requests.front().first);
+            requests.pop_front();
+        }
+    }
+
+    std::shared_ptr<TileData> parse(const TileTask& _task) const override { return nullptr; }
+
+    void clearData() override {}
+
+    std::shared_ptr<TileTask> createTask(TileID _tileId) override {
+        return std::make_shared<Task>(_tileId, shared_from_this());
+    }
+};
+
+struct ImmediateTileWorker : TileTaskQueue {
+    void enqueue(std::shared_ptr<TileTask> _task) override {
+        if (_task->isCanceled()) { return; }
+        _task->setTile(std::make_unique<Tile>(_task->tileId(), _task->source()->id(),
+                                              _task->source()->generation()));
+    }
+};
+
+static void replayFlings(benchmark::State& state) {
+    bool prefetch = state.range(0);
+
+    double blankTileSeconds = 0;
+    size_t requests = 0;
+
+    while (state.KeepRunning()) {
+        MockPlatform platform;
+        ImmediateTileWorker worker;
+        TileManager tileManager(platform, worker);
+
+        auto source = std::make_shared<ReplayTileSource>();
+        tileManager.setTileSources({ source });
+
+        View view(1024, 768);
+        view.setZoom(14);
+        view.setCenterCoordinates(LngLat(-74.00, 40.71));
+        InputHandler inputHandler(view);
+
+        for (const auto& fling : flings) {
+            inputHandler.handleFlingGesture(512, 384, fling.velocity.x, fling.velocity.y);
+
+            for (int frame = 0; frame < frames_per_fling; frame++) {
+                source->update();
+                inputHandler.update(frame_time);
+                view.update();
+
+                std::vector<glm::dvec3> path;
+                glm::dvec3 target;
+                if (prefetch && inputHandler.getFlingTarget(target)) {
+                    glm::dvec3 start(view.getPosition().x, view.getPosition().y, view.getZoom());
+                    for (int i = 1; i <= 4; i++) {
+                        path.push_back(glm::mix(start, target, i / 4.));
+                    }
+                }
+                tileManager.setPrefetchPath(std::move(path));
+                tileManager.updateTileSets(view);
+
+                std::set<TileID> visibleTiles;
+                view.getVisibleTiles([&](TileID _tileID) { visibleTiles.insert(_tileID); });
+
+                size_t readyTiles = 0;
+                for (const auto& tile : tileManager.getVisibleTiles()) {
+                    if (visibleTiles.count(tile->getID())) { readyTiles++; }
+                }
+                blankTileSeconds += (visibleTiles.size() - readyTiles) * frame_time;
+            }
+        }
+        requests += source->requestCount;
+    }
+
+    state.counters["blank_tile_s"] = blankTileSeconds / state.iterations();
+    state.counters["requests"] = double(requests) / state.iterations();
+}
+BENCHMARK(replayFlings)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,124 @@
+#include "benchmark/benchmark.h"
+
+#include "data/tileSource.h"
+#include "log.h"
+#include "mockPlatform.h"
+#include "scene/scene.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileTask.h"
+#include "util/mapProjection.h"
+#include "view/view.h"
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+
+using namespace Tangram;
+
+// Selects the visible tiles of a 1920x1080 view at several pitch angles, with tiles of
+// lower zoom levels chosen by distance bands (max tile screen size 0) or by their
+// projected size. getVisibleTiles reports the number of tiles and how many of them are
+// at the zoom level of the view; buildVisibleTiles the time to build all of them.
+
+const char scene_file[] = "res/scene.yaml";
+const char tile_file[] = "res/tile.mvt";
+
+static std::set<TileID> selectTiles(View& _view, int _pitch, int _screenSize) {
+    _view.setZoom(16.5f);
+    _view.setMaxPitch(90.f);
+    _view.setPitch(_pitch * PI / 180.f);
+    _view.setMaxTileScreenSize(_screenSize);
+    _view.setCenterCoordinates(LngLat(-74.00, 40.71));
+    _view.update();
+
+    std::set<TileID> tiles;
+    _view.getVisibleTiles([&](TileID _tileID) { tiles.insert(_tileID); });
+    return tiles;
+}
+
+static void getVisibleTiles(benchmark::State& state) {
+    View view(1920, 1080);
+    auto tiles = selectTiles(view, state.range(0), state.range(1));
+
+    size_t fullZoomTiles = std::count_if(tiles.begin(), tiles.end(), [&](const TileID& _tileID) {
+        return _tileID.z == view.getIntegerZoom();
+    });
+
+    while (state.KeepRunning()) {
+        size_t count = 0;
+        view.getVisibleTiles([&](TileID _tileID) { count++; });
+        benchmark::DoNotOptimize(count);
+    }
+
+    state.counters["tiles"] = tiles.size();
+    state.counters["z16_tiles"] = fullZoomTiles;
+}
+
+MockPlatform platform;
+std::shared_ptr<Scene> scene;
+std::shared_ptr<TileSource> source;
+std::shared_ptr<TileData> tileData;
+
+static void loadScene() {
+    static std::atomic<bool> initialized{false};
+    if (initialized.exchange(true)) { return; }
+
+    SceneOptions sceneOptions{platform.resolveUrl(Url(scene_file))};
+    sceneOptions.numTileWorkers = 0;
+    sceneOptions.prefetchTiles = false;
+
+    scene = std::make_shared<Scene>(platform, std::move(sceneOptions));
+    if (!scene->load()) { exit(-1); }
+
+    for (auto& s : scene->tileSources()) {
+        source = s;
+        if (source->generateGeometry()) { break; }
+    }
+
+    auto task = source->createTask({0,0,10,10});
+    auto& t = dynamic_cast<BinaryTileTask&>(*task);
+    t.rawTileData = std::make_shared<std::vector<char>>(MockPlatform::getBytesFromFile(tile_file));
+    tileData = source->parse(*task);
+    if (!tileData) {
+        LOGE("Invalid tile file '%s'", tile_file);
+        exit(-1);
+    }
+}
+
+// Builds the tiles of the source that TileManager would load for the selection.
+// Every tile is built from the same fixture data, so the times differ by the number
+// of tiles and by the zoom-dependent styling of their levels.
+static void buildVisibleTiles(benchmark::State& state) {
+    loadScene();
+
+    View view(1920, 1080);
+    std::set<TileID> tiles;
+    for (const auto& tileID : selectTiles(view, state.range(0), state.range(1))) {
+        tiles.insert(tileID.zoomBiasAdjusted(source->zoomBias()).withMaxSourceZoom(source->maxZoom()));
+    }
+
+    TileBuilder tileBuilder(*scene);
+    tileBuilder.init();
+
+    while (state.KeepRunning()) {
+        for (const auto& tileID : tiles) {
+            auto tile = tileBuilder.build(tileID, *tileData, *source);
+            benchmark::DoNotOptimize(tile);
+        }
+    }
+
+    state.counters["tiles"] = tiles.size();
+}
+
+static void pitchAndScreenSize(benchmark::internal::Benchmark* _benchmark) {
+    for (int pitch : { 0, 45, 60, 70, 80 }) {
+        for (int screenSize : { 0, 256, 512, 1024 }) {
+            _benchmark->Args({ pitch, screenSize });
+        }
+    }
+}
+BENCHMARK(getVisibleTiles)->Apply(pitchAndScreenSize);
+BENCHMARK(buildVisibleTiles)->Apply(pitchAndScreenSize)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -10,6 +10,7 @@
 namespace Tangram {
 
 struct TileData;
+class TileDataCache;
 struct TileID;
 struct Raster;
 class RasterSource;
@@ -18,6 +19,8 @@ class TileManager;
 struct RawCache;
 class Texture;
 
+namespace Mvt { class StreamParser; }
+
 class TileSource : public std::enable_shared_from_this<TileSource> {
 
 public:
@@ -61,8 +64,19 @@ public:
             if (next) { next->cancelLoadingTile(_task); }
         }
 
+        /* Passes the changed priority of @_task to its running I/O tasks */
+        virtual void updateTaskPriority(TileTask& _task) {
+            if (next) { next->updateTaskPriority(_task); }
+        }
+
         virtual void clear() { if (next) next->clear(); }
 
+        /* Creates a task to revalidate the cached data of @_task with the last source
+         * of the chain, which receives the validators of its cacheInfo. Returns nullptr
+         * when the TileSource is gone.
+         */
+        std::shared_ptr<BinaryTileTask> createRevalidationTask(BinaryTileTask& _task) const;
+
         void setNext(std::unique_ptr<DataSource> _next) {
             next = std::move(_next);
             next->level = level + 1;
@@ -103,6 +117,9 @@ public:
     /* Stops any running I/O tasks pertaining to @_task */
     virtual void cancelLoadingTile(TileTask& _task);
 
+    /* Passes the changed load priority of @_task to its running I/O tasks */
+    virtual void updateTaskPriority(TileTask& _task);
+
     /* Parse a <TileTask> with data into a <TileData>, returning an empty TileData on failure */
     virtual std::shared_ptr<TileData> parse(const TileTask& _task) const;
 
@@ -147,11 +164,63 @@ public:
     virtual bool isRaster() const { return false; }
 
     void setFormat(Format format) { m_format = format; }
+    Format format() const { return m_format; }
+
+    /* Key identifying the configuration of this source. Sources with the same key
+     * produce the same TileData and may share it through a TileDataCache.
+     * TileData of sources without a key is not retained.
+     */
+    void setCacheKey(const std::string& _key) { m_cacheKey = _key; }
+    const std::string& cacheKey() const { return m_cacheKey; }
+
+    /* Key identifying the data loaded by this source, e.g. the tile URL template. Sources
+     * with the same data key share parsed TileData, also when they are configured
+     * differently otherwise. Defaults to the cache key.
+     */
+    void setDataKey(const std::string& _key) { m_dataKey = _key; }
+    const std::string& dataKey() const { return m_dataKey.empty() ? m_cacheKey : m_dataKey; }
+
+    /* Set the cache that retains parsed TileData across Scene updates */
+    void setTileDataCache(std::shared_ptr<TileDataCache> _cache) { m_tileDataCache = _cache; }
+
+    /* Parse the data of @_task, or return the TileData of another task of the
+     * same data key. The result is retained for tasks of later Scenes.
+     */
+    std::shared_ptr<TileData> parseTileData(const TileTask& _task) const;
+
+    /* Store TileData parsed for @_task, to be reused by tasks of a later Scene */
+    void retainTileData(const TileTask& _task, std::shared_ptr<TileData> _tileData) const;
+
+    /* Returns a parser for the data of @_task while it arrives, or nullptr when the
+     * data of this source is parsed after loading.
+     */
+    std::shared_ptr<Mvt::StreamParser> createStreamParser(const TileTask& _task) const;
+
+    /* Pass TileData that was parsed while loading @_task, so that it is not parsed again */
+    void setParsedTileData(TileTask& _task, std::shared_ptr<TileData> _tileData) const;
+
+    /* Mark the tile of @_task to be reloaded, when revalidating its cached data
+     * found that the data changed. May be called from any thread.
+     */
+    void tileDataChanged(const TileTask& _task);
+
+    bool hasChangedTiles() const;
+
+    /* Returns the tiles whose data changed since the last call, dropping
+     * the data that was retained for them.
+     */
+    std::vector<TileID> takeChangedTiles();
 
 protected:
 
+    /* Drop data retained for the tile, so that it is built from the changed data */
+    virtual void invalidateTileData(const TileID& _tileId);
+
     void addRasterTasks(TileTask& _task);
 
+    /* Pass retained TileData for the task's tile, if any, so that it is built without loading */
+    void restoreTileData(TileTask& _task) const;
+
     // This datasource is used to generate actual tile geometry
     // Is set true for any source assigned in a Scene Layer and when the layer is not disabled
     bool m_generateGeometry = false;
@@ -172,6 +241,16 @@ protected:
 
     Format m_format = Format::GeoJson;
 
+    std::string m_cacheKey;
+
+    std::string m_dataKey;
+
+    // Tiles whose data changed on revalidation
+    std::vector<TileID> m_changedTiles;
+    mutable std::mutex m_changedTilesMutex;
+
+    std::shared_ptr<TileDataCache> m_tileDataCache;
+
     /* vector of raster sources (as raster samplers) referenced by this datasource */
     std::vector<RasterSource*> m_rasterSources;
 
@@ -140,6 +140,39 @@ struct CameraUpdate {
     EdgePadding padding;
 };
 
+using RegionDownloadID = uint32_t;
+
+struct RegionDownloadOptions {
+    // Polygon bounding the region; a bounding box is a polygon of its four corners
+    std::vector<LngLat> polygon;
+    // Range of tile zoom levels to download, limited to the max_zoom of the source
+    int minZoom = 0;
+    int maxZoom = 16;
+    // Maximum number of tiles loading at the same time
+    uint32_t maxConcurrentRequests = 4;
+    // Maximum number of tile requests started per second, 0 for no limit
+    float maxRequestsPerSecond = 0;
+    // Regions of more tiles are rejected. Tiles are counted over the bounding box
+    // of the polygon.
+    uint64_t maxTiles = 100000;
+
+    void setBounds(LngLat _a, LngLat _b) {
+        polygon = { _a, LngLat(_b.longitude, _a.latitude), _b, LngLat(_a.longitude, _b.latitude) };
+    }
+};
+
+struct RegionDownloadProgress {
+    size_t tilesTotal = 0;
+    size_t tilesLoaded = 0;
+    size_t tilesFailed = 0;
+    // Size of the loaded tile data
+    size_t bytes = 0;
+    bool finished = false;
+    bool canceled = false;
+};
+
+using RegionDownloadCallback = std::function<void(const RegionDownloadProgress&)>;
+
 struct MapState {
     enum Flags {
         // NB: View is complete when no other flags are set.
@@ -283,6 +316,18 @@ public:
     // Get the tilt angle of the view in radians; 0 corresponds to straight down
     float getTilt();
 
+    // Set the size in logical pixels up to which tiles of lower zoom levels are shown in
+    // tilted views: tiles are replaced by the tiles of the next zoom level only while they
+    // appear larger than this size. Smaller sizes load more tiles and show more detail in
+    // the distance. 512 keeps the detail of an untilted view but loads more tiles than
+    // the distance bands at tilts of 70 degrees and above; 1024 loads fewer tiles at any
+    // tilt, as it also lowers the zoom level at the view center. 0 (default) lowers the
+    // zoom level in fixed distance bands from the view center instead.
+    void setMaxTileScreenSize(float _pixels);
+
+    // Get the size in logical pixels up to which tiles of lower zoom levels are shown.
+    float getMaxTileScreenSize() const;
+
     // Set the padding on the map view. The center position of the map will be drawn at the center of the view area
     // inside the padding.
     void setPadding(const EdgePadding& padding);
@@ -339,6 +384,18 @@ public:
     // Returns true if the source was found and cleared, otherwise returns false.
     bool clearTileSource(TileSource& _source, bool _data, bool _tiles);
 
+    // Download the tiles of the source named _sourceName that cover a region, without
+    // building their geometry, so that the data sources of the tile source can store them
+    // (e.g. an MBTiles source with the 'cache' option). _callback is called from a
+    // background thread once a tile was loaded and when the download is finished;
+    // returns 0 if there is no such network or MBTiles source in the current, loaded scene
+    // or when the region has more than _options.maxTiles tiles.
+    RegionDownloadID downloadRegion(const std::string& _sourceName, RegionDownloadOptions _options,
+                                    RegionDownloadCallback _callback);
+
+    // Cancel a region download; returns true if the download was found and canceled.
+    bool cancelRegionDownload(RegionDownloadID _id);
+
     // Add a marker object to the map and return an ID for it; an ID of 0 indicates an invalid marker;
     // the marker will not be drawn until both styling and geometry are set using the functions below.
     MarkerID markerAdd();
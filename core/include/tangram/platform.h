@@ -3,7 +3,9 @@
 #include "util/url.h"
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -15,6 +17,21 @@ namespace Tangram {
 // This is the handle which Platform uses to identify an UrlRequest.
 using UrlRequestHandle = uint64_t;
 
+// Freshness information of a URL response, from its ETag, Last-Modified,
+// Cache-Control and Expires headers.
+struct UrlCacheInfo {
+    std::string etag;
+    std::string lastModified;
+    // Time when the content becomes stale in seconds since epoch, 0 if unknown
+    int64_t expires = 0;
+
+    // Whether a conditional request can check that the content is unchanged
+    bool canRevalidate() const { return !etag.empty() || !lastModified.empty(); }
+
+    // Content without expiry does not become stale
+    bool isStale(int64_t _now) const { return expires != 0 && expires <= _now; }
+};
+
 // Result of a URL request. If the request could not be completed or if the
 // host returned an HTTP status code >= 400, a non-null error string will be
 // present. This error string is only valid in the scope of the UrlCallback
@@ -23,11 +40,20 @@ using UrlRequestHandle = uint64_t;
 struct UrlResponse {
     std::vector<char> content;
     const char* error = nullptr;
+    // Validators and expiry of the content, as far as the platform provides them
+    UrlCacheInfo cacheInfo;
+    // The host answered a conditional request with '304 Not Modified', content is empty
+    bool notModified = false;
 };
 
 // Function type for receiving data from a URL request.
 using UrlCallback = std::function<void(UrlResponse&&)>;
 
+// Function type for receiving the content of a URL request while it arrives.
+// _offset is the position of _data in the content, it starts at zero again when
+// the content is loaded again, e.g. after a redirect.
+using UrlStreamCallback = std::function<void(size_t _offset, const char* _data, size_t _size)>;
+
 using FontSourceLoader = std::function<std::vector<char>()>;
 
 struct FontSourceHandle {
@@ -81,15 +107,40 @@ public:
     // thread than the original call to startUrlRequest.
     UrlRequestHandle startUrlRequest(Url _url, UrlCallback&& _callback);
 
+    // Start a conditional request for content that is cached with _cacheInfo. When
+    // the content is unchanged the response is empty and has 'notModified' set.
+    // Platforms without support for conditional requests load the content again.
+    UrlRequestHandle startUrlRequest(Url _url, const UrlCacheInfo& _cacheInfo, UrlCallback&& _callback);
+
+    // Start a request that passes the content to _stream in order while it arrives,
+    // before _callback runs with the complete response. Platforms without support
+    // for streaming only run _callback.
+    UrlRequestHandle startUrlRequest(Url _url, const UrlCacheInfo& _cacheInfo, UrlCallback&& _callback,
+                                     UrlStreamCallback&& _stream);
+
     // Stop retrieving data from a URL that was previously requested. When a
     // request is canceled its callback will still be run, but the response
     // will have an error string and the data may not be complete.
     void cancelUrlRequest(UrlRequestHandle _request);
 
+    // Set the load priority of a URL request, lower values are loaded first.
+    // Requests start with priority zero. Platforms that cannot reorder their
+    // requests ignore the priority.
+    void setUrlRequestPriority(UrlRequestHandle _request, double _priority);
+
     virtual FontSourceHandle systemFont(const std::string& _name, const std::string& _weight, const std::string& _face) const;
 
     virtual std::vector<FontSourceHandle> systemFontFallbacksHandle() const;
 
+    // Load a shader program binary that was previously passed to storeProgramBinary
+    // with the same _key. Returns an empty vector when nothing is stored for _key.
+    // The default implementation has no persistent storage.
+    virtual std::vector<char> loadProgramBinary(const std::string& _key) const;
+
+    // Persist a shader program binary for use in later sessions. This is called on the
+    // render thread after a program was compiled from source.
+    virtual void storeProgramBinary(const std::string& _key, const std::vector<char>& _binary);
+
 protected:
     // Platform implementation specific id for URL requests. This id is
     // interpreted differently for each platform type, so do not perform any
@@ -100,11 +151,29 @@ protected:
     // To be called by implementations to pass UrlResponse
     void onUrlResponse(UrlRequestHandle _request, UrlResponse&& _response);
 
+    // To be called by implementations to pass content of a streaming request
+    // while it arrives, in order and before onUrlResponse.
+    void onUrlData(UrlRequestHandle _request, size_t _offset, const char* _data, size_t _size);
+
     virtual void cancelUrlRequestImpl(UrlRequestId _id) = 0;
 
     // Return true when UrlRequestId has been set (i.e. when request is async and can be canceled)
     virtual bool startUrlRequestImpl(const Url& _url, UrlRequestHandle _request, UrlRequestId& _id) = 0;
 
+    virtual void setUrlRequestPriorityImpl(UrlRequestId _id, double _priority) {}
+
+    // Like startUrlRequestImpl, sending the validators of _cacheInfo with the request
+    virtual bool startConditionalUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                                UrlRequestHandle _request, UrlRequestId& _id) {
+        return startUrlRequestImpl(_url, _request, _id);
+    }
+
+    // Like startConditionalUrlRequestImpl, passing content to onUrlData while it arrives
+    virtual bool startStreamingUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                              UrlRequestHandle _request, UrlRequestId& _id) {
+        return startConditionalUrlRequestImpl(_url, _cacheInfo, _request, _id);
+    }
+
     static bool bytesFromFileSystem(const char* _path, std::function<char*(size_t)> _allocator);
 
     std::atomic<bool> m_shutdown{false};
@@ -116,6 +185,7 @@ protected:
         UrlCallback callback;
         UrlRequestId id;
         bool cancelable;
+        std::shared_ptr<UrlStreamCallback> stream;
     };
     std::unordered_map<UrlRequestHandle, UrlRequestEntry> m_urlCallbacks;
     std::atomic_uint_fast64_t m_urlRequestCount = {0};
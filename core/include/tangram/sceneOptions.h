@@ -55,9 +55,30 @@ public:
     /// Start loading tiles as soon as possible
     uint32_t numTileWorkers = 2;
 
+    /// Threads that compute the screen positions of the labels of visible
+    /// tiles in parallel. 0 computes them on the thread that updates the map.
+    uint32_t numLabelWorkers = 0;
+
     /// 16MB default in-memory DataSource cache
     size_t memoryTileCacheSize = CACHE_SIZE;
 
+    /// Estimated bytes of parsed tiles kept to rebuild tiles without reloading
+    /// when a scene with the same sources is loaded. 0 disables retention.
+    size_t retainedTileDataSize = CACHE_SIZE;
+
+    /// Reuse tile meshes of the previous scene for styles that are not
+    /// affected by the changes of this scene.
+    bool reuseTileMeshes = true;
+
+    /// Width and height of the glyph atlas textures. Larger pages hold more
+    /// glyphs, so that text draws switch textures less often. Up to 64 pages
+    /// are allocated: 256 bounds glyph textures to 4MB, 512 to 16MB.
+    uint32_t glyphAtlasSize = 256;
+
+    /// Path of a glyph bundle with precomputed distance fields for the
+    /// glyphs of this scene, see tangram-glyph-bundle.
+    std::string glyphBundlePath;
+
 private:
     static constexpr size_t CACHE_SIZE = 16 * (1024 * 1024);
 
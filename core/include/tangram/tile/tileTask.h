@@ -52,14 +52,31 @@ public:
     void cancel() { m_canceled = true; }
     bool isCanceled() const { return m_canceled; }
 
+    // Upper bound of the factor by which TileManager scales the priority of tiles
+    // that are not at the view zoom
+    static constexpr double max_priority_scale = 4194304.0; // 2^22
+
     double getPriority() const {
         return m_priority.load();
     }
 
-    void setPriority(double _priority) {
+    // Prefetched tasks load after all other tasks, each tier by lower priority
+    void setPriority(double _priority, bool _prefetch = false) {
         m_priority.store(_priority);
+        m_prefetch = _prefetch;
+    }
+
+    bool isPrefetch() const { return m_prefetch; }
+
+    bool loadsBefore(const TileTask& _other) const {
+        if (isPrefetch() != _other.isPrefetch()) { return !isPrefetch(); }
+        return getPriority() < _other.getPriority();
     }
 
+    // Priority of the URL request of this task, a single value that orders
+    // prefetched tasks after all others like loadsBefore()
+    double requestPriority() const;
+
     void setProxyState(bool isProxy) { m_proxyState = isProxy; }
     bool isProxy() const { return m_proxyState; }
 
@@ -85,6 +102,20 @@ public:
 
     void startedLoading() { m_needsLoading = false; }
 
+    // TileData retained by the TileSource, used instead of parsing loaded data
+    void setTileData(std::shared_ptr<TileData> _tileData) { m_tileData = std::move(_tileData); }
+    const std::shared_ptr<TileData>& tileData() const { return m_tileData; }
+
+    // Set by DataSources on a task that revalidated the cached data of a tile
+    // and found it changed. The task itself is not built, the tile is reloaded.
+    void setDataChanged(bool _changed) { m_dataChanged = _changed; }
+    bool dataChanged() const { return m_dataChanged; }
+
+    // Whether DataSources may parse the data while it loads. Unset for
+    // tasks that only load data without building a tile.
+    void setParseWhileLoading(bool _parse) { m_parseWhileLoading = _parse; }
+    bool parseWhileLoading() const { return m_parseWhileLoading; }
+
 protected:
 
     const TileID m_tileId;
@@ -101,12 +132,18 @@ protected:
     // Tile result, set when tile was  sucessfully created
     std::unique_ptr<Tile> m_tile;
 
+    std::shared_ptr<TileData> m_tileData;
+
     std::atomic<bool> m_ready;
     std::atomic<bool> m_canceled;
     std::atomic<bool> m_needsLoading;
 
-    std::atomic<float> m_priority;
+    std::atomic<double> m_priority;
+    std::atomic<bool> m_prefetch;
     std::atomic<bool> m_proxyState;
+
+    bool m_dataChanged = false;
+    bool m_parseWhileLoading = true;
 };
 
 class BinaryTileTask : public TileTask {
@@ -115,11 +152,18 @@ public:
         : TileTask(_tileId, _source) {}
 
     virtual bool hasData() const override {
-        return rawTileData && !rawTileData->empty();
+        return bool(m_tileData) || (rawTileData && !rawTileData->empty());
     }
     // Raw tile data that will be processed by TileSource.
     std::shared_ptr<std::vector<char>> rawTileData;
 
+    // Freshness of rawTileData. Validators are sent when the data is revalidated.
+    UrlCacheInfo cacheInfo;
+
+    // Set when revalidation found the cached data unchanged, rawTileData is not loaded again.
+    // Persistent caches pass such tasks on to update the cacheInfo of the caches in front of them.
+    bool notModified = false;
+
     bool dataFromCache = false;
     bool urlRequestStarted = false;
 
@@ -24,6 +24,14 @@ attribute vec4 a_position;
 attribute vec4 a_color;
 attribute vec3 a_normal;
 
+#ifdef TANGRAM_COMPACT_VERTICES
+    // Index into the color palette of meshes with compact vertices
+    attribute float a_palette;
+    uniform sampler2D u_palette;
+    // Zero for meshes that store the colors in their vertices
+    uniform vec2 u_palette_size;
+#endif
+
 #ifdef TANGRAM_USE_TEX_COORDS
     attribute vec2 a_texcoord;
     varying vec2 v_texcoord;
@@ -57,9 +65,24 @@ vec4 worldPosition() {
 }
 
 vec3 worldNormal() {
+    #ifdef TANGRAM_COMPACT_VERTICES
+        // Compact vertices only store x and y, z of polygon normals is never negative
+        if (u_palette_size.x > 0.) {
+            return vec3(a_normal.xy, sqrt(max(0., 1. - dot(a_normal.xy, a_normal.xy))));
+        }
+    #endif
     return a_normal;
 }
 
+#ifdef TANGRAM_COMPACT_VERTICES
+// Colors are stored in even rows of the palette, selection colors in the odd row below
+vec4 paletteColor(float row) {
+    float x = mod(a_palette, u_palette_size.x);
+    float y = floor(a_palette / u_palette_size.x) * 2. + row;
+    return texture2D(u_palette, (vec2(x, y) + 0.5) / u_palette_size);
+}
+#endif
+
 vec4 modelPositionBaseZoom() {
     return vec4(UNPACK_POSITION(a_position.xyz), 1.0);
 }
@@ -79,6 +102,9 @@ void main() {
 
     #ifdef TANGRAM_FEATURE_SELECTION
         v_selection_color = a_selection_color;
+        #ifdef TANGRAM_COMPACT_VERTICES
+            if (u_palette_size.x > 0.) { v_selection_color = paletteColor(1.); }
+        #endif
         // Skip non-selectable meshes
         if (v_selection_color == vec4(0.0)) {
             gl_Position = vec4(0.0);
@@ -90,6 +116,9 @@ void main() {
     #endif
 
     v_color = a_color;
+    #ifdef TANGRAM_COMPACT_VERTICES
+        if (u_palette_size.x > 0.) { v_color = paletteColor(0.); }
+    #endif
 
     #ifdef TANGRAM_USE_TEX_COORDS
         v_texcoord = a_texcoord;
@@ -99,7 +128,7 @@ void main() {
         v_modelpos_base_zoom = modelPositionBaseZoom();
     #endif
 
-    v_normal = normalize(u_normal_matrix * a_normal);
+    v_normal = normalize(u_normal_matrix * worldNormal());
 
     // Transform position into meters relative to map center
     position = u_model * position;
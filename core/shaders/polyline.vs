@@ -24,6 +24,14 @@ attribute vec4 a_position;
 attribute vec4 a_color;
 attribute vec4 a_extrude;
 
+#ifdef TANGRAM_COMPACT_VERTICES
+    // Index into the color palette of meshes with compact vertices
+    attribute float a_palette;
+    uniform sampler2D u_palette;
+    // Zero for meshes that store the colors in their vertices
+    uniform vec2 u_palette_size;
+#endif
+
 #ifdef TANGRAM_USE_TEX_COORDS
     attribute vec2 a_texcoord;
     varying vec2 v_texcoord;
@@ -67,6 +75,15 @@ vec4 modelPositionBaseZoom() {
     return vec4(UNPACK_POSITION(a_position.xyz), 1.0);
 }
 
+#ifdef TANGRAM_COMPACT_VERTICES
+// Colors are stored in even rows of the palette, selection colors in the odd row below
+vec4 paletteColor(float row) {
+    float x = mod(a_palette, u_palette_size.x);
+    float y = floor(a_palette / u_palette_size.x) * 2. + row;
+    return texture2D(u_palette, (vec2(x, y) + 0.5) / u_palette_size);
+}
+#endif
+
 #pragma tangram: material
 #pragma tangram: lighting
 #pragma tangram: global
@@ -82,6 +99,9 @@ void main() {
 
     #ifdef TANGRAM_FEATURE_SELECTION
         v_selection_color = a_selection_color;
+        #ifdef TANGRAM_COMPACT_VERTICES
+            if (u_palette_size.x > 0.) { v_selection_color = paletteColor(1.); }
+        #endif
         // Skip non-selectable meshes
         if (v_selection_color == vec4(0.0)) {
             gl_Position = vec4(0.0);
@@ -93,6 +113,9 @@ void main() {
     #endif
 
     v_color = a_color;
+    #ifdef TANGRAM_COMPACT_VERTICES
+        if (u_palette_size.x > 0.) { v_color = paletteColor(0.); }
+    #endif
 
     #ifdef TANGRAM_USE_TEX_COORDS
         v_texcoord = UNPACK_TEXCOORD(a_texcoord);
@@ -82,7 +82,11 @@ void ClientDataSource::PolygonBuilder::addPoint(LngLat point) {
 }
 
 std::shared_ptr<TileTask> ClientDataSource::createTask(TileID _tileId) {
-    return std::make_shared<TileTask>(_tileId, shared_from_this());
+    auto task = std::make_shared<TileTask>(_tileId, shared_from_this());
+
+    restoreTileData(*task);
+
+    return task;
 }
 
 // TODO: pass scene's resourcePath to constructor to be used with `stringFromFile`
@@ -97,6 +101,10 @@ ClientDataSource::ClientDataSource(Platform& _platform, const std::string& _name
     m_generateGeometry = true;
     m_store = std::make_unique<Storage>();
 
+    // Features are added by the app or loaded from the url with each instance:
+    // Retained data of this source is not valid for sources of other scenes
+    setCacheKey("client:" + std::to_string(id()));
+
     if (!_url.empty()) {
         UrlCallback onUrlFinished = [&, this](UrlResponse&& response) {
             if (response.error) {
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <stdexcept>
 
 #define LAYER 3
 
@@ -327,7 +328,21 @@ std::shared_ptr<TileData> Mvt::parseTile(const TileTask& _task, int32_t _sourceI
 
     auto& task = static_cast<const BinaryTileTask&>(_task);
 
-    protobuf::message item(task.rawTileData->data(), task.rawTileData->size());
+    const char* data = task.rawTileData->data();
+    size_t size = task.rawTileData->size();
+
+    // Tiles may be served gzip compressed without a Content-Encoding
+    std::vector<char> inflated;
+    if (isGzip(data, size)) {
+        if (zlib::inflate(data, size, inflated) != 0) {
+            LOGE("Cannot inflate tile %s", _task.tileId().toString().c_str());
+            return {};
+        }
+        data = inflated.data();
+        size = inflated.size();
+    }
+
+    protobuf::message item(data, size);
     ParserContext ctx(_sourceId);
 
     try {
@@ -350,4 +365,127 @@ std::shared_ptr<TileData> Mvt::parseTile(const TileTask& _task, int32_t _sourceI
     return tileData;
 }
 
+bool Mvt::isGzip(const char* _data, size_t _size) {
+    return _size >= 2 && uint8_t(_data[0]) == 0x1f && uint8_t(_data[1]) == 0x8b;
+}
+
+// Reads a varint at _pos, returns false when the data ends before it
+static bool readVarint(const std::vector<char>& _data, size_t& _pos, uint64_t& _value) {
+    _value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (_pos >= _data.size()) { return false; }
+        uint8_t byte = _data[_pos++];
+        _value |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) { return true; }
+    }
+    throw std::runtime_error("Invalid varint");
+}
+
+Mvt::StreamParser::StreamParser(int32_t _sourceId) : m_ctx(_sourceId) {
+    reset();
+}
+
+Mvt::StreamParser::~StreamParser() {}
+
+void Mvt::StreamParser::reset() {
+    m_tileData = std::make_shared<TileData>();
+    m_inflater.reset();
+    m_header.clear();
+    m_buffer.clear();
+    m_received = 0;
+    m_failed = false;
+}
+
+bool Mvt::StreamParser::add(const char* _data, size_t _size) {
+
+    if (m_failed) { return false; }
+
+    m_received += _size;
+
+    if (m_received - _size < 2) {
+        // Wait for the gzip magic number
+        m_header.insert(m_header.end(), _data, _data + _size);
+        if (m_header.size() < 2) { return true; }
+
+        if (isGzip(m_header.data(), m_header.size())) {
+            m_inflater = std::make_unique<zlib::Inflater>();
+        }
+        _data = m_header.data();
+        _size = m_header.size();
+    }
+
+    if (m_inflater) {
+        int ret = m_inflater->add(_data, _size, m_buffer);
+        if (ret != 0 && ret != 1) { // Z_OK, Z_STREAM_END
+            m_failed = true;
+        }
+    } else {
+        m_buffer.insert(m_buffer.end(), _data, _data + _size);
+    }
+
+    if (!m_failed) {
+        try {
+            scanLayers();
+        } catch (const std::exception& e) {
+            LOGD("Cannot parse tile stream: %s", e.what());
+            m_failed = true;
+        } catch (...) {
+            m_failed = true;
+        }
+    }
+
+    if (m_failed) { m_tileData.reset(); }
+
+    return !m_failed;
+}
+
+void Mvt::StreamParser::scanLayers() {
+
+    size_t parsed = 0;
+
+    while (true) {
+        size_t pos = parsed;
+        uint64_t key = 0, length = 0;
+
+        if (!readVarint(m_buffer, pos, key)) { break; }
+
+        switch (key & 0x7) {
+        case 0: { // varint
+            uint64_t value;
+            if (!readVarint(m_buffer, pos, value)) { pos = m_buffer.size() + 1; }
+            break;
+        }
+        case 1: // 64 bit
+            length = 8;
+            break;
+        case 2: // length delimited
+            if (!readVarint(m_buffer, pos, length)) { pos = m_buffer.size() + 1; }
+            break;
+        case 5: // 32 bit
+            length = 4;
+            break;
+        default:
+            throw std::runtime_error("Unsupported wire type");
+        }
+
+        // Field not complete yet
+        if (pos > m_buffer.size() || length > m_buffer.size() - pos) { break; }
+
+        if ((key >> 3) == LAYER && (key & 0x7) == 2) {
+            protobuf::message layer(m_buffer.data() + pos, length);
+            m_tileData->layers.push_back(getLayer(m_ctx, layer));
+        }
+        parsed = pos + length;
+    }
+
+    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + parsed);
+}
+
+std::shared_ptr<TileData> Mvt::StreamParser::finish() {
+
+    if (m_failed || m_received < 2 || !m_buffer.empty()) { return nullptr; }
+
+    return m_tileData;
+}
+
 }
@@ -3,6 +3,7 @@
 #include "data/tileData.h"
 #include "pbf/pbf.hpp"
 #include "util/variant.h"
+#include "util/zlibHelper.h"
 
 #include <memory>
 #include <string>
@@ -52,6 +53,52 @@ namespace Mvt {
 
     std::shared_ptr<TileData> parseTile(const TileTask& _task, int32_t _sourceId);
 
+    // Whether the tile data is gzip compressed
+    bool isGzip(const char* _data, size_t _size);
+
+    /* StreamParser - Parses the layers of a tile while its data arrives
+     *
+     * Chunks of the tile data are passed to add(), the layers that are
+     * complete with a chunk are parsed right away. Gzip compressed data
+     * is inflated along the way.
+     */
+    class StreamParser {
+    public:
+        explicit StreamParser(int32_t _sourceId);
+        ~StreamParser();
+
+        // Parse the layers that are complete with the next chunk of tile data.
+        // Returns false when the data cannot be parsed.
+        bool add(const char* _data, size_t _size);
+
+        // Bytes of tile data passed to add()
+        size_t received() const { return m_received; }
+
+        // Start over, e.g. when the tile data is loaded again
+        void reset();
+
+        // Returns the parsed TileData, or nullptr when the data ended within a layer
+        // or could not be parsed.
+        std::shared_ptr<TileData> finish();
+
+    private:
+        void scanLayers();
+
+        ParserContext m_ctx;
+        std::shared_ptr<TileData> m_tileData;
+
+        std::unique_ptr<zlib::Inflater> m_inflater;
+
+        // Leading bytes until gzip compression can be detected
+        std::vector<char> m_header;
+
+        // Tile data after the last complete layer
+        std::vector<char> m_buffer;
+
+        size_t m_received = 0;
+        bool m_failed = false;
+    };
+
 } // namespace Mvt
 
 } // namespace Tangram
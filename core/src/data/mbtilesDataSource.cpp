@@ -9,9 +9,14 @@
 #include <SQLiteCpp/Database.h>
 #include "hash-library/md5.cpp"
 
+#include <ctime>
+
 
 namespace Tangram {
 
+// Tiles stored without cache info are revalidated after this time, in seconds
+static const int64_t legacy_max_age = 24 * 60 * 60;
+
 /**
  * The schema.sql used to set up an MBTiles Database.
  *
@@ -98,6 +103,24 @@ CREATE VIEW IF NOT EXISTS grid_data AS
     JOIN keymap ON grid_key.key_name = keymap.key_name;
 COMMIT;)SQL_ESC";
 
+/**
+ * Freshness of the tiles of a cache, to revalidate them with conditional requests.
+ * Expiry is in seconds since epoch.
+ */
+static const char* CACHE_INFO_SCHEMA = R"SQL_ESC(BEGIN;
+
+CREATE TABLE IF NOT EXISTS tile_cache_info (
+    zoom_level INTEGER,
+    tile_column INTEGER,
+    tile_row INTEGER,
+    etag TEXT,
+    last_modified TEXT,
+    expires INTEGER
+);
+
+CREATE UNIQUE INDEX IF NOT EXISTS tile_cache_info_index ON tile_cache_info (zoom_level, tile_column, tile_row);
+COMMIT;)SQL_ESC";
+
 struct MBTilesQueries {
     // SELECT statement from tiles view
     SQLite::Statement getTileData;
@@ -108,10 +131,18 @@ struct MBTilesQueries {
     // REPLACE INTO statement in images table
     SQLite::Statement putImage;
 
+    // SELECT statement from tile_cache_info table
+    SQLite::Statement getCacheInfo;
+
+    // REPLACE INTO statement in tile_cache_info table
+    SQLite::Statement putCacheInfo;
+
     MBTilesQueries(SQLite::Database& _db, bool _cache)
         : getTileData(_db, "SELECT tile_data FROM tiles WHERE zoom_level = ? AND tile_column = ? AND tile_row = ?;"),
           putMap(_db, _cache ? "REPLACE INTO map (zoom_level, tile_column, tile_row, tile_id) VALUES (?, ?, ?, ?);" : ";" ),
-          putImage(_db, _cache ? "REPLACE INTO images (tile_id, tile_data) VALUES (?, ?);" : ";") {}
+          putImage(_db, _cache ? "REPLACE INTO images (tile_id, tile_data) VALUES (?, ?);" : ";"),
+          getCacheInfo(_db, _cache ? "SELECT etag, last_modified, expires FROM tile_cache_info WHERE zoom_level = ? AND tile_column = ? AND tile_row = ?;" : ";"),
+          putCacheInfo(_db, _cache ? "REPLACE INTO tile_cache_info (zoom_level, tile_column, tile_row, etag, last_modified, expires) VALUES (?, ?, ?, ?, ?, ?);" : ";") {}
 
 };
 
@@ -158,8 +189,26 @@ bool MBTilesDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb
             if (task.hasData()) {
                 LOGW("loaded tile: %s, %d", tileId.toString().c_str(), task.rawTileData->size());
 
+                // Serve stale data right away and revalidate it in the background
+                std::shared_ptr<BinaryTileTask> revalidation;
+                if (m_cacheMode && next) {
+                    int64_t now = std::time(nullptr);
+                    if (!getCacheInfo(tileId, task.cacheInfo)) {
+                        // Stored without cache info: Without validators a revalidation
+                        // loads the whole tile, so keep it for the default time first
+                        task.cacheInfo.expires = now + legacy_max_age;
+                        storeCacheInfo(tileId, task.cacheInfo);
+                    }
+                    if (task.cacheInfo.isStale(now)) {
+                        revalidation = createRevalidationTask(task);
+                    }
+                }
+                auto cached = task.rawTileData;
+
                 _cb.func(_task);
 
+                if (revalidation) { revalidate(revalidation, cached, _cb); }
+
             } else if (next) {
 
                 // Don't try this source again
@@ -191,7 +240,20 @@ bool MBTilesDataSource::loadNextSource(std::shared_ptr<TileTask> _task, TileTask
     // Intercept TileTaskCb to store result from next source.
     TileTaskCb cb{[this, _cb](std::shared_ptr<TileTask> _task) {
 
-        if (_task->hasData()) {
+        auto& task = static_cast<BinaryTileTask&>(*_task);
+
+        if (task.notModified) {
+            // Revalidated data of a previous source
+            if (m_cacheMode) {
+                m_worker->enqueue([this, _task](){
+                        auto& task = static_cast<BinaryTileTask&>(*_task);
+                        storeCacheInfo(task.tileId(), task.cacheInfo);
+                    });
+            }
+
+            _cb.func(_task);
+
+        } else if (_task->hasData()) {
 
             if (m_cacheMode) {
                 m_worker->enqueue([this, _task](){
@@ -201,6 +263,7 @@ bool MBTilesDataSource::loadNextSource(std::shared_ptr<TileTask> _task, TileTask
                         LOGW("store tile: %s, %d", _task->tileId().toString().c_str(), task.hasData());
 
                         storeTileData(_task->tileId(), *task.rawTileData);
+                        storeCacheInfo(_task->tileId(), task.cacheInfo);
                     });
             }
 
@@ -230,6 +293,42 @@ bool MBTilesDataSource::loadNextSource(std::shared_ptr<TileTask> _task, TileTask
     return next->loadTileData(_task, cb);
 }
 
+void MBTilesDataSource::revalidate(std::shared_ptr<BinaryTileTask> _task,
+                                   std::shared_ptr<std::vector<char>> _cached, TileTaskCb _cb) {
+
+    next->loadTileData(_task, {[this, _cb, _cached](std::shared_ptr<TileTask> _task) {
+
+        auto& task = static_cast<BinaryTileTask&>(*_task);
+
+        // Failed requests are retried on the next access
+        if (!task.notModified && !task.hasData()) { return; }
+
+        m_worker->enqueue([this, _task, _cb, _cached](){
+
+            auto& task = static_cast<BinaryTileTask&>(*_task);
+
+            if (!task.notModified) {
+                storeTileData(task.tileId(), *task.rawTileData);
+            }
+            storeCacheInfo(task.tileId(), task.cacheInfo);
+
+            if (task.notModified || *task.rawTileData == *_cached) {
+                // Pass the new expiry to the caches in front of this source
+                task.notModified = true;
+                task.rawTileData.reset();
+                _cb.func(_task);
+                return;
+            }
+
+            // Loaded tiles are rebuilt with the new data
+            if (task.source()) {
+                task.setDataChanged(true);
+                _cb.func(_task);
+            }
+        });
+    }});
+}
+
 void MBTilesDataSource::openMBTiles() {
 
     try {
@@ -287,6 +386,17 @@ void MBTilesDataSource::openMBTiles() {
         return;
     }
 
+    if (m_cacheMode) {
+        // Also added to caches of previous versions
+        try {
+            m_db->exec(CACHE_INFO_SCHEMA);
+        } catch (std::exception& e) {
+            LOGE("Unable to setup MBTiles cache info: %s", e.what());
+            m_db.reset();
+            return;
+        }
+    }
+
     try {
         m_queries = std::make_unique<MBTilesQueries>(*m_db, m_cacheMode);
     } catch (std::exception& e) {
@@ -513,4 +623,55 @@ void MBTilesDataSource::storeTileData(const TileID& _tileId, const std::vector<c
     }
 }
 
+bool MBTilesDataSource::getCacheInfo(const TileID& _tileId, UrlCacheInfo& _cacheInfo) {
+
+    auto& stmt = m_queries->getCacheInfo;
+    try {
+        int z = _tileId.z;
+        int y = (1 << z) - 1 - _tileId.y;
+
+        stmt.bind(1, z);
+        stmt.bind(2, _tileId.x);
+        stmt.bind(3, y);
+
+        if (stmt.executeStep()) {
+            _cacheInfo.etag = stmt.getColumn(0).getText();
+            _cacheInfo.lastModified = stmt.getColumn(1).getText();
+            _cacheInfo.expires = stmt.getColumn(2).getInt64();
+
+            stmt.reset();
+            return true;
+        }
+
+    } catch (std::exception& e) {
+        LOGE("MBTiles SQLite get cache info statement failed: %s", e.what());
+    }
+    try {
+        stmt.reset();
+    } catch(...) {}
+
+    return false;
+}
+
+void MBTilesDataSource::storeCacheInfo(const TileID& _tileId, const UrlCacheInfo& _cacheInfo) {
+    int z = _tileId.z;
+    int y = (1 << z) - 1 - _tileId.y;
+
+    try {
+        auto& stmt = m_queries->putCacheInfo;
+        stmt.bind(1, z);
+        stmt.bind(2, _tileId.x);
+        stmt.bind(3, y);
+        stmt.bind(4, _cacheInfo.etag);
+        stmt.bind(5, _cacheInfo.lastModified);
+        stmt.bind(6, static_cast<long long>(_cacheInfo.expires));
+        stmt.exec();
+
+        stmt.reset();
+
+    } catch (std::exception& e) {
+        LOGE("MBTiles SQLite put cache info statement failed: %s", e.what());
+    }
+}
+
 }
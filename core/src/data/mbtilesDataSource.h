@@ -31,6 +31,15 @@ private:
     void storeTileData(const TileID& _tileId, const std::vector<char>& _data);
     bool loadNextSource(std::shared_ptr<TileTask> _task, TileTaskCb _cb);
 
+    // Freshness of cached tiles
+    bool getCacheInfo(const TileID& _tileId, UrlCacheInfo& _cacheInfo);
+    void storeCacheInfo(const TileID& _tileId, const UrlCacheInfo& _cacheInfo);
+
+    // Loads _task with the next sources, storing its data and passing it to _cb when
+    // it differs from _cached
+    void revalidate(std::shared_ptr<BinaryTileTask> _task, std::shared_ptr<std::vector<char>> _cached,
+                    TileTaskCb _cb);
+
     void openMBTiles();
     bool testSchema(SQLite::Database& db);
     void initSchema(SQLite::Database& db, std::string _name, std::string _mimeType);
@@ -4,6 +4,7 @@
 #include "tile/tileID.h"
 #include "log.h"
 
+#include <ctime>
 #include <list>
 #include <mutex>
 #include <unordered_map>
@@ -16,7 +17,11 @@ struct RawCache {
     std::mutex m_mutex;
 
     // LRU in-memory cache for raw tile data
-    using CacheEntry = std::pair<TileID, std::shared_ptr<std::vector<char>>>;
+    struct CacheEntry {
+        TileID tileId;
+        std::shared_ptr<std::vector<char>> data;
+        UrlCacheInfo cacheInfo;
+    };
     using CacheList = std::list<CacheEntry>;
     using CacheMap = std::unordered_map<TileID, typename CacheList::iterator>;
 
@@ -37,21 +42,30 @@ struct RawCache {
         if (it != m_cacheMap.end()) {
             // Move cached entry to start of list
             m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
-            _task.rawTileData = m_cacheList.front().second;
+            _task.rawTileData = m_cacheList.front().data;
+            _task.cacheInfo = m_cacheList.front().cacheInfo;
 
             return true;
         }
 
         return false;
     }
-    void put(const TileID& tileID, std::shared_ptr<std::vector<char>> rawDataRef) {
+    void put(const TileID& tileID, std::shared_ptr<std::vector<char>> rawDataRef,
+             const UrlCacheInfo& cacheInfo) {
 
         if (m_maxUsage <= 0) { return; }
 
         std::lock_guard<std::mutex> lock(m_mutex);
         TileID id(tileID.x, tileID.y, tileID.z);
 
-        m_cacheList.push_front({id, rawDataRef});
+        // Replace the entry of revalidated data
+        auto it = m_cacheMap.find(id);
+        if (it != m_cacheMap.end()) {
+            m_usage -= it->second->data->size();
+            m_cacheList.erase(it->second);
+        }
+
+        m_cacheList.push_front({id, rawDataRef, cacheInfo});
         m_cacheMap[id] = m_cacheList.begin();
 
         m_usage += rawDataRef->size();
@@ -67,13 +81,24 @@ struct RawCache {
             //        double(m_cacheUsage) / (1024*1024));
 
             auto& entry = m_cacheList.back();
-            m_usage -= entry.second->size();
+            m_usage -= entry.data->size();
 
-            m_cacheMap.erase(entry.first);
+            m_cacheMap.erase(entry.tileId);
             m_cacheList.pop_back();
         }
     }
 
+    void updateCacheInfo(const TileID& tileID, const UrlCacheInfo& cacheInfo) {
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TileID id(tileID.x, tileID.y, tileID.z);
+
+        auto it = m_cacheMap.find(id);
+        if (it != m_cacheMap.end()) {
+            it->second->cacheInfo = cacheInfo;
+        }
+    }
+
     void clear() {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_cacheMap.clear();
@@ -97,8 +122,8 @@ bool MemoryCacheDataSource::cacheGet(BinaryTileTask& _task) {
     return m_cache->get(_task);
 }
 
-void MemoryCacheDataSource::cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef) {
-    m_cache->put(_tileID, _rawDataRef);
+void MemoryCacheDataSource::cachePut(const BinaryTileTask& _task) {
+    m_cache->put(_task.tileId(), _task.rawTileData, _task.cacheInfo);
 }
 
 bool MemoryCacheDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
@@ -110,7 +135,14 @@ bool MemoryCacheDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTa
         cacheGet(task);
 
         if (task.hasData()) {
+            // Serve stale data right away and revalidate it in the background
+            bool stale = next && task.cacheInfo.isStale(std::time(nullptr));
+            auto revalidation = stale ? createRevalidationTask(task) : nullptr;
+            auto cached = task.rawTileData;
+
             _cb.func(_task);
+
+            if (revalidation) { revalidate(revalidation, cached, _cb); }
             return true;
         }
 
@@ -124,7 +156,13 @@ bool MemoryCacheDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTa
 
             auto& task = static_cast<BinaryTileTask&>(*_task);
 
-            if (task.hasData()) { cachePut(task.tileId(), task.rawTileData); }
+            if (task.notModified) {
+                // A source behind this one revalidated the data it served
+                m_cache->updateCacheInfo(task.tileId(), task.cacheInfo);
+                return;
+            }
+
+            if (task.hasData()) { cachePut(task); }
 
             _cb.func(_task);
         }});
@@ -133,6 +171,32 @@ bool MemoryCacheDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTa
     return false;
 }
 
+void MemoryCacheDataSource::revalidate(std::shared_ptr<BinaryTileTask> _task,
+                                       std::shared_ptr<std::vector<char>> _cached, TileTaskCb _cb) {
+
+    next->loadTileData(_task, {[this, _cb, _cached](std::shared_ptr<TileTask> _task) {
+
+        auto& task = static_cast<BinaryTileTask&>(*_task);
+
+        if (task.notModified) {
+            m_cache->updateCacheInfo(task.tileId(), task.cacheInfo);
+            return;
+        }
+        // Failed requests are retried on the next access
+        if (!task.hasData()) { return; }
+
+        cachePut(task);
+
+        if (*task.rawTileData == *_cached) { return; }
+
+        // Loaded tiles are rebuilt with the new data
+        if (task.source()) {
+            task.setDataChanged(true);
+            _cb.func(_task);
+        }
+    }});
+}
+
 void MemoryCacheDataSource::clear() {
     m_cache->clear();
 
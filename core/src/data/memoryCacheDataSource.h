@@ -22,7 +22,11 @@ public:
 private:
     bool cacheGet(BinaryTileTask& _task);
 
-    void cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef);
+    void cachePut(const BinaryTileTask& _task);
+
+    // Loads _task with the next sources, passing it to _cb when its data differs from _cached
+    void revalidate(std::shared_ptr<BinaryTileTask> _task, std::shared_ptr<std::vector<char>> _cached,
+                    TileTaskCb _cb);
 
     std::unique_ptr<RawCache> m_cache;
 
@@ -1,10 +1,17 @@
 #include "data/networkDataSource.h"
 
+#include "data/formats/mvt.h"
+#include "data/urlRequestCoalescer.h"
 #include "log.h"
 #include "platform.h"
 
+#include <ctime>
+
 namespace Tangram {
 
+// Tiles without expiry from the host are revalidated after this time, in seconds
+static const int64_t default_max_age = 24 * 60 * 60;
+
 NetworkDataSource::NetworkDataSource(Platform& _platform, std::string url, UrlOptions options) :
     m_platform(_platform),
     m_urlTemplate(std::move(url)),
@@ -86,6 +93,13 @@ bool NetworkDataSource::loadTileData(std::shared_ptr<TileTask> task, TileTaskCb
         m_urlSubdomainIndex = (m_urlSubdomainIndex + 1) % m_options.subdomains.size();
     }
 
+    // Parse the layers of the tile while its data arrives. Revalidated data is
+    // usually not modified.
+    std::shared_ptr<Mvt::StreamParser> parser;
+    if (!static_cast<BinaryTileTask&>(*task).cacheInfo.canRevalidate()) {
+        if (auto source = task->source()) { parser = source->createStreamParser(*task); }
+    }
+
     LOGTInit(">>> %s", task->tileId().toString().c_str());
     UrlCallback onRequestFinish = [=](UrlResponse&& response) mutable {
         auto source = task->source();
@@ -102,17 +116,64 @@ bool NetworkDataSource::loadTileData(std::shared_ptr<TileTask> task, TileTaskCb
         if (response.error) {
             LOGD("URL request '%s': %s", url.string().c_str(), response.error);
 
-        } else if (!response.content.empty()) {
+        } else {
             auto& dlTask = static_cast<BinaryTileTask&>(*task);
-            dlTask.rawTileData = std::make_shared<std::vector<char>>(std::move(response.content));
+            auto cacheInfo = response.cacheInfo;
+
+            if (response.notModified) {
+                // The validators of the cached data remain valid
+                if (cacheInfo.etag.empty()) { cacheInfo.etag = dlTask.cacheInfo.etag; }
+                if (cacheInfo.lastModified.empty()) { cacheInfo.lastModified = dlTask.cacheInfo.lastModified; }
+            }
+            if (cacheInfo.expires == 0) {
+                cacheInfo.expires = int64_t(std::time(nullptr)) + default_max_age;
+            }
+            dlTask.cacheInfo = std::move(cacheInfo);
+            dlTask.notModified = response.notModified;
+
+            auto& content = response.content;
+            if (parser && parser->received() > 0 && parser->received() <= content.size()) {
+                // Only the rest of the data is left to parse
+                parser->add(content.data() + parser->received(), content.size() - parser->received());
+                if (auto tileData = parser->finish()) {
+                    source->setParsedTileData(dlTask, std::move(tileData));
+                }
+            }
+
+            if (!content.empty()) {
+                dlTask.rawTileData = std::make_shared<std::vector<char>>(std::move(content));
+            }
         }
         callback.func(std::move(task));
     };
 
+    UrlStreamCallback onRequestData;
+    if (parser) {
+        onRequestData = [parser, task](size_t offset, const char* data, size_t size) {
+            if (task->isCanceled()) { return; }
+
+            // The data is loaded again
+            if (offset == 0 && parser->received() > 0) { parser->reset(); }
+
+            if (offset == parser->received()) { parser->add(data, size); }
+        };
+    }
+
+    // Revalidating tasks carry the validators of their cached data
     auto& dlTask = static_cast<BinaryTileTask&>(*task);
-    dlTask.urlRequestHandle = m_platform.startUrlRequest(url, std::move(onRequestFinish));
+    if (m_coalescer) {
+        // Requests for other subdomains are the same request
+        auto key = buildUrlForTile(tileId, m_urlTemplate, m_options, 0);
+        dlTask.urlRequestHandle = m_coalescer->startRequest(key, url, dlTask.cacheInfo, std::move(onRequestFinish),
+                                                            std::move(onRequestData));
+    } else {
+        dlTask.urlRequestHandle = m_platform.startUrlRequest(url, dlTask.cacheInfo, std::move(onRequestFinish),
+                                                             std::move(onRequestData));
+    }
     dlTask.urlRequestStarted = true;
 
+    updateTaskPriority(*task);
+
     return true;
 }
 
@@ -121,7 +182,22 @@ void NetworkDataSource::cancelLoadingTile(TileTask& task) {
     if (dlTask.urlRequestStarted) {
         dlTask.urlRequestStarted = false;
 
-        m_platform.cancelUrlRequest(dlTask.urlRequestHandle);
+        if (m_coalescer) {
+            m_coalescer->cancelRequest(dlTask.urlRequestHandle);
+        } else {
+            m_platform.cancelUrlRequest(dlTask.urlRequestHandle);
+        }
+    }
+}
+
+void NetworkDataSource::updateTaskPriority(TileTask& task) {
+    auto& dlTask = static_cast<BinaryTileTask&>(task);
+    if (!dlTask.urlRequestStarted) { return; }
+
+    if (m_coalescer) {
+        m_coalescer->setRequestPriority(dlTask.urlRequestHandle, task.requestPriority());
+    } else {
+        m_platform.setUrlRequestPriority(dlTask.urlRequestHandle, task.requestPriority());
     }
 }
 
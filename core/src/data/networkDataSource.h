@@ -7,6 +7,7 @@
 namespace Tangram {
 
 class Platform;
+class UrlRequestCoalescer;
 
 class NetworkDataSource : public TileSource::DataSource {
 public:
@@ -22,6 +23,8 @@ public:
 
     void cancelLoadingTile(TileTask& _task) override;
 
+    void updateTaskPriority(TileTask& _task) override;
+
     static std::string tileCoordinatesToQuadKey(const TileID& tile);
 
     /// Returns true if the URL either contains 'x', 'y', and 'z' placeholders or contains a 'q' placeholder.
@@ -29,6 +32,9 @@ public:
 
     static std::string buildUrlForTile(const TileID& tile, const std::string& urlTemplate, const UrlOptions& options, int subdomainIndex);
 
+    /// Share requests for the same tile URL with the other data sources of the coalescer.
+    void setRequestCoalescer(std::shared_ptr<UrlRequestCoalescer> coalescer) { m_coalescer = std::move(coalescer); }
+
 private:
 
     Platform& m_platform;
@@ -38,6 +44,8 @@ private:
     UrlOptions m_options;
 
     int m_urlSubdomainIndex = 0;
+
+    std::shared_ptr<UrlRequestCoalescer> m_coalescer;
 };
 
 }
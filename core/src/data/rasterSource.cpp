@@ -134,7 +134,8 @@ void RasterSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb)
     // TODO, remove this
     // Overwrite cb to set empty texture on failure
     TileTaskCb cb{[this, _cb](std::shared_ptr<TileTask> _task) {
-        if (!_task->hasData()) {
+        // Tasks that only revalidate data are no RasterTileTasks
+        if (!_task->hasData() && !static_cast<BinaryTileTask&>(*_task).notModified) {
             auto& task = static_cast<RasterTileTask&>(*_task);
             task.raster = std::make_unique<Raster>(task.tileId(), m_emptyTexture);
         }
@@ -196,6 +197,13 @@ std::shared_ptr<TileTask> RasterSource::createTask(TileID _tileId) {
     return task;
 }
 
+void RasterSource::invalidateTileData(const TileID& _tileId) {
+    // Do not reuse the texture of the changed data
+    m_textures->erase(TileID(_tileId.x, _tileId.y, _tileId.z));
+
+    TileSource::invalidateTileData(_tileId);
+}
+
 std::shared_ptr<Texture> RasterSource::cacheTexture(const TileID& _tileId, std::unique_ptr<Texture> _texture) {
     TileID id(_tileId.x, _tileId.y, _tileId.z);
 
@@ -210,7 +218,11 @@ std::shared_ptr<Texture> RasterSource::cacheTexture(const TileID& _tileId, std::
     texture = std::shared_ptr<Texture>(_texture.release(),
                                        [c = std::weak_ptr<Cache>(m_textures), id](auto* t) {
                                            if (auto cache = c.lock()) {
-                                               cache->erase(id);
+                                               // Keep the texture of changed data for the tile
+                                               auto it = cache->find(id);
+                                               if (it != cache->end() && it->second.expired()) {
+                                                   cache->erase(it);
+                                               }
                                                LOGD("%d - remove %s", cache->size(), id.toString().c_str());
                                            }
                                            delete t;
@@ -39,6 +39,8 @@ protected:
 
     std::shared_ptr<Texture> emptyTexture() { return m_emptyTexture; }
 
+    void invalidateTileData(const TileID& _tileId) override;
+
 public:
 
     RasterSource(const std::string& _name, std::unique_ptr<DataSource> _sources,
@@ -0,0 +1,270 @@
+#include "data/regionDownload.h"
+
+#include "data/tileSource.h"
+#include "log.h"
+#include "tile/tileTask.h"
+#include "util/geom.h"
+#include "util/mapProjection.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Tangram {
+
+// Liang-Barsky clipping of the segment _a-_b against _box
+static bool segmentIntersectsBox(const glm::dvec2& _a, const glm::dvec2& _b, const BoundingBox& _box) {
+    glm::dvec2 d = _b - _a;
+    double p[4] = { -d.x, d.x, -d.y, d.y };
+    double q[4] = { _a.x - _box.min.x, _box.max.x - _a.x, _a.y - _box.min.y, _box.max.y - _a.y };
+
+    double t0 = 0.0, t1 = 1.0;
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.0) {
+            if (q[i] < 0.0) { return false; }
+            continue;
+        }
+        double t = q[i] / p[i];
+        if (p[i] < 0.0) { t0 = std::max(t0, t); }
+        else { t1 = std::min(t1, t); }
+        if (t0 > t1) { return false; }
+    }
+    return true;
+}
+
+static bool polygonContains(const std::vector<glm::dvec2>& _polygon, const glm::dvec2& _point) {
+    bool inside = false;
+    for (size_t i = 0, j = _polygon.size() - 1; i < _polygon.size(); j = i++) {
+        const auto& a = _polygon[i];
+        const auto& b = _polygon[j];
+        if ((a.y > _point.y) != (b.y > _point.y) &&
+            _point.x < (b.x - a.x) * (_point.y - a.y) / (b.y - a.y) + a.x) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+struct TileRange {
+    glm::ivec2 min, max;
+};
+
+// Range of the tile coordinates at zoom _z that cover _bounds
+static TileRange tileRange(const BoundingBox& _bounds, int _z) {
+    const double halfCircumference = MapProjection::EARTH_HALF_CIRCUMFERENCE_METERS;
+
+    int tileCount = 1 << _z;
+    double metersPerTile = MapProjection::metersPerTileAtZoom(_z);
+
+    auto tileX = [&](double x) {
+        return glm::clamp(int(std::floor((x + halfCircumference) / metersPerTile)), 0, tileCount - 1);
+    };
+    auto tileY = [&](double y) {
+        return glm::clamp(int(std::floor((halfCircumference - y) / metersPerTile)), 0, tileCount - 1);
+    };
+
+    return { { tileX(_bounds.min.x), tileY(_bounds.max.y) },
+             { tileX(_bounds.max.x), tileY(_bounds.min.y) } };
+}
+
+// Calls _visit with the tiles of zoom levels _minZoom to _maxZoom that intersect _polygon,
+// until it returns false
+template<typename F>
+static void visitRegionTiles(const std::vector<LngLat>& _polygon, int _minZoom, int _maxZoom,
+                             F _visit) {
+    if (_polygon.empty()) { return; }
+
+    std::vector<glm::dvec2> polygon;
+    BoundingBox bounds{ glm::dvec2(INFINITY), glm::dvec2(-INFINITY) };
+    for (const auto& lngLat : _polygon) {
+        polygon.push_back(MapProjection::lngLatToProjectedMeters(lngLat));
+        bounds.expand(polygon.back().x, polygon.back().y);
+    }
+
+    for (int z = std::max(_minZoom, 0); z <= _maxZoom; z++) {
+        auto range = tileRange(bounds, z);
+
+        for (int y = range.min.y; y <= range.max.y; y++) {
+            for (int x = range.min.x; x <= range.max.x; x++) {
+                TileID tileID(x, y, z);
+                auto tileBounds = MapProjection::tileBounds(tileID);
+
+                bool intersects = polygonContains(polygon, tileBounds.center());
+                for (size_t i = 0, j = polygon.size() - 1; !intersects && i < polygon.size(); j = i++) {
+                    intersects = segmentIntersectsBox(polygon[j], polygon[i], tileBounds);
+                }
+                if (intersects && !_visit(tileID)) { return; }
+            }
+        }
+    }
+}
+
+std::vector<TileID> RegionDownload::regionTiles(const std::vector<LngLat>& _polygon,
+                                                int _minZoom, int _maxZoom) {
+    std::vector<TileID> tiles;
+    visitRegionTiles(_polygon, _minZoom, _maxZoom, [&](const TileID& _tileID) {
+        tiles.push_back(_tileID);
+        return true;
+    });
+    return tiles;
+}
+
+uint64_t RegionDownload::maxRegionTiles(const std::vector<LngLat>& _polygon,
+                                        int _minZoom, int _maxZoom) {
+    if (_polygon.empty()) { return 0; }
+
+    BoundingBox bounds{ glm::dvec2(INFINITY), glm::dvec2(-INFINITY) };
+    for (const auto& lngLat : _polygon) {
+        auto meters = MapProjection::lngLatToProjectedMeters(lngLat);
+        bounds.expand(meters.x, meters.y);
+    }
+
+    uint64_t count = 0;
+    for (int z = std::max(_minZoom, 0); z <= _maxZoom; z++) {
+        auto range = tileRange(bounds, z);
+        count += uint64_t(range.max.x - range.min.x + 1) * uint64_t(range.max.y - range.min.y + 1);
+    }
+    return count;
+}
+
+RegionDownload::RegionDownload(std::shared_ptr<TileSource> _source, RegionDownloadOptions _options,
+                               RegionDownloadCallback _callback) :
+    m_source(std::move(_source)),
+    m_options(std::move(_options)),
+    m_callback(std::move(_callback)) {
+
+    m_options.maxConcurrentRequests = std::max(m_options.maxConcurrentRequests, 1u);
+    m_options.maxZoom = std::min(m_options.maxZoom, m_source->maxZoom());
+}
+
+RegionDownload::~RegionDownload() {
+    cancel();
+}
+
+void RegionDownload::start() {
+    // The thread keeps the download alive until it is finished
+    m_thread = std::thread([self = shared_from_this()]() { self->run(); });
+}
+
+void RegionDownload::cancel() {
+    std::vector<std::shared_ptr<TileTask>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_progress.finished) {
+            m_progress.canceled = true;
+            tasks.swap(m_tasks);
+        }
+    }
+    m_condition.notify_all();
+
+    for (auto& task : tasks) {
+        m_source->cancelLoadingTile(*task);
+        task->cancel();
+    }
+
+    if (m_thread.joinable()) {
+        if (m_thread.get_id() == std::this_thread::get_id()) {
+            // Canceled from a callback or released by the download thread itself
+            m_thread.detach();
+        } else {
+            m_thread.join();
+        }
+    }
+}
+
+RegionDownloadProgress RegionDownload::progress() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_progress;
+}
+
+void RegionDownload::run() {
+
+    TileTaskCb callback{[download = std::weak_ptr<RegionDownload>(shared_from_this())](std::shared_ptr<TileTask> _task) {
+        if (auto self = download.lock()) { self->onTileLoaded(std::move(_task)); }
+    }};
+
+    // Tiles are enumerated on this thread, counted first for the progress
+    size_t total = 0;
+    visitRegionTiles(m_options.polygon, m_options.minZoom, m_options.maxZoom,
+                     [&](const TileID&) { total++; return true; });
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_progress.tilesTotal = total;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    size_t started = 0;
+
+    visitRegionTiles(m_options.polygon, m_options.minZoom, m_options.maxZoom, [&](const TileID& _tileID) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_condition.wait(lock, [&]() {
+            return m_progress.canceled || m_tasks.size() < m_options.maxConcurrentRequests;
+        });
+
+        if (m_options.maxRequestsPerSecond > 0.f) {
+            auto delay = std::chrono::duration<double>(started / m_options.maxRequestsPerSecond);
+            m_condition.wait_until(lock, startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay),
+                                   [&]() { return m_progress.canceled; });
+        }
+
+        if (m_progress.canceled) { return false; }
+
+        auto task = m_source->createTask(_tileID);
+        // Load only the data of this source, also when its TileData was retained
+        task->subTasks().clear();
+        task->setTileData(nullptr);
+        task->setParseWhileLoading(false);
+
+        m_tasks.push_back(task);
+        started++;
+        lock.unlock();
+
+        m_source->loadTileData(task, callback);
+
+        if (task->needsLoading()) {
+            // No data source could start loading the tile
+            onTileLoaded(task);
+        }
+        return true;
+    });
+
+    RegionDownloadProgress progress;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [&]() { return m_progress.canceled || m_tasks.empty(); });
+
+        m_progress.finished = true;
+        progress = m_progress;
+    }
+
+    LOGD("Region download of source '%s' finished: %d/%d tiles, %d bytes", m_source->name().c_str(),
+         int(progress.tilesLoaded), int(progress.tilesTotal), int(progress.bytes));
+
+    if (m_callback) { m_callback(progress); }
+}
+
+void RegionDownload::onTileLoaded(std::shared_ptr<TileTask> _task) {
+    RegionDownloadProgress progress;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = std::find(m_tasks.begin(), m_tasks.end(), _task);
+        if (it == m_tasks.end()) { return; }
+        m_tasks.erase(it);
+
+        auto* task = dynamic_cast<BinaryTileTask*>(_task.get());
+        if (task && task->hasData()) {
+            m_progress.tilesLoaded++;
+            if (task->rawTileData) { m_progress.bytes += task->rawTileData->size(); }
+        } else {
+            m_progress.tilesFailed++;
+        }
+        progress = m_progress;
+    }
+    m_condition.notify_all();
+
+    if (m_callback) { m_callback(progress); }
+}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "map.h"
+#include "tile/tileID.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Tangram {
+
+class TileSource;
+class TileTask;
+
+/* RegionDownload - Loads the tiles of a TileSource that cover a region
+ *
+ * Tiles are fetched through the data sources of the TileSource, so that persistent
+ * caches in the chain store them, but are not parsed or built. The tiles of the region
+ * are enumerated on a background thread, which starts their requests limited by the
+ * concurrency and rate of the options.
+ * Raster sources of the TileSource are not included; they are downloaded by their
+ * own RegionDownload.
+ */
+class RegionDownload : public std::enable_shared_from_this<RegionDownload> {
+
+public:
+
+    RegionDownload(std::shared_ptr<TileSource> _source, RegionDownloadOptions _options,
+                   RegionDownloadCallback _callback);
+
+    ~RegionDownload();
+
+    /* Returns the tiles of zoom levels _minZoom to _maxZoom that intersect _polygon */
+    static std::vector<TileID> regionTiles(const std::vector<LngLat>& _polygon,
+                                           int _minZoom, int _maxZoom);
+
+    /* Returns an upper bound of the number of regionTiles(): the number of tiles that
+     * cover the bounding box of _polygon, computed without enumerating them
+     */
+    static uint64_t maxRegionTiles(const std::vector<LngLat>& _polygon,
+                                   int _minZoom, int _maxZoom);
+
+    void start();
+
+    /* Cancels the loading tiles and stops starting new requests */
+    void cancel();
+
+    RegionDownloadProgress progress() const;
+
+private:
+
+    void run();
+
+    void onTileLoaded(std::shared_ptr<TileTask> _task);
+
+    std::shared_ptr<TileSource> m_source;
+    RegionDownloadOptions m_options;
+    RegionDownloadCallback m_callback;
+
+    // Tasks of the tiles that are loading
+    std::vector<std::shared_ptr<TileTask>> m_tasks;
+
+    RegionDownloadProgress m_progress;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::thread m_thread;
+};
+
+}
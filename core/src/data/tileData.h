@@ -3,6 +3,7 @@
 #include "glm/vec2.hpp"
 #include "data/properties.h"
 
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -53,6 +54,8 @@ Data heirarchy:
 */
 namespace Tangram {
 
+class TessellationCache;
+
 enum GeometryType {
     unknown,
     points,
@@ -93,6 +96,10 @@ struct TileData {
 
     std::vector<Layer> layers;
 
+    // Polygon triangulations shared by all styles building this data. Set by the
+    // <TileSource> before the data is shared, read-only afterwards.
+    std::shared_ptr<TessellationCache> tessellations;
+
 };
 
 }
@@ -0,0 +1,160 @@
+#include "data/tileDataCache.h"
+
+#include "data/propertyItem.h"
+#include "data/tileData.h"
+#include "util/builders.h"
+
+namespace Tangram {
+
+std::shared_ptr<TileData> TileDataCache::get(const std::string& _source, int64_t _generation,
+                                             TileID _tileId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_cacheMap.find(Key{_source, _generation, _tileId});
+    if (it == m_cacheMap.end()) { return nullptr; }
+
+    // Move to front: most recently used
+    m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+
+    return it->second->tileData;
+}
+
+void TileDataCache::put(const std::string& _source, int64_t _generation, TileID _tileId,
+                        std::shared_ptr<TileData> _tileData) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    insert(Key{_source, _generation, _tileId}, std::move(_tileData));
+}
+
+void TileDataCache::remove(const std::string& _source, int64_t _generation, TileID _tileId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_cacheMap.find(Key{_source, _generation, _tileId});
+    if (it == m_cacheMap.end()) { return; }
+
+    m_usage -= it->second->usage;
+    m_cacheList.erase(it->second);
+    m_cacheMap.erase(it);
+}
+
+std::shared_ptr<TileData> TileDataCache::getOrParse(const std::string& _source, int64_t _generation,
+                                                    TileID _tileId,
+                                                    const std::function<std::shared_ptr<TileData>()>& _parse) {
+    Key key{_source, _generation, _tileId};
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (m_maxUsage == 0) { return _parse(); }
+
+        while (m_parsing.count(key)) { m_parsed.wait(lock); }
+
+        auto it = m_cacheMap.find(key);
+        if (it != m_cacheMap.end()) {
+            m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+            m_sharedParses++;
+            return it->second->tileData;
+        }
+        m_parsing.insert(key);
+    }
+
+    // Not locked: parsing other tiles continues meanwhile
+    auto tileData = _parse();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_parsing.erase(key);
+        insert(key, tileData);
+    }
+    m_parsed.notify_all();
+
+    return tileData;
+}
+
+void TileDataCache::setMaxUsage(size_t _maxUsage) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_maxUsage = _maxUsage;
+    limitUsage(m_maxUsage);
+}
+
+size_t TileDataCache::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_usage;
+}
+
+size_t TileDataCache::memoryUsage(const TileData& _tileData) {
+    size_t usage = sizeof(TileData);
+
+    for (auto& layer : _tileData.layers) {
+        usage += sizeof(Layer) + layer.name.size();
+
+        for (auto& feature : layer.features) {
+            usage += sizeof(Feature);
+            usage += feature.points.size() * sizeof(Point);
+            for (auto& line : feature.lines) {
+                usage += sizeof(Line) + line.size() * sizeof(Point);
+            }
+            for (auto& polygon : feature.polygons) {
+                usage += sizeof(Polygon);
+                for (auto& ring : polygon) {
+                    usage += sizeof(Line) + ring.size() * sizeof(Point);
+                }
+                // Filled while the data is built, and retained with it
+                usage += TessellationCache::memoryUsage(polygon);
+            }
+            for (auto& item : feature.props.items()) {
+                usage += sizeof(PropertyItem) + item.key.size();
+                if (item.value.is<std::string>()) {
+                    usage += item.value.get<std::string>().size();
+                }
+            }
+        }
+    }
+    return usage;
+}
+
+size_t TileDataCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_cacheList.size();
+}
+
+void TileDataCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_cacheMap.clear();
+    m_cacheList.clear();
+    m_usage = 0;
+}
+
+void TileDataCache::insert(const Key& _key, std::shared_ptr<TileData> _tileData) {
+
+    if (m_maxUsage == 0 || !_tileData) { return; }
+
+    size_t usage = memoryUsage(*_tileData);
+
+    auto it = m_cacheMap.find(_key);
+    if (it != m_cacheMap.end()) {
+        m_usage -= it->second->usage;
+        it->second->tileData = std::move(_tileData);
+        it->second->usage = usage;
+        m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+    } else {
+        m_cacheList.push_front({_key, std::move(_tileData), usage});
+        m_cacheMap.emplace(_key, m_cacheList.begin());
+    }
+    m_usage += usage;
+
+    limitUsage(m_maxUsage);
+}
+
+void TileDataCache::limitUsage(size_t _maxUsage) {
+    while (m_usage > _maxUsage && !m_cacheList.empty()) {
+        m_usage -= m_cacheList.back().usage;
+        m_cacheMap.erase(m_cacheList.back().key);
+        m_cacheList.pop_back();
+    }
+}
+
+}
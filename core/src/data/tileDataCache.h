@@ -0,0 +1,117 @@
+#pragma once
+
+#include "tile/tileHash.h"
+#include "tile/tileID.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Tangram {
+
+struct TileData;
+
+/* TileDataCache - Keeps parsed TileData of recently built tiles, so that a Scene
+ * created for a style update can rebuild its tiles without loading and parsing
+ * the data again.
+ *
+ * Entries are keyed by the configuration of their TileSource (see TileSource::cacheKey),
+ * the source generation and the TileID. The cache is shared by the Scenes of a Map and
+ * accessed from their worker threads.
+ */
+class TileDataCache {
+
+    struct Key {
+        std::string source;
+        int64_t generation;
+        TileID tileId;
+
+        bool operator==(const Key& _other) const {
+            return tileId == _other.tileId &&
+                generation == _other.generation &&
+                source == _other.source;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& _key) const {
+            std::size_t seed = 0;
+            hash_combine(seed, _key.source);
+            hash_combine(seed, _key.generation);
+            hash_combine(seed, _key.tileId);
+            return seed;
+        }
+    };
+
+    struct CacheEntry {
+        Key key;
+        std::shared_ptr<TileData> tileData;
+        size_t usage;
+    };
+
+    using CacheList = std::list<CacheEntry>;
+    using CacheMap = std::unordered_map<Key, CacheList::iterator, KeyHash>;
+
+public:
+
+    explicit TileDataCache(size_t _maxUsage = 0) : m_maxUsage(_maxUsage) {}
+
+    // Returns the TileData stored for the tile or nullptr.
+    std::shared_ptr<TileData> get(const std::string& _source, int64_t _generation, TileID _tileId);
+
+    // Stores _tileData, evicting the least recently used entries when the cache is full.
+    void put(const std::string& _source, int64_t _generation, TileID _tileId,
+             std::shared_ptr<TileData> _tileData);
+
+    // Drops the TileData stored for the tile, e.g. when its data changed.
+    void remove(const std::string& _source, int64_t _generation, TileID _tileId);
+
+    // Returns the TileData stored for the tile or stores the result of _parse. Callers for
+    // a tile that is being parsed wait for its result, so that each tile is parsed once.
+    std::shared_ptr<TileData> getOrParse(const std::string& _source, int64_t _generation, TileID _tileId,
+                                         const std::function<std::shared_ptr<TileData>()>& _parse);
+
+    // Number of getOrParse() calls that were served by the result of another caller
+    size_t sharedParses() const { return m_sharedParses; }
+
+    // Set the maximum estimated bytes of retained TileData. Zero disables the cache.
+    void setMaxUsage(size_t _maxUsage);
+
+    // Estimated bytes of the retained TileData
+    size_t getMemoryUsage() const;
+
+    // Estimated bytes of the geometry, properties and polygon triangulations of _tileData
+    static size_t memoryUsage(const TileData& _tileData);
+
+    size_t size() const;
+
+    void clear();
+
+private:
+
+    void insert(const Key& _key, std::shared_ptr<TileData> _tileData);
+
+    void limitUsage(size_t _maxUsage);
+
+    mutable std::mutex m_mutex;
+
+    CacheMap m_cacheMap;
+    CacheList m_cacheList;
+
+    // Tiles being parsed by getOrParse()
+    std::unordered_set<Key, KeyHash> m_parsing;
+    std::condition_variable m_parsed;
+
+    size_t m_usage = 0;
+    size_t m_maxUsage;
+
+    std::atomic<size_t> m_sharedParses{0};
+};
+
+}
@@ -4,12 +4,14 @@
 #include "data/formats/mvt.h"
 #include "data/formats/topoJson.h"
 #include "data/tileData.h"
+#include "data/tileDataCache.h"
 #include "data/rasterSource.h"
 #include "platform.h"
 #include "tile/tileID.h"
 #include "tile/tile.h"
 #include "tile/tileTask.h"
 #include "log.h"
+#include "util/builders.h"
 #include "util/geom.h"
 
 #include <atomic>
@@ -59,6 +61,8 @@ const char* TileSource::mimeType() const {
 std::shared_ptr<TileTask> TileSource::createTask(TileID _tileId) {
     auto task = std::make_shared<BinaryTileTask>(_tileId, shared_from_this());
 
+    restoreTileData(*task);
+
     addRasterTasks(*task);
 
     return task;
@@ -71,6 +75,102 @@ void TileSource::addRasterTasks(TileTask& _task) {
     }
 }
 
+void TileSource::restoreTileData(TileTask& _task) const {
+
+    if (!m_tileDataCache || dataKey().empty()) { return; }
+
+    if (auto tileData = m_tileDataCache->get(dataKey(), m_generation, _task.tileId())) {
+        _task.setTileData(std::move(tileData));
+    }
+}
+
+std::shared_ptr<TileData> TileSource::parseTileData(const TileTask& _task) const {
+
+    auto parseData = [&]() {
+        auto tileData = parse(_task);
+        // Set up before TileBuilders of other sources can share the TileData
+        if (tileData) { tileData->tessellations = std::make_shared<TessellationCache>(); }
+        return tileData;
+    };
+
+    if (!m_tileDataCache || dataKey().empty()) { return parseData(); }
+
+    return m_tileDataCache->getOrParse(dataKey(), _task.sourceGeneration(), _task.tileId(), parseData);
+}
+
+void TileSource::retainTileData(const TileTask& _task, std::shared_ptr<TileData> _tileData) const {
+
+    if (!m_tileDataCache || dataKey().empty()) { return; }
+
+    m_tileDataCache->put(dataKey(), _task.sourceGeneration(), _task.tileId(), std::move(_tileData));
+}
+
+std::shared_ptr<Mvt::StreamParser> TileSource::createStreamParser(const TileTask& _task) const {
+
+    if (m_format != Format::Mvt || isRaster() || !_task.parseWhileLoading()) { return nullptr; }
+
+    return std::make_shared<Mvt::StreamParser>(m_id);
+}
+
+void TileSource::setParsedTileData(TileTask& _task, std::shared_ptr<TileData> _tileData) const {
+
+    // Set up before TileBuilders of other sources can share the TileData
+    _tileData->tessellations = std::make_shared<TessellationCache>();
+
+    retainTileData(_task, _tileData);
+
+    _task.setTileData(std::move(_tileData));
+}
+
+std::shared_ptr<BinaryTileTask> TileSource::DataSource::createRevalidationTask(BinaryTileTask& _task) const {
+
+    auto source = _task.source();
+    if (!source) { return nullptr; }
+
+    TileID tileId = _task.tileId();
+    auto task = std::make_shared<BinaryTileTask>(tileId, source);
+    task->cacheInfo = _task.cacheInfo;
+    task->setPriority(_task.getPriority(), _task.isPrefetch());
+    // Changed data is loaded again by the tile
+    task->setParseWhileLoading(false);
+
+    // Skip the caches of the chain
+    const DataSource* last = this;
+    while (last->next) { last = last->next.get(); }
+    task->rawSource = last->level;
+
+    return task;
+}
+
+void TileSource::tileDataChanged(const TileTask& _task) {
+    std::lock_guard<std::mutex> lock(m_changedTilesMutex);
+    m_changedTiles.push_back(_task.tileId());
+}
+
+bool TileSource::hasChangedTiles() const {
+    std::lock_guard<std::mutex> lock(m_changedTilesMutex);
+    return !m_changedTiles.empty();
+}
+
+std::vector<TileID> TileSource::takeChangedTiles() {
+    std::vector<TileID> changedTiles;
+    {
+        std::lock_guard<std::mutex> lock(m_changedTilesMutex);
+        changedTiles.swap(m_changedTiles);
+    }
+    for (const auto& tileId : changedTiles) {
+        invalidateTileData(tileId);
+    }
+    return changedTiles;
+}
+
+void TileSource::invalidateTileData(const TileID& _tileId) {
+
+    if (!m_tileDataCache || dataKey().empty()) { return; }
+
+    m_tileDataCache->remove(dataKey(), m_generation, _tileId);
+}
+
 void TileSource::clearData() {
 
     if (m_sources) { m_sources->clear(); }
@@ -80,7 +180,12 @@ void TileSource::clearData() {
 
 void TileSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
 
-    if (m_sources) {
+    if (_task->needsLoading() && _task->tileData()) {
+        // TileData was retained from a previous Scene: skip loading and parsing
+        _task->startedLoading();
+        _cb.func(_task);
+
+    } else if (m_sources) {
         if (_task->needsLoading()) {
             if (m_sources->loadTileData(_task, _cb)) {
                 _task->startedLoading();
@@ -114,6 +219,16 @@ void TileSource::cancelLoadingTile(TileTask& _task) {
     }
 }
 
+void TileSource::updateTaskPriority(TileTask& _task) {
+
+    if (m_sources) { m_sources->updateTaskPriority(_task); }
+
+    for (auto& subTask : _task.subTasks()) {
+        subTask->setPriority(_task.getPriority(), _task.isPrefetch());
+        subTask->source()->updateTaskPriority(*subTask);
+    }
+}
+
 void TileSource::addRasterSource(std::shared_ptr<TileSource> _rasterSource) {
     if (!_rasterSource) {
         LOGE("No raster source");
@@ -0,0 +1,209 @@
+#include "data/urlRequestCoalescer.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Tangram {
+
+UrlRequestHandle UrlRequestCoalescer::startRequest(const std::string& _key, const Url& _url,
+                                                   UrlCallback&& _callback) {
+    return startRequest(_key, _url, UrlCacheInfo{}, std::move(_callback));
+}
+
+UrlRequestHandle UrlRequestCoalescer::startRequest(const std::string& _key, const Url& _url,
+                                                   const UrlCacheInfo& _cacheInfo, UrlCallback&& _callback) {
+    return startRequest(_key, _url, _cacheInfo, std::move(_callback), UrlStreamCallback{});
+}
+
+UrlRequestHandle UrlRequestCoalescer::startRequest(const std::string& _key, const Url& _url,
+                                                   const UrlCacheInfo& _cacheInfo, UrlCallback&& _callback,
+                                                   UrlStreamCallback&& _stream) {
+    std::shared_ptr<Request> request;
+    bool streaming = bool(_stream);
+    UrlRequestHandle handle;
+
+    // A response to a conditional request may be empty
+    std::string key = _key;
+    if (_cacheInfo.canRevalidate()) {
+        key += "\n" + _cacheInfo.etag + "\n" + _cacheInfo.lastModified;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        handle = ++m_lastHandle;
+
+        auto it = m_requests.find(key);
+        if (it != m_requests.end()) {
+            it->second->callers.push_back({handle, std::move(_callback), 0, std::move(_stream)});
+            m_handles.emplace(handle, it->second);
+            m_stats.coalesced++;
+            return handle;
+        }
+
+        request = std::make_shared<Request>();
+        request->key = key;
+        request->callers.push_back({handle, std::move(_callback), 0, std::move(_stream)});
+
+        m_requests.emplace(key, request);
+        m_handles.emplace(handle, request);
+        m_stats.requests++;
+    }
+
+    // Not locked: the platform may call back synchronously
+    UrlCallback onResponse = [self = shared_from_this(), request](UrlResponse&& _response) {
+        self->onResponse(request, std::move(_response));
+    };
+    UrlRequestHandle urlRequest;
+    if (streaming) {
+        urlRequest = m_platform.startUrlRequest(_url, _cacheInfo, std::move(onResponse),
+            [self = shared_from_this(), request](size_t _offset, const char* _data, size_t _size) {
+                self->onData(request, _offset, _data, _size);
+            });
+    } else {
+        urlRequest = m_platform.startUrlRequest(_url, _cacheInfo, std::move(onResponse));
+    }
+
+    bool cancel = false;
+    double priority = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        request->urlRequest = urlRequest;
+        cancel = request->canceled;
+        priority = request->priority;
+    }
+    // All callbacks were dropped before the request was started
+    if (cancel) {
+        m_platform.cancelUrlRequest(urlRequest);
+    } else if (priority != 0) {
+        m_platform.setUrlRequestPriority(urlRequest, priority);
+    }
+
+    return handle;
+}
+
+void UrlRequestCoalescer::cancelRequest(UrlRequestHandle _handle) {
+    UrlRequestHandle urlRequest = 0;
+    bool cancel = false;
+    double priority = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_handles.find(_handle);
+        if (it == m_handles.end()) { return; }
+
+        auto request = it->second;
+        m_handles.erase(it);
+
+        auto& callers = request->callers;
+        callers.erase(std::remove_if(callers.begin(), callers.end(),
+                                     [&](auto& _caller) { return _caller.handle == _handle; }),
+                      callers.end());
+
+        if (callers.empty()) {
+            auto entry = m_requests.find(request->key);
+            if (entry != m_requests.end() && entry->second == request) {
+                m_requests.erase(entry);
+            }
+            request->canceled = true;
+            cancel = true;
+        } else {
+            // The remaining callers may have a lower priority
+            priority = requestPriority(*request);
+            if (priority == request->priority) { return; }
+            request->priority = priority;
+        }
+        urlRequest = request->urlRequest;
+    }
+
+    if (!urlRequest) { return; }
+
+    if (cancel) {
+        m_platform.cancelUrlRequest(urlRequest);
+    } else {
+        m_platform.setUrlRequestPriority(urlRequest, priority);
+    }
+}
+
+void UrlRequestCoalescer::onResponse(const std::shared_ptr<Request>& _request, UrlResponse&& _response) {
+    std::vector<Caller> callers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto entry = m_requests.find(_request->key);
+        if (entry != m_requests.end() && entry->second == _request) {
+            m_requests.erase(entry);
+        }
+        for (auto& caller : _request->callers) {
+            m_handles.erase(caller.handle);
+        }
+        callers.swap(_request->callers);
+    }
+
+    for (size_t i = 0; i < callers.size(); i++) {
+        UrlResponse response;
+        response.error = _response.error;
+        response.cacheInfo = _response.cacheInfo;
+        response.notModified = _response.notModified;
+
+        if (i + 1 == callers.size()) {
+            response.content = std::move(_response.content);
+        } else {
+            response.content = _response.content;
+        }
+        callers[i].callback(std::move(response));
+    }
+}
+
+void UrlRequestCoalescer::onData(const std::shared_ptr<Request>& _request, size_t _offset,
+                                 const char* _data, size_t _size) {
+    UrlStreamCallback stream;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& caller : _request->callers) {
+            if (caller.stream) {
+                stream = caller.stream;
+                break;
+            }
+        }
+    }
+    if (stream) { stream(_offset, _data, _size); }
+}
+
+void UrlRequestCoalescer::setRequestPriority(UrlRequestHandle _handle, double _priority) {
+    UrlRequestHandle urlRequest = 0;
+    double priority = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_handles.find(_handle);
+        if (it == m_handles.end()) { return; }
+
+        auto& request = *it->second;
+        for (auto& caller : request.callers) {
+            if (caller.handle == _handle) { caller.priority = _priority; }
+        }
+
+        priority = requestPriority(request);
+        if (priority == request.priority) { return; }
+
+        request.priority = priority;
+        urlRequest = request.urlRequest;
+    }
+
+    if (urlRequest) { m_platform.setUrlRequestPriority(urlRequest, priority); }
+}
+
+double UrlRequestCoalescer::requestPriority(const Request& _request) {
+    double priority = std::numeric_limits<double>::max();
+    for (auto& caller : _request.callers) {
+        priority = std::min(priority, caller.priority);
+    }
+    return priority;
+}
+
+UrlRequestCoalescer::Stats UrlRequestCoalescer::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+}
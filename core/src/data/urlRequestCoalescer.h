@@ -0,0 +1,94 @@
+#pragma once
+
+#include "platform.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/* UrlRequestCoalescer - Shares URL requests for the same resource
+ *
+ * NetworkDataSources of a Scene share one coalescer, so that TileSources using the
+ * same endpoint, e.g. a vector source duplicated for labels, load each tile once.
+ * A request is started for the first caller of a key; callers with the same key
+ * that start while it is in flight get a copy of its response.
+ */
+class UrlRequestCoalescer : public std::enable_shared_from_this<UrlRequestCoalescer> {
+
+public:
+
+    struct Stats {
+        // URL requests started
+        size_t requests = 0;
+        // Requests that were served by a URL request in flight
+        size_t coalesced = 0;
+    };
+
+    explicit UrlRequestCoalescer(Platform& _platform) : m_platform(_platform) {}
+
+    /* Requests _url, or joins the request in flight for _key. Returns a handle to
+     * cancel the request with.
+     */
+    UrlRequestHandle startRequest(const std::string& _key, const Url& _url, UrlCallback&& _callback);
+
+    /* Conditional request for content cached with _cacheInfo, see Platform::startUrlRequest.
+     * It is only shared with requests for the same key and validators.
+     */
+    UrlRequestHandle startRequest(const std::string& _key, const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                  UrlCallback&& _callback);
+
+    /* Request that passes the content to _stream while it arrives. Only one caller of a
+     * shared request receives the content stream, the others only get the response.
+     */
+    UrlRequestHandle startRequest(const std::string& _key, const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                  UrlCallback&& _callback, UrlStreamCallback&& _stream);
+
+    /* Drops the callback of _handle. The URL request is canceled when no callbacks are left. */
+    void cancelRequest(UrlRequestHandle _handle);
+
+    /* Sets the priority of _handle. A shared URL request gets the highest priority of its callers. */
+    void setRequestPriority(UrlRequestHandle _handle, double _priority);
+
+    Stats stats() const;
+
+private:
+
+    struct Caller {
+        UrlRequestHandle handle;
+        UrlCallback callback;
+        double priority;
+        UrlStreamCallback stream;
+    };
+
+    struct Request {
+        std::string key;
+        UrlRequestHandle urlRequest = 0;
+        bool canceled = false;
+        std::vector<Caller> callers;
+        double priority = 0;
+    };
+
+    // Priority of the URL request, the lowest priority value of its callers
+    static double requestPriority(const Request& _request);
+
+    void onResponse(const std::shared_ptr<Request>& _request, UrlResponse&& _response);
+
+    void onData(const std::shared_ptr<Request>& _request, size_t _offset, const char* _data, size_t _size);
+
+    Platform& m_platform;
+
+    mutable std::mutex m_mutex;
+
+    std::unordered_map<std::string, std::shared_ptr<Request>> m_requests;
+    std::unordered_map<UrlRequestHandle, std::shared_ptr<Request>> m_handles;
+
+    UrlRequestHandle m_lastHandle = 0;
+
+    Stats m_stats;
+};
+
+}
@@ -1,10 +1,16 @@
 #include "debug/frameInfo.h"
 
+#include "data/tileDataCache.h"
+#include "data/urlRequestCoalescer.h"
 #include "debug/textDisplay.h"
 #include "gl.h"
 #include "gl/glError.h"
 #include "gl/primitives.h"
+#include "gl/programBinaryCache.h"
+#include "gl/renderState.h"
 #include "map.h"
+#include "scene/scene.h"
+#include "text/fontContext.h"
 #include "tile/tileManager.h"
 #include "tile/tile.h"
 #include "tile/tileCache.h"
@@ -52,7 +58,7 @@ void FrameInfo::beginFrame() {
 }
 
 
-void FrameInfo::draw(RenderState& rs, const View& _view, const TileManager& _tileManager) {
+void FrameInfo::draw(RenderState& rs, const View& _view, const Scene& _scene) {
 
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
         static int cpt = 0;
@@ -100,9 +106,11 @@ void FrameInfo::draw(RenderState& rs, const View& _view, const TileManager& _til
         avgTimeCpu /= 60;
         avgTimeUpdate /= 60;
 
+        const auto& tileManager = *_scene.tileManager();
+
         size_t memused = 0;
         size_t features = 0;
-        for (const auto& tile : _tileManager.getVisibleTiles()) {
+        for (const auto& tile : tileManager.getVisibleTiles()) {
             memused += tile->getMemoryUsage();
             features += tile->getSelectionFeatures().size();
         }
@@ -111,15 +119,44 @@ void FrameInfo::draw(RenderState& rs, const View& _view, const TileManager& _til
             std::vector<std::string> debuginfos;
 
             debuginfos.push_back("visible tiles:"
-                                 + std::to_string(_tileManager.getVisibleTiles().size()));
+                                 + std::to_string(tileManager.getVisibleTiles().size()));
             debuginfos.push_back("selectable features:"
                                  + std::to_string(features));
             debuginfos.push_back("tile cache size:"
-                                 + std::to_string(_tileManager.getTileCache()->getMemoryUsage() / 1024) + "kb");
+                                 + std::to_string(tileManager.getTileCache()->getMemoryUsage() / 1024) + "kb");
             debuginfos.push_back("tile size:" + std::to_string(memused / 1024) + "kb");
+            if (_scene.requestCoalescer()) {
+                auto stats = _scene.requestCoalescer()->stats();
+                size_t sharedParses = _scene.tileDataCache() ? _scene.tileDataCache()->sharedParses() : 0;
+                debuginfos.push_back("tile requests:" + std::to_string(stats.requests)
+                                     + " coalesced:" + std::to_string(stats.coalesced)
+                                     + " shared parses:" + std::to_string(sharedParses));
+            }
             debuginfos.push_back("avg frame cpu time:" + to_string_with_precision(avgTimeCpu, 2) + "ms");
             debuginfos.push_back("avg frame render time:" + to_string_with_precision(avgTimeRender, 2) + "ms");
             debuginfos.push_back("avg frame update time:" + to_string_with_precision(avgTimeUpdate, 2) + "ms");
+            if (rs.programBinaryCache && rs.programBinaryCache->isEnabled()) {
+                const auto& stats = rs.programBinaryCache->stats();
+                debuginfos.push_back("programs warm/cold:" + std::to_string(stats.warmBuilds) + "/"
+                                     + std::to_string(stats.coldBuilds) + " "
+                                     + to_string_with_precision(stats.warmTime, 2) + "ms/"
+                                     + to_string_with_precision(stats.coldTime, 2) + "ms");
+            }
+            if (_scene.fontContext()) {
+                auto stats = _scene.fontContext()->layoutCacheStats();
+                size_t lookups = stats.hits + stats.misses;
+                float hitRate = lookups > 0 ? 100.f * stats.hits / lookups : 0.f;
+                debuginfos.push_back("text layouts:" + std::to_string(stats.entries) + " "
+                                     + std::to_string(stats.memoryUsage / 1024) + "kb hit rate:"
+                                     + to_string_with_precision(hitRate, 1) + "%");
+
+                auto atlas = _scene.fontContext()->atlasStats();
+                debuginfos.push_back("glyph atlas:" + std::to_string(atlas.usedTextures) + "/"
+                                     + std::to_string(atlas.textures) + " textures "
+                                     + std::to_string(atlas.glyphs) + " glyphs "
+                                     + std::to_string(atlas.memoryUsage / 1024) + "kb occupancy:"
+                                     + to_string_with_precision(atlas.occupancy * 100.f, 1) + "%");
+            }
             debuginfos.push_back("zoom:" + std::to_string(_view.getZoom()));
             debuginfos.push_back("pos:" + std::to_string(_view.getPosition().x) + "/"
                                  + std::to_string(_view.getPosition().y));
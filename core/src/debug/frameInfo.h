@@ -3,7 +3,7 @@
 namespace Tangram {
 
 class RenderState;
-class TileManager;
+class Scene;
 class View;
 
 struct FrameInfo {
@@ -13,7 +13,7 @@ struct FrameInfo {
 
     static void endUpdate();
 
-    static void draw(RenderState& rs, const View& _view, const TileManager& _tileManager);
+    static void draw(RenderState& rs, const View& _view, const Scene& _scene);
 };
 
 }
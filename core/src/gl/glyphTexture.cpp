@@ -3,13 +3,15 @@
 #include "gl/renderState.h"
 #include "log.h"
 
+#include <cstring>
+
 namespace Tangram {
 
-GlyphTexture::GlyphTexture() : Texture(textureOptions()) {
+GlyphTexture::GlyphTexture(int _size) : Texture(textureOptions()) {
 
-    m_buffer.reset(reinterpret_cast<GLubyte*>(std::calloc(size * size, sizeof(GLubyte))));
+    m_buffer.reset(reinterpret_cast<GLubyte*>(std::calloc(_size * _size, sizeof(GLubyte))));
     m_disposeBuffer = false;
-    resize(size, size);
+    resize(_size, _size);
 }
 
 bool GlyphTexture::bind(RenderState& _rs, GLuint _textureUnit) {
@@ -45,6 +47,23 @@ bool GlyphTexture::bind(RenderState& _rs, GLuint _textureUnit) {
     return true;
 }
 
+void GlyphTexture::readCell(int _x, int _y, int _width, int _height, GLubyte* _dst) const {
+    const GLubyte* src = m_buffer.get() + _x + _y * m_width;
+
+    for (int y = 0; y < _height; y++) {
+        std::memcpy(_dst + y * _width, src + y * m_width, _width);
+    }
+}
+
+void GlyphTexture::writeCell(int _x, int _y, int _width, int _height, const GLubyte* _src) {
+    GLubyte* dst = m_buffer.get() + _x + _y * m_width;
+
+    for (int y = 0; y < _height; y++) {
+        std::memcpy(dst + y * m_width, _src + y * _width, _width);
+    }
+    setRowsDirty(_y, _height);
+}
+
 void GlyphTexture::setRowsDirty(int start, int count) {
     // FIXME: check that dirty range is valid for texture size!
     int max = start + count;
@@ -11,14 +11,20 @@ class GlyphTexture : public Texture {
         return options;
     }
 public:
-    static constexpr int size = 256;
+    static constexpr int defaultSize = 256;
 
-    GlyphTexture();
+    explicit GlyphTexture(int _size = defaultSize);
 
     bool bind(RenderState& rs, GLuint _unit) override;
 
     void setRowsDirty(int start, int count);
 
+    // Copy the _width x _height cell at _x, _y into the tightly packed _dst
+    void readCell(int _x, int _y, int _width, int _height, GLubyte* _dst) const;
+
+    // Copy the tightly packed _src into the cell at _x, _y and mark its rows dirty
+    void writeCell(int _x, int _y, int _width, int _height, const GLubyte* _src);
+
     GLubyte* buffer() { return m_buffer.get(); }
 
 protected:
@@ -16,9 +16,13 @@ bool supportsMapBuffer = false;
 bool supportsVAOs = false;
 bool supportsTextureNPOT = false;
 bool supportsGLRGBA8OES = false;
+bool supportsProgramBinary = false;
 
 uint32_t maxTextureSize = 0;
 uint32_t maxCombinedTextureUnits = 0;
+uint32_t maxVertexTextureUnits = 0;
+std::atomic<bool> supportsVertexTextureFetch{false};
+std::string driverInfo;
 static char* s_glExtensions;
 
 bool isAvailable(std::string _extension) {
@@ -56,11 +60,13 @@ void loadExtensions() {
     supportsVAOs = isAvailable("vertex_array_object");
     supportsTextureNPOT = isAvailable("texture_non_power_of_two");
     supportsGLRGBA8OES = isAvailable("rgb8_rgba8");
+    supportsProgramBinary = isAvailable("get_program_binary");
 
     LOG("Driver supports map buffer: %d", supportsMapBuffer);
     LOG("Driver supports vaos: %d", supportsVAOs);
     LOG("Driver supports rgb8_rgba8: %d", supportsGLRGBA8OES);
     LOG("Driver supports NPOT texture: %d", supportsTextureNPOT);
+    LOG("Driver supports program binary: %d", supportsProgramBinary);
 
     // find extension symbols if needed
     initGLExtensions();
@@ -74,8 +80,28 @@ void loadCapabilities() {
     GL::getIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &val);
     maxCombinedTextureUnits = val;
 
+    val = 0;
+    GL::getIntegerv(GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS, &val);
+    maxVertexTextureUnits = val;
+    supportsVertexTextureFetch = val > 0;
+
+    if (supportsProgramBinary) {
+        // Drivers may expose the extension without supporting any binary format
+        val = 0;
+        GL::getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &val);
+        supportsProgramBinary = val > 0;
+    }
+
+    driverInfo.clear();
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        auto str = GL::getString(name);
+        if (str) { driverInfo += reinterpret_cast<const char*>(str); }
+        driverInfo += '\n';
+    }
+
     LOG("Hardware max texture size %d", maxTextureSize);
     LOG("Hardware max combined texture units %d", maxCombinedTextureUnits);
+    LOG("Hardware max vertex texture units %d", maxVertexTextureUnits);
 }
 
 }
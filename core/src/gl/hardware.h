@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 
 namespace Tangram {
@@ -9,8 +10,17 @@ extern bool supportsMapBuffer;
 extern bool supportsVAOs;
 extern bool supportsTextureNPOT;
 extern bool supportsGLRGBA8OES;
+extern bool supportsProgramBinary;
 extern uint32_t maxTextureSize;
 extern uint32_t maxCombinedTextureUnits;
+extern uint32_t maxVertexTextureUnits;
+
+// Whether vertex shaders can sample textures. Set on GL setup and read by tile
+// workers, which build meshes with compact vertices only when it is set.
+extern std::atomic<bool> supportsVertexTextureFetch;
+
+// Vendor, renderer and version of the GL driver
+extern std::string driverInfo;
 
 void loadCapabilities();
 void loadExtensions();
@@ -162,6 +162,10 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
     }
 
     if (useVao) {
+        // Meshes reused by a new scene are drawn with the program of its style
+        if (m_vaos.isInitialized() && !m_vaos.matches(_shader, *m_vertexLayout)) {
+            m_vaos.dispose(rs);
+        }
         if (!m_vaos.isInitialized()) {
             // Capture vao state
             m_vaos.initialize(rs, _shader, m_vertexOffsets, *m_vertexLayout, m_glVertexBuffer, m_glIndexBuffer);
@@ -0,0 +1,109 @@
+#include "gl/programBinaryCache.h"
+
+#include "gl/glError.h"
+#include "gl/hardware.h"
+#include "log.h"
+#include "platform.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace Tangram {
+
+// Stored binaries are prefixed with this tag and the binary format of the driver.
+static constexpr char binaryTag[4] = { 'T', 'G', 'P', 'B' };
+static constexpr size_t headerSize = sizeof(binaryTag) + sizeof(GLenum);
+
+// Bump when the stored layout or the inputs of the key change.
+static constexpr uint32_t keyVersion = 1;
+
+// 64 bit FNV-1a: unlike std::hash this gives the same result on every platform and run.
+static uint64_t fnv1a(uint64_t _hash, const char* _data, size_t _length) {
+    for (size_t i = 0; i < _length; i++) {
+        _hash ^= static_cast<unsigned char>(_data[i]);
+        _hash *= 0x100000001b3ULL;
+    }
+    return _hash;
+}
+
+std::string ProgramBinaryCache::makeKey(const std::string& _vertSrc, const std::string& _fragSrc,
+                                        const std::string& _driver) {
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    // Terminate each part so that moving text from one source to another changes the key.
+    hash = fnv1a(hash, _vertSrc.c_str(), _vertSrc.size() + 1);
+    hash = fnv1a(hash, _fragSrc.c_str(), _fragSrc.size() + 1);
+    hash = fnv1a(hash, _driver.c_str(), _driver.size() + 1);
+
+    char key[32];
+    snprintf(key, sizeof(key), "v%u-%016llx", keyVersion, static_cast<unsigned long long>(hash));
+    return key;
+}
+
+std::string ProgramBinaryCache::makeKey(const std::string& _vertSrc, const std::string& _fragSrc) {
+    return makeKey(_vertSrc, _fragSrc, Hardware::driverInfo);
+}
+
+bool ProgramBinaryCache::isEnabled() const {
+    return Hardware::supportsProgramBinary;
+}
+
+GLuint ProgramBinaryCache::loadProgram(const std::string& _key) {
+
+    auto binary = m_platform.loadProgramBinary(_key);
+    if (binary.size() <= headerSize || memcmp(binary.data(), binaryTag, sizeof(binaryTag)) != 0) {
+        return 0;
+    }
+
+    GLenum format = 0;
+    memcpy(&format, binary.data() + sizeof(binaryTag), sizeof(GLenum));
+
+    GLuint program = GL::createProgram();
+    GL::programBinary(program, format, binary.data() + headerSize, binary.size() - headerSize);
+
+    GLint isLinked = GL_FALSE;
+    GL::getProgramiv(program, GL_LINK_STATUS, &isLinked);
+
+    if (isLinked == GL_FALSE) {
+        // The driver may reject binaries from a different driver version. The program
+        // will then be compiled from source and stored again.
+        LOGD("Discarding incompatible program binary %s", _key.c_str());
+        GL::deleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+void ProgramBinaryCache::storeProgram(const std::string& _key, GLuint _program) {
+
+    GLint length = 0;
+    GL::getProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) { return; }
+
+    std::vector<char> binary(headerSize + length);
+
+    GLenum format = 0;
+    GLsizei written = 0;
+    GL::getProgramBinary(_program, length, &written, &format, binary.data() + headerSize);
+    if (written <= 0) { return; }
+
+    binary.resize(headerSize + written);
+    memcpy(binary.data(), binaryTag, sizeof(binaryTag));
+    memcpy(binary.data() + sizeof(binaryTag), &format, sizeof(GLenum));
+
+    m_platform.storeProgramBinary(_key, binary);
+}
+
+void ProgramBinaryCache::recordBuild(bool _warm, float _milliseconds) {
+    if (_warm) {
+        m_stats.warmBuilds++;
+        m_stats.warmTime += _milliseconds;
+    } else {
+        m_stats.coldBuilds++;
+        m_stats.coldTime += _milliseconds;
+    }
+}
+
+}
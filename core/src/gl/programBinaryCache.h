@@ -0,0 +1,61 @@
+#pragma once
+
+#include "gl.h"
+
+#include <string>
+
+namespace Tangram {
+
+class Platform;
+
+//
+// ProgramBinaryCache - stores linked shader programs through the Platform so that
+// later scene loads can skip GLSL compilation when the driver supports program binaries
+//
+class ProgramBinaryCache {
+
+public:
+
+    explicit ProgramBinaryCache(Platform& _platform) : m_platform(_platform) {}
+
+    // Build a key for a program from its final vertex and fragment shader sources and a
+    // description of the driver. The key only depends on its inputs, so it is stable across
+    // sessions and can be used to identify stored binaries.
+    static std::string makeKey(const std::string& _vertSrc, const std::string& _fragSrc,
+                               const std::string& _driver);
+
+    // Same as above, using the driver info of the current GL context.
+    static std::string makeKey(const std::string& _vertSrc, const std::string& _fragSrc);
+
+    // Return true if program binaries can be loaded and stored with the current GL context.
+    bool isEnabled() const;
+
+    // Create a linked program from the binary stored for _key. Returns 0 if no binary
+    // was stored or the driver rejected it (e.g. after a driver update).
+    GLuint loadProgram(const std::string& _key);
+
+    // Retrieve the binary of a linked program and pass it to the Platform for storage.
+    void storeProgram(const std::string& _key, GLuint _program);
+
+    // Record the time it took to build a program, either from a stored binary ('warm')
+    // or from source ('cold').
+    void recordBuild(bool _warm, float _milliseconds);
+
+    struct Stats {
+        uint32_t warmBuilds = 0;
+        uint32_t coldBuilds = 0;
+        float warmTime = 0.f;
+        float coldTime = 0.f;
+    };
+
+    const Stats& stats() const { return m_stats; }
+
+private:
+
+    Platform& m_platform;
+
+    Stats m_stats;
+
+};
+
+}
@@ -3,6 +3,7 @@
 #include "gl/vertexLayout.h"
 #include "gl/glError.h"
 #include "gl/hardware.h"
+#include "gl/programBinaryCache.h"
 #include "gl/texture.h"
 #include "log.h"
 #include "platform.h"
@@ -2,6 +2,7 @@
 
 #include "gl.h"
 #include <array>
+#include <memory>
 #include <string>
 #include <mutex>
 #include <vector>
@@ -10,6 +11,7 @@
 namespace Tangram {
 
 class Disposer;
+class ProgramBinaryCache;
 class Scene;
 class Texture;
 
@@ -124,6 +126,9 @@ public:
     std::unordered_map<std::string, GLuint> fragmentShaders;
     std::unordered_map<std::string, GLuint> vertexShaders;
 
+    // Optional persistent cache for linked shader programs
+    std::unique_ptr<ProgramBinaryCache> programBinaryCache;
+
     float frameTime() { return m_frameTime; }
 
     friend class Scene;
@@ -1,12 +1,14 @@
 #include "gl/shaderProgram.h"
 
 #include "gl/glError.h"
+#include "gl/programBinaryCache.h"
 #include "gl/renderState.h"
 #include "glm/gtc/type_ptr.hpp"
 #include "scene/light.h"
 #include "log.h"
 #include "platform.h"
 
+#include <chrono>
 #include <sstream>
 
 namespace Tangram {
@@ -86,6 +88,32 @@ bool ShaderProgram::build(RenderState& rs) {
     auto& vertSrc = m_vertexShaderSource;
     auto& fragSrc = m_fragmentShaderSource;
 
+    auto startTime = std::chrono::steady_clock::now();
+    auto elapsedTime = [&]() {
+        std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+        return duration.count();
+    };
+
+    // Try to restore a previously linked program from its stored binary
+    auto* binaryCache = rs.programBinaryCache.get();
+    std::string binaryKey;
+
+    if (binaryCache && binaryCache->isEnabled()) {
+        binaryKey = ProgramBinaryCache::makeKey(vertSrc, fragSrc);
+
+        GLuint program = binaryCache->loadProgram(binaryKey);
+        if (program != 0) {
+            m_glProgram = program;
+            m_attribMap.clear();
+            m_rs = &rs;
+
+            float time = elapsedTime();
+            binaryCache->recordBuild(true, time);
+            LOGD("Loaded program binary for %s in %.2fms", m_description.c_str(), time);
+            return true;
+        }
+    }
+
     // Compile vertex and fragment shaders
     GLint vertexShader = makeCompiledShader(rs, vertSrc, GL_VERTEX_SHADER);
     if (vertexShader == 0) {
@@ -114,6 +142,14 @@ bool ShaderProgram::build(RenderState& rs) {
     m_attribMap.clear();
     m_rs = &rs;
 
+    if (!binaryKey.empty()) {
+        binaryCache->storeProgram(binaryKey, program);
+
+        float time = elapsedTime();
+        binaryCache->recordBuild(false, time);
+        LOGD("Compiled program for %s in %.2fms", m_description.c_str(), time);
+    }
+
     return true;
 }
 
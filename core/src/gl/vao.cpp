@@ -15,11 +15,13 @@ void Vao::initialize(RenderState& rs, ShaderProgram& _program, const VertexOffse
     GL::genVertexArrays(m_glVAOs.size(), m_glVAOs.data());
 
     fastmap<std::string, GLuint> locations;
+    m_locations.clear();
 
     // FIXME (use a bindAttrib instead of getLocation) to make those locations shader independent
     for (auto& attrib : _layout.getAttribs()) {
         GLint location = _program.getAttribLocation(attrib.name);
         locations[attrib.name] = location;
+        m_locations.push_back(location);
     }
 
     rs.vertexBuffer(_vertexBuffer);
@@ -52,6 +54,16 @@ bool Vao::isInitialized() {
     return !m_glVAOs.empty();
 }
 
+bool Vao::matches(ShaderProgram& _program, VertexLayout& _layout) {
+    const auto& attribs = _layout.getAttribs();
+    if (attribs.size() != m_locations.size()) { return false; }
+
+    for (size_t i = 0; i < attribs.size(); i++) {
+        if (_program.getAttribLocation(attribs[i].name) != m_locations[i]) { return false; }
+    }
+    return true;
+}
+
 void Vao::bind(unsigned int _index) {
     if (_index < m_glVAOs.size()) {
         GL::bindVertexArray(m_glVAOs[_index]);
@@ -19,12 +19,16 @@ public:
     void initialize(RenderState& rs, ShaderProgram& _program, const VertexOffsets& _vertexOffsets,
                     VertexLayout& _layout, GLuint _vertexBuffer, GLuint _indexBuffer);
     bool isInitialized();
+    // Whether the attribute locations captured by initialize() are those of _program,
+    // which differ for meshes that are reused with the program of a new scene
+    bool matches(ShaderProgram& _program, VertexLayout& _layout);
     void bind(unsigned int _index);
     void unbind();
     void dispose(RenderState& rs);
 
 private:
     std::vector<GLuint> m_glVAOs;
+    std::vector<GLint> m_locations;
 
 };
 
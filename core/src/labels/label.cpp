@@ -85,6 +85,7 @@ void Label::resetState() {
     m_occludedLastFrame = false;
     m_occluded = false;
     m_anchorIndex = 0;
+    m_placement.anchorIndex = -1;
     enterState(State::none, 0.0);
 }
 
@@ -140,6 +141,14 @@ bool Label::update(const glm::mat4& _mvp, const ViewState& _viewState,
     return true;
 }
 
+void Label::cull() {
+
+    m_occludedLastFrame = m_occluded;
+    m_occluded = false;
+
+    enterState(State::sleep, 0.0);
+}
+
 bool Label::evalState(float _dt) {
 
 #ifdef DEBUG
@@ -73,6 +73,16 @@ public:
 
     static const float activation_distance_threshold;
 
+    // Result of the last occlusion test of the label, reused by LabelManager
+    // while the label stays in place
+    struct Placement {
+        // Extent of the label OBBs when it was tested
+        AABB extent;
+        // Anchor fallback index after the test, -1 when there is no valid result
+        int anchorIndex = -1;
+        bool occluded = false;
+    };
+
     Label(glm::vec2 _size, Type _type, Options _options);
 
     virtual ~Label();
@@ -94,8 +104,17 @@ public:
     bool update(const glm::mat4& _mvp, const ViewState& _viewState,
                 const AABB* _bounds, ScreenTransform& _transform);
 
+    // Update the state of a label that is known to be out of bounds, like update()
+    // does when updateScreenTransform fails
+    void cull();
+
     bool evalState(float _dt);
 
+    // World position and screen space extent, relative to the projected position,
+    // of a label that is placed at a single point. The extent covers the label at
+    // any fractional zoom. Returns false for other labels.
+    virtual bool pointExtent(glm::vec2& _position, AABB& _extent) { return false; }
+
     // Update the screen position of the label
     virtual bool updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
                                        const AABB* _bounds, ScreenTransform& _transform) = 0;
@@ -154,6 +173,15 @@ public:
 
     void print() const;
 
+    Placement& placement() { return m_placement; }
+
+    // Lowest zoom at which the label does not collide with the labels of its tile in a
+    // view without rotation and tilt, as computed by LabelCollider. Negative when the
+    // label is not part of this placement hierarchy.
+    float placementZoom() const { return m_placementZoom; }
+
+    void setPlacementZoom(float _zoom) { m_placementZoom = _zoom; }
+
     void setAlpha(float _alpha);
 
 protected:
@@ -178,6 +206,10 @@ protected:
 
     glm::vec2 m_screenCenter;
     float m_alpha;
+
+    Placement m_placement;
+
+    float m_placementZoom = -1.f;
 };
 
 }
@@ -57,6 +57,78 @@ size_t LabelCollider::filterRepeatGroups(size_t startPos, size_t curPos) {
     return endPos;
 }
 
+// Scale of the distance between two labels below which their extents overlap,
+// with label a at position _pa * scale and b at _pb * scale.
+static float collisionScale(glm::vec2 _pa, const Label::AABB& _a, glm::vec2 _pb, const Label::AABB& _b) {
+
+    const float infinity = std::numeric_limits<float>::infinity();
+    float lower = 0.f, upper = infinity;
+
+    for (int i = 0; i < 2; i++) {
+        float d = _pb[i] - _pa[i];
+        // The extents overlap on this axis while lo < d * scale < hi
+        float lo = _a.min[i] - _b.max[i];
+        float hi = _a.max[i] - _b.min[i];
+
+        if (d > 0) {
+            lower = std::max(lower, lo / d);
+            upper = std::min(upper, hi / d);
+        } else if (d < 0) {
+            lower = std::max(lower, hi / d);
+            upper = std::min(upper, lo / d);
+        } else if (lo >= 0 || hi <= 0) {
+            return 0.f;
+        }
+    }
+
+    return lower < upper ? upper : 0.f;
+}
+
+void LabelCollider::computePlacementZooms(const glm::mat4& _mvp, const ViewState& _viewState, float _zoom) {
+
+    m_placements.clear();
+
+    for (auto& entry : m_labels) {
+        auto* label = entry.label;
+        label->setPlacementZoom(-1.f);
+
+        // Labels with anchor fallbacks or relatives are left to the full collision test
+        if (label->isOccluded() || label->relative() || label->options().anchors.count != 1) {
+            continue;
+        }
+
+        glm::vec2 position;
+        AABB extent;
+        if (!label->pointExtent(position, extent)) { continue; }
+
+        bool clipped = false;
+        glm::vec2 screenPosition = worldToScreenSpace(_mvp, glm::vec4(position, 0.0, 1.0),
+                                                      _viewState.viewportSize, clipped);
+        if (clipped) { continue; }
+
+        // Labels are in priority order: the label is placed where it does not collide
+        // with any label placed before it
+        float minScale = 0.f;
+        for (auto& other : m_placements) {
+            float scale = collisionScale(other.position, other.extent, screenPosition, extent);
+            if (scale > other.minScale) {
+                minScale = std::max(minScale, scale);
+            }
+        }
+
+        m_placements.push_back({ label, screenPosition, extent, minScale });
+    }
+
+    for (auto& placement : m_placements) {
+        float zoom = 0.f;
+        if (placement.minScale > 0.f) {
+            zoom = std::max(_zoom + std::log2(placement.minScale), 0.f);
+        }
+        placement.label->setPlacementZoom(zoom);
+    }
+    m_placements.clear();
+}
+
 void LabelCollider::process(TileID _tileID, float _tileInverseScale, float _tileSize) {
 
     // Sort labels so that all labels of one repeat group are next to each other
@@ -104,6 +176,8 @@ void LabelCollider::process(TileID _tileID, float _tileInverseScale, float _tile
         0.f, // fractZoom
         screenSize, // viewPortSize
         _tileSize, // screenTileSize
+        0.f, // roll
+        0.f, // pitch
     };
 
     m_obbs.clear();
@@ -299,6 +373,9 @@ void LabelCollider::process(TileID _tileID, float _tileInverseScale, float _tile
         }
     }
 
+    // The tile covers half of screenSize, as at view zoom s + overzoom - 1
+    computePlacementZooms(mvp, viewState, _tileID.s + overzoom - 1);
+
     m_labels.clear();
     m_aabbs.clear();
 }
@@ -28,6 +28,9 @@ private:
 
     size_t filterRepeatGroups(size_t startPos, size_t curPos);
 
+    // Set the placement zoom of the labels that were not occluded at _zoom
+    void computePlacementZooms(const glm::mat4& _mvp, const ViewState& _viewState, float _zoom);
+
     using AABB = isect2d::AABB<glm::vec2>;
     using OBB = isect2d::OBB<glm::vec2>;
     using CollisionPairs = std::vector<isect2d::ISect2D<glm::vec2>::Pair>;
@@ -55,6 +58,18 @@ private:
     isect2d::ISect2D<glm::vec2> m_isect2d;
 
     ScreenTransform::Buffer m_transforms;
+
+    struct Placement {
+        Label* label;
+        // Screen position at the zoom of the collider
+        glm::vec2 position;
+        // Screen extent relative to position
+        AABB extent;
+        // Scale relative to the zoom of the collider from which on the label is placed
+        float minScale;
+    };
+
+    std::vector<Placement> m_placements;
 };
 
 }
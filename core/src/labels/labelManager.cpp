@@ -24,65 +24,172 @@
 #include "glm/gtx/rotate_vector.hpp"
 #include "glm/gtx/norm.hpp"
 
+#include <atomic>
 #include <cassert>
+#include <unordered_set>
 
 namespace Tangram {
 
-LabelManager::LabelManager()
+const float LabelManager::occlusion_move_threshold = 1.f;
+
+LabelManager::LabelManager(uint32_t _numWorkers)
     : m_needUpdate(false),
-      m_lastZoom(0.0f) {}
+      m_lastZoom(0.0f) {
+
+    for (uint32_t i = 0; i < _numWorkers; i++) {
+        m_workers.push_back(std::make_unique<AsyncWorker>());
+    }
+}
 
 LabelManager::~LabelManager() {}
 
+// TODO appropriate buffer to filter out-of-screen labels
+static const float label_bounds_border = 256.0f;
+
+// Border of the bounds outside of which labels can be skipped, regardless of
+// whether they take part in collision detection
+static float cullBorder(bool _onlyRender) {
+    return _onlyRender ? 0.f : label_bounds_border;
+}
+
+static bool updateLabelTransform(Label& _label, const glm::mat4& _mvp, const ViewState& _viewState,
+                                 bool _onlyRender, ScreenTransform& _transform) {
+
+    float border = label_bounds_border;
+
+    // Use extended bounds when labels take part in collision detection.
+    if (_onlyRender || !_label.canOcclude()) { border = 0.f; }
+
+    Label::AABB bounds(-border, -border,
+                       _viewState.viewportSize.x + border,
+                       _viewState.viewportSize.y + border);
+
+    return _label.update(_mvp, _viewState, &bounds, _transform);
+}
+
 void LabelManager::processLabelUpdate(const ViewState& _viewState, const LabelSet* _labelSet, Style* _style,
                                 const Tile* _tile, const Marker* _marker, const glm::mat4& _mvp,
                                 float _dt, bool _drawAll, bool _onlyRender, bool _isProxy) {
 
-    // TODO appropriate buffer to filter out-of-screen labels
-    float border = 256.0f;
-    AABB extendedBounds(-border, -border,
-                        _viewState.viewportSize.x + border,
-                        _viewState.viewportSize.y + border);
+    auto& labels = _labelSet->getLabels();
 
-    AABB screenBounds(0, 0,
-                      _viewState.viewportSize.x,
-                      _viewState.viewportSize.y);
+    _labelSet->cullLabels(_mvp, _viewState.viewportSize, cullBorder(_onlyRender), m_culledLabels);
 
-    for (auto& label : _labelSet->getLabels()) {
+    for (size_t i = 0; i < labels.size(); i++) {
+        auto& label = labels[i];
         if (!_drawAll && (label->state() == Label::State::dead) ) {
             continue;
         }
+        if (m_culledLabels[i]) {
+            label->cull();
+            continue;
+        }
 
         Range transformRange;
         ScreenTransform transform { m_transforms, transformRange };
 
-        // Use extendedBounds when labels take part in collision detection.
-        auto bounds = (_onlyRender || !label->canOcclude())
-            ? screenBounds
-            : extendedBounds;
-
-        if (!label->update(_mvp, _viewState, &bounds, transform)) {
+        if (!updateLabelTransform(*label, _mvp, _viewState, _onlyRender, transform)) {
             continue;
         }
 
+        processLabel(_viewState, label.get(), _style, _tile, _marker, transformRange,
+                     _dt, _onlyRender, _isProxy);
+    }
+}
 
-        if (_onlyRender) {
-            if (label->occludedLastFrame()) { label->occlude(); }
+void LabelManager::processLabel(const ViewState& _viewState, Label* _label, Style* _style,
+                                const Tile* _tile, const Marker* _marker, Range _transformRange,
+                                float _dt, bool _onlyRender, bool _isProxy) {
 
-            if (label->visibleState() || !label->canOcclude()) {
-                m_needUpdate |= label->evalState(_dt);
-                label->addVerticesToMesh(transform, _viewState.viewportSize);
-            }
-        } else if (label->canOcclude()) {
-            m_labels.emplace_back(label.get(), _style, _tile, _marker, _isProxy, transformRange);
-        } else {
-            m_needUpdate |= label->evalState(_dt);
-            label->addVerticesToMesh(transform, _viewState.viewportSize);
+    ScreenTransform transform { m_transforms, _transformRange };
+
+    if (_onlyRender) {
+        if (_label->occludedLastFrame()) { _label->occlude(); }
+
+        if (_label->visibleState() || !_label->canOcclude()) {
+            m_needUpdate |= _label->evalState(_dt);
+            _label->addVerticesToMesh(transform, _viewState.viewportSize);
         }
-        if (label->selectionColor()) {
-            m_selectionLabels.emplace_back(label.get(), _style, _tile, _marker, _isProxy, transformRange);
+    } else if (_label->canOcclude()) {
+        m_labels.emplace_back(_label, _style, _tile, _marker, _isProxy, _transformRange);
+    } else {
+        m_needUpdate |= _label->evalState(_dt);
+        _label->addVerticesToMesh(transform, _viewState.viewportSize);
+    }
+    if (_label->selectionColor()) {
+        m_selectionLabels.emplace_back(_label, _style, _tile, _marker, _isProxy, _transformRange);
+    }
+}
+
+void LabelManager::updateTileTransforms(const ViewState& _viewState,
+                                        const std::vector<std::unique_ptr<Style>>& _styles,
+                                        const std::vector<std::shared_ptr<Tile>>& _tiles,
+                                        bool _drawAll, bool _onlyRender) {
+
+    if (m_tileTransforms.size() < _tiles.size()) {
+        m_tileTransforms.resize(_tiles.size());
+    }
+
+    std::atomic<size_t> nextTile{0};
+
+    // Label::update only modifies the label and the transform buffer of its tile,
+    // so that the labels of each tile can be updated on a separate thread.
+    auto updateTiles = [&]() {
+        for (size_t i = nextTile++; i < _tiles.size(); i = nextTile++) {
+            const auto& tile = _tiles[i];
+            auto& tileTransforms = m_tileTransforms[i];
+
+            tileTransforms.transforms.clear();
+            tileTransforms.labels.clear();
+
+            glm::mat4 mvp = tile->mvp();
+
+            for (const auto& style : _styles) {
+                const auto& mesh = tile->getMesh(*style);
+                auto labels = dynamic_cast<const LabelSet*>(mesh.get());
+                if (!labels) { continue; }
+
+                labels->cullLabels(mvp, _viewState.viewportSize, cullBorder(_onlyRender),
+                                   tileTransforms.culled);
+
+                for (size_t j = 0; j < labels->getLabels().size(); j++) {
+                    auto& label = labels->getLabels()[j];
+                    if (!_drawAll && (label->state() == Label::State::dead) ) {
+                        continue;
+                    }
+                    if (tileTransforms.culled[j]) {
+                        label->cull();
+                        continue;
+                    }
+
+                    Range transformRange;
+                    ScreenTransform transform { tileTransforms.transforms, transformRange };
+
+                    if (updateLabelTransform(*label, mvp, _viewState, _onlyRender, transform)) {
+                        tileTransforms.labels.push_back({ label.get(), style.get(), transformRange });
+                    }
+                }
+            }
         }
+    };
+
+    size_t numTasks = std::min(m_workers.size(), _tiles.size() - 1);
+    size_t pendingTasks = numTasks;
+
+    for (size_t i = 0; i < numTasks; i++) {
+        m_workers[i]->enqueue([&]() {
+            updateTiles();
+
+            std::lock_guard<std::mutex> lock(m_workerMutex);
+            if (--pendingTasks == 0) { m_workerCondition.notify_one(); }
+        });
     }
+
+    // Take part in the work instead of waiting idle
+    updateTiles();
+
+    std::unique_lock<std::mutex> lock(m_workerMutex);
+    m_workerCondition.wait(lock, [&]{ return pendingTasks == 0; });
 }
 
 std::pair<Label*, const Tile*> LabelManager::getLabel(uint32_t _selectionColor) const {
@@ -114,26 +221,50 @@ void LabelManager::updateLabels(const ViewState& _viewState, float _dt,
 
     bool drawAllLabels = Tangram::getDebugFlag(DebugFlags::draw_all_labels);
 
-    for (const auto& tile : _tiles) {
+    if (!m_workers.empty() && _tiles.size() > 1) {
 
-        //LOG("tile: %d/%d z:%d,%d", tile->getID().x, tile->getID().y, tile->getID().z, tile->getID().s);
+        updateTileTransforms(_viewState, _styles, _tiles, drawAllLabels, _onlyRender);
 
-        // discard based on level of detail
-        // if ((zoom - tile->getID().z) > lodDiscard) {
-        //     continue;
-        // }
+        // Merge the tile transforms in tile order, so that the set of labels and
+        // thus the result of the occlusion pass does not depend on the threads.
+        for (size_t i = 0; i < _tiles.size(); i++) {
+            const auto& tile = _tiles[i];
+            auto& tileTransforms = m_tileTransforms[i];
+            auto& points = tileTransforms.transforms.points;
 
-        bool proxyTile = tile->isProxy();
+            size_t offset = m_transforms.points.size();
+            m_transforms.points.insert(m_transforms.points.end(), points.begin(), points.end());
 
-        glm::mat4 mvp = tile->mvp();
+            for (auto& entry : tileTransforms.labels) {
+                Range transformRange = entry.transformRange;
+                transformRange.start += offset;
 
-        for (const auto& style : _styles) {
-            const auto& mesh = tile->getMesh(*style);
-            auto labels = dynamic_cast<const LabelSet*>(mesh.get());
-            if (!labels) { continue; }
+                processLabel(_viewState, entry.label, entry.style, tile.get(), nullptr,
+                             transformRange, _dt, _onlyRender, tile->isProxy());
+            }
+        }
+    } else {
+        for (const auto& tile : _tiles) {
+
+            //LOG("tile: %d/%d z:%d,%d", tile->getID().x, tile->getID().y, tile->getID().z, tile->getID().s);
+
+            // discard based on level of detail
+            // if ((zoom - tile->getID().z) > lodDiscard) {
+            //     continue;
+            // }
+
+            bool proxyTile = tile->isProxy();
 
-            processLabelUpdate(_viewState, labels, style.get(), tile.get(), nullptr, mvp,
-                               _dt, drawAllLabels, _onlyRender, proxyTile);
+            glm::mat4 mvp = tile->mvp();
+
+            for (const auto& style : _styles) {
+                const auto& mesh = tile->getMesh(*style);
+                auto labels = dynamic_cast<const LabelSet*>(mesh.get());
+                if (!labels) { continue; }
+
+                processLabelUpdate(_viewState, labels, style.get(), tile.get(), nullptr, mvp,
+                                   _dt, drawAllLabels, _onlyRender, proxyTile);
+            }
         }
     }
 
@@ -318,11 +449,101 @@ bool LabelManager::zOrderComparator(const LabelEntry& _a, const LabelEntry& _b)
     return bool(_a.tile);
 }
 
-void LabelManager::handleOcclusions(const ViewState& _viewState) {
+static Label::AABB obbsExtent(OBBBuffer& _obbs) {
+    Label::AABB extent;
+    for (auto& obb : _obbs) {
+        extent = unionAABB(extent, obb.getExtent());
+    }
+    return extent;
+}
+
+void LabelManager::markDirtyCells(const AABB& _aabb) {
+    if (m_dirtyCells.empty()) { return; }
+
+    glm::vec2 cellSize = glm::max(m_viewportSize / glm::vec2(m_gridSplit), glm::vec2(1.f));
+
+    int x0 = glm::clamp(int(_aabb.min.x / cellSize.x), 0, m_gridSplit.x - 1);
+    int x1 = glm::clamp(int(_aabb.max.x / cellSize.x), 0, m_gridSplit.x - 1);
+    int y0 = glm::clamp(int(_aabb.min.y / cellSize.y), 0, m_gridSplit.y - 1);
+    int y1 = glm::clamp(int(_aabb.max.y / cellSize.y), 0, m_gridSplit.y - 1);
+
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            m_dirtyCells[y * m_gridSplit.x + x] = true;
+        }
+    }
+}
+
+bool LabelManager::hasDirtyCells(const AABB& _aabb) const {
+    if (m_dirtyCells.empty()) { return true; }
+
+    glm::vec2 cellSize = glm::max(m_viewportSize / glm::vec2(m_gridSplit), glm::vec2(1.f));
+
+    int x0 = glm::clamp(int(_aabb.min.x / cellSize.x), 0, m_gridSplit.x - 1);
+    int x1 = glm::clamp(int(_aabb.max.x / cellSize.x), 0, m_gridSplit.x - 1);
+    int y0 = glm::clamp(int(_aabb.min.y / cellSize.y), 0, m_gridSplit.y - 1);
+    int y1 = glm::clamp(int(_aabb.max.y / cellSize.y), 0, m_gridSplit.y - 1);
+
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            if (m_dirtyCells[y * m_gridSplit.x + x]) { return true; }
+        }
+    }
+    return false;
+}
+
+void LabelManager::markRemovedLabels() {
+
+    size_t present = 0;
+    for (auto& entry : m_labels) {
+        if (entry.label->placement().anchorIndex >= 0 &&
+            m_placedLabels.find(entry.label) != m_placedLabels.end()) {
+            present++;
+        }
+    }
+    if (present == m_placedLabels.size()) { return; }
+
+    std::unordered_set<const Label*> labels;
+    for (auto& entry : m_labels) {
+        if (entry.label->placement().anchorIndex >= 0) { labels.insert(entry.label); }
+    }
+
+    // Labels that are gone, or replaced by a new label at the same address
+    for (auto& placed : m_placedLabels) {
+        if (labels.find(placed.first) == labels.end()) {
+            markDirtyCells(placed.second);
+        }
+    }
+}
+
+void LabelManager::handleOcclusions(const ViewState& _viewState, bool _reusePlacements) {
 
     m_isect2d.clear();
     m_repeatGroups.clear();
 
+    std::fill(m_dirtyCells.begin(), m_dirtyCells.end(), false);
+    markRemovedLabels();
+
+    std::unordered_map<const Label*, AABB> placedLabels;
+    float threshold2 = occlusion_move_threshold * occlusion_move_threshold;
+
+    auto moved = [&](const AABB& _a, const AABB& _b) {
+        return glm::distance2(_a.min, _b.min) >= threshold2 ||
+            glm::distance2(_a.max, _b.max) >= threshold2;
+    };
+
+    // The label does not take space anymore
+    auto unplace = [&](Label* l) {
+        auto it = m_placedLabels.find(l);
+        if (it != m_placedLabels.end()) { markDirtyCells(it->second); }
+        l->placement().anchorIndex = -1;
+    };
+
+    // Labels of the same tile are resolved by their placement zoom in views without
+    // rotation and tilt, see LabelCollider
+    bool usePlacementZoom = m_placementHierarchy &&
+        _viewState.roll == 0.f && _viewState.pitch == 0.f;
+
     using iterator = decltype(m_labels)::const_iterator;
 
     // Find the label to which the obb belongs
@@ -350,6 +571,7 @@ void LabelManager::handleOcclusions(const ViewState& _viewState) {
         if (l->isChild()) {
             if (l->relative()->isOccluded()) {
                 l->occlude();
+                unplace(l);
                 continue;
             }
         }
@@ -363,48 +585,97 @@ void LabelManager::handleOcclusions(const ViewState& _viewState) {
                 if (l->relative() && !l->options().optional) {
                     l->relative()->occlude();
                 }
+                unplace(l);
                 continue;
             }
         }
 
+        bool inHierarchy = usePlacementZoom && entry.tile && l->placementZoom() >= 0.f;
+
+        if (inHierarchy && _viewState.zoom < l->placementZoom()) {
+            l->occlude();
+            unplace(l);
+            continue;
+        }
+
+        auto& placement = l->placement();
+
+        // Reuse the last result when the label stayed in place and nothing changed around it
+        bool reuse = false;
+        if (_reusePlacements && placement.anchorIndex == l->anchorIndex()) {
+            auto extent = obbsExtent(obbs);
+            reuse = !moved(extent, placement.extent) && !hasDirtyCells(extent);
+        }
+
         int anchorIndex = l->anchorIndex();
 
-        // For each anchor
-        do {
-            if (l->isOccluded()) {
-                // Update OBB for anchor fallback
-                obbs.clear();
+        if (reuse) {
+            l->occlude(placement.occluded);
 
-                l->obbs(transform, obbs);
+        } else {
+            // For each anchor
+            do {
+                if (l->isOccluded()) {
+                    // Update OBB for anchor fallback
+                    obbs.clear();
+
+                    l->obbs(transform, obbs);
+
+                    if (anchorIndex == l->anchorIndex()) {
+                        // Reached first anchor again
+                        break;
+                    }
+                }
 
-                if (anchorIndex == l->anchorIndex()) {
-                    // Reached first anchor again
-                    break;
+                l->occlude(false);
+
+                // Occlude label when its obbs intersect with a previous label.
+                for (auto& obb : obbs) {
+                    m_isect2d.intersect(obb.getExtent(), [&](auto& a, auto& b) {
+                            size_t other = reinterpret_cast<size_t>(b.m_userData);
+
+                            // Both labels are placed above their placement zoom
+                            if (inHierarchy) {
+                                auto& otherEntry = m_labels[m_obbLabels[other]];
+                                if (otherEntry.tile == entry.tile &&
+                                    otherEntry.label->placementZoom() >= 0.f) {
+                                    return true;
+                                }
+                            }
+
+                            if (!intersect(obb, m_obbs[other])) {
+                                return true;
+                            }
+                            // Ignore intersection with relative label
+                            if (l->relative() && l->relative() == findLabel(std::begin(m_labels), it, other)) {
+                                return true;
+                            }
+                            l->occlude();
+                            return false;
+
+                        }, false);
+
+                    if (l->isOccluded()) { break; }
                 }
-            }
+            } while (l->isOccluded() && l->nextAnchor());
+        }
 
-            l->occlude(false);
+        auto extent = obbsExtent(obbs);
 
-            // Occlude label when its obbs intersect with a previous label.
-            for (auto& obb : obbs) {
-                m_isect2d.intersect(obb.getExtent(), [&](auto& a, auto& b) {
-                        size_t other = reinterpret_cast<size_t>(b.m_userData);
-
-                        if (!intersect(obb, m_obbs[other])) {
-                            return true;
-                        }
-                        // Ignore intersection with relative label
-                        if (l->relative() && l->relative() == findLabel(std::begin(m_labels), it, other)) {
-                            return true;
-                        }
-                        l->occlude();
-                        return false;
-
-                    }, false);
-
-                if (l->isOccluded()) { break; }
+        if (!reuse) {
+            placement = { extent, l->anchorIndex(), l->isOccluded() };
+
+            // Labels after this one need to be tested against its new placement
+            auto placed = m_placedLabels.find(l);
+            bool wasPlaced = placed != m_placedLabels.end();
+
+            if (wasPlaced && (l->isOccluded() || moved(extent, placed->second))) {
+                markDirtyCells(placed->second);
             }
-        } while (l->isOccluded() && l->nextAnchor());
+            if (!l->isOccluded() && (!wasPlaced || moved(extent, placed->second))) {
+                markDirtyCells(extent);
+            }
+        }
 
         // At this point, the label has a relative that is visible,
         // if it is not an optional label, turn the relative to occluded
@@ -413,34 +684,31 @@ void LabelManager::handleOcclusions(const ViewState& _viewState) {
                 l->relative()->occlude();
             }
         } else {
+            placedLabels.emplace(l, extent);
+
             // Insert into ISect2D grid
             int obbPos = entry.obbsRange.start;
+            if (m_obbLabels.size() < m_obbs.size()) { m_obbLabels.resize(m_obbs.size()); }
             for (auto& obb : obbs) {
+                m_obbLabels[obbPos] = it - m_labels.begin();
                 auto aabb = obb.getExtent();
                 aabb.m_userData = reinterpret_cast<void*>(obbPos++);
                 m_isect2d.insert(aabb);
             }
 
             if (l->options().repeatDistance > 0.f) {
-                m_repeatGroups[l->options().repeatGroup].push_back(l);
+                m_repeatGroups.insert(l->options().repeatGroup, l->screenCenter(),
+                                      l->options().repeatDistance);
             }
         }
     }
+
+    m_placedLabels = std::move(placedLabels);
 }
 
 bool LabelManager::withinRepeatDistance(Label *_label) {
-    float threshold2 = pow(_label->options().repeatDistance, 2);
-
-    auto it = m_repeatGroups.find(_label->options().repeatGroup);
-    if (it != m_repeatGroups.end()) {
-        for (auto* ll : it->second) {
-            float d2 = glm::distance2(_label->screenCenter(), ll->screenCenter());
-            if (d2 < threshold2) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return m_repeatGroups.within(_label->options().repeatGroup, _label->screenCenter(),
+                                 _label->options().repeatDistance);
 }
 
 void LabelManager::updateLabelSet(const ViewState& _viewState, float _dt, const Scene& _scene,
@@ -456,17 +724,28 @@ void LabelManager::updateLabelSet(const ViewState& _viewState, float _dt, const
 
     std::sort(m_labels.begin(), m_labels.end(), LabelManager::priorityComparator);
 
+    bool reusePlacements = m_incrementalOcclusion;
+
     /// Mark labels to skip transitions
 
     if (int(m_lastZoom) != int(_viewState.zoom)) {
         skipTransitions(_scene, _tiles, _tileManager, _viewState.zoom);
         m_lastZoom = _viewState.zoom;
+        reusePlacements = false;
     }
 
-    m_isect2d.resize({_viewState.viewportSize.x / 256, _viewState.viewportSize.y / 256},
-                     {_viewState.viewportSize.x, _viewState.viewportSize.y});
+    if (m_dirtyCells.empty() || m_viewportSize != _viewState.viewportSize) {
+        m_viewportSize = _viewState.viewportSize;
+
+        m_isect2d.resize({_viewState.viewportSize.x / 256, _viewState.viewportSize.y / 256},
+                         {_viewState.viewportSize.x, _viewState.viewportSize.y});
+
+        m_gridSplit = glm::max(glm::ivec2(m_viewportSize / 256.f), glm::ivec2(1));
+        m_dirtyCells.assign(m_gridSplit.x * m_gridSplit.y, false);
+        reusePlacements = false;
+    }
 
-    handleOcclusions(_viewState);
+    handleOcclusions(_viewState, reusePlacements);
 
     // Update label state
     for (auto& entry : m_labels) {
@@ -2,13 +2,16 @@
 
 #include "data/properties.h"
 #include "labels/label.h"
+#include "labels/repeatGroupIndex.h"
 #include "labels/screenTransform.h"
 #include "labels/spriteLabel.h"
 #include "tile/tileID.h"
+#include "util/asyncWorker.h"
 
 #include "glm_vec.h" // for isect2d.h
 #include "isect2d.h"
 
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -29,7 +32,10 @@ class TileManager;
 class LabelManager {
 
 public:
-    LabelManager();
+    /* _numWorkers: number of threads that compute the screen transforms of the labels
+     * of visible tiles in parallel. With 0 they are computed on the calling thread.
+     */
+    explicit LabelManager(uint32_t _numWorkers = 0);
 
     virtual ~LabelManager();
 
@@ -53,6 +59,20 @@ public:
 
     std::pair<Label*, const Tile*> getLabel(uint32_t _selectionColor) const;
 
+    /* When enabled, labels that moved less than occlusion_move_threshold since their
+     * last occlusion test keep its result, unless a label placed or removed before them
+     * in this update touches the grid cells they cover.
+     */
+    void setIncrementalOcclusion(bool _enabled) { m_incrementalOcclusion = _enabled; }
+
+    static const float occlusion_move_threshold;
+
+    /* When enabled, labels of the same tile do not collide above the placement zoom
+     * computed for them by LabelCollider, and labels are hidden below it, as long as
+     * the view is not rotated or tilted.
+     */
+    void setPlacementHierarchy(bool _enabled) { m_placementHierarchy = _enabled; }
+
 protected:
 
     using AABB = isect2d::AABB<glm::vec2>;
@@ -65,7 +85,14 @@ protected:
 
     void skipTransitions(const std::vector<const Style*>& _styles, Tile& _tile, Tile& _proxy) const;
 
-    void handleOcclusions(const ViewState& _viewState);
+    void handleOcclusions(const ViewState& _viewState, bool _reusePlacements);
+
+    // Mark the extents of labels that were placed in the last update but are gone
+    void markRemovedLabels();
+
+    void markDirtyCells(const AABB& _aabb);
+
+    bool hasDirtyCells(const AABB& _aabb) const;
 
     bool withinRepeatDistance(Label *_label);
 
@@ -73,6 +100,18 @@ protected:
                             const Tile* _tile, const Marker *_marker, const glm::mat4& _mvp,
                             float _dt, bool _drawAll, bool _onlyRender, bool _isProxy);
 
+    // Collect a label whose screen transform was updated into _transformRange of m_transforms
+    void processLabel(const ViewState& _viewState, Label* _label, Style* _style,
+                      const Tile* _tile, const Marker* _marker, Range _transformRange,
+                      float _dt, bool _onlyRender, bool _isProxy);
+
+    // Update the screen transforms of the labels of each tile into m_tileTransforms,
+    // using the worker threads
+    void updateTileTransforms(const ViewState& _viewState,
+                              const std::vector<std::unique_ptr<Style>>& _styles,
+                              const std::vector<std::shared_ptr<Tile>>& _tiles,
+                              bool _drawAll, bool _onlyRender);
+
     bool m_needUpdate;
 
     isect2d::ISect2D<glm::vec2> m_isect2d;
@@ -110,9 +149,49 @@ protected:
     std::vector<LabelEntry> m_labels;
     std::vector<LabelEntry> m_selectionLabels;
 
-    std::unordered_map<size_t, std::vector<Label*>> m_repeatGroups;
+    RepeatGroupIndex m_repeatGroups;
 
     float m_lastZoom;
+
+    bool m_incrementalOcclusion = true;
+
+    bool m_placementHierarchy = true;
+
+    // Index in m_labels of the label of each OBB inserted into m_isect2d
+    std::vector<size_t> m_obbLabels;
+
+    // Viewport and split of m_isect2d, which is only resized when the viewport changes
+    glm::vec2 m_viewportSize{0.f};
+    glm::ivec2 m_gridSplit{1};
+
+    // Grid cells touched by labels whose placement changed in this update
+    std::vector<bool> m_dirtyCells;
+
+    // Labels placed in the last update and their current extent
+    std::unordered_map<const Label*, AABB> m_placedLabels;
+
+    struct TileTransforms {
+        struct Entry {
+            Label* label;
+            Style* style;
+            // Range in transforms
+            Range transformRange;
+        };
+        ScreenTransform::Buffer transforms;
+        std::vector<Entry> labels;
+        // Result of LabelSet::cullLabels for the current LabelSet
+        std::vector<uint8_t> culled;
+    };
+
+    // Labels with valid screen transforms per visible tile, kept to reuse their buffers
+    std::vector<TileTransforms> m_tileTransforms;
+
+    // Result of LabelSet::cullLabels in processLabelUpdate
+    std::vector<uint8_t> m_culledLabels;
+
+    std::vector<std::unique_ptr<AsyncWorker>> m_workers;
+    std::mutex m_workerMutex;
+    std::condition_variable m_workerCondition;
 };
 
 }
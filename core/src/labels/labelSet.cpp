@@ -18,6 +18,82 @@ void LabelSet::setLabels(std::vector<std::unique_ptr<Label>>& _labels) {
                     std::move_iterator<iter_t>(_labels.end()));
 
     _labels.clear();
+
+    updatePointAnchors();
+}
+
+void LabelSet::updatePointAnchors() {
+    auto& anchors = m_pointAnchors;
+
+    anchors = {};
+
+    glm::vec2 position;
+    Label::AABB extent;
+
+    for (size_t i = 0; i < m_labels.size(); i++) {
+        if (!m_labels[i]->pointExtent(position, extent)) { continue; }
+
+        anchors.label.push_back(i);
+        anchors.x.push_back(position.x);
+        anchors.y.push_back(position.y);
+        anchors.minX.push_back(extent.min.x);
+        anchors.minY.push_back(extent.min.y);
+        anchors.maxX.push_back(extent.max.x);
+        anchors.maxY.push_back(extent.max.y);
+    }
+}
+
+void LabelSet::cullLabels(const glm::mat4& _mvp, glm::vec2 _viewportSize, float _border,
+                          std::vector<uint8_t>& _culled) const {
+
+    const auto& anchors = m_pointAnchors;
+    size_t count = anchors.label.size();
+    size_t numLabels = m_labels.size();
+
+    // The results per anchor are written behind the results per label, so that
+    // the buffer of _culled is reused across calls.
+    _culled.assign(numLabels + count, 0);
+
+    // Keep a pixel of slack so that rounding differences to Label::update only
+    // ever let labels pass to the exact test.
+    float border = _border + 1.f;
+    float left = -border, right = _viewportSize.x + border;
+    float top = -border, bottom = _viewportSize.y + border;
+    glm::vec2 halfScreen = _viewportSize * 0.5f;
+
+    const float* x = anchors.x.data();
+    const float* y = anchors.y.data();
+    const float* minX = anchors.minX.data();
+    const float* minY = anchors.minY.data();
+    const float* maxX = anchors.maxX.data();
+    const float* maxY = anchors.maxY.data();
+
+    uint8_t* out = _culled.data() + numLabels;
+
+    for (size_t i = 0; i < count; i++) {
+        // Clip space of (x, y, 0, 1)
+        float cx = _mvp[0][0] * x[i] + _mvp[1][0] * y[i] + _mvp[3][0];
+        float cy = _mvp[0][1] * x[i] + _mvp[1][1] * y[i] + _mvp[3][1];
+        float cw = _mvp[0][3] * x[i] + _mvp[1][3] * y[i] + _mvp[3][3];
+
+        // Labels at w == 0 are left to the exact test
+        float invW = cw > 0.f ? 1.f / cw : 0.f;
+
+        float sx = (1.f + cx * invW) * halfScreen.x;
+        float sy = (1.f - cy * invW) * halfScreen.y;
+
+        bool outside = (sx + maxX[i] < left) | (sx + minX[i] > right) |
+                       (sy + maxY[i] < top) | (sy + minY[i] > bottom);
+
+        out[i] = (cw < 0.f) | ((cw > 0.f) & outside);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (anchors.label[i] < numLabels) {
+            _culled[anchors.label[i]] = out[i];
+        }
+    }
+    _culled.resize(numLabels);
 }
 
 }
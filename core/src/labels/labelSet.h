@@ -24,8 +24,27 @@ public:
 
     void reset();
 
+    /* Sets _culled[i] to 1 for labels placed at a single point whose extent lies outside
+     * of the viewport extended by _border or whose position is behind the camera, i.e.
+     * labels for which Label::update would fail. Other labels are set to 0.
+     */
+    void cullLabels(const glm::mat4& _mvp, glm::vec2 _viewportSize, float _border,
+                    std::vector<uint8_t>& _culled) const;
+
 protected:
+
+    // Collect the positions and extents of point labels, to be called when m_labels changed
+    void updatePointAnchors();
+
     std::vector<std::unique_ptr<Label>> m_labels;
+
+    // Point labels as structure of arrays, so that cullLabels projects them in a
+    // loop that the compiler can vectorize
+    struct PointAnchors {
+        std::vector<uint32_t> label;
+        std::vector<float> x, y;
+        std::vector<float> minX, minY, maxX, maxY;
+    } m_pointAnchors;
 };
 
 }
@@ -0,0 +1,107 @@
+#include "labels/repeatGroupIndex.h"
+
+#include "glm/common.hpp"
+#include "glm/gtx/norm.hpp"
+
+namespace Tangram {
+
+static size_t cellSlot(uint64_t _key, size_t _mask) {
+    // Fibonacci hashing, as keys of neighbouring cells only differ in few bits
+    return size_t((_key * 11400714819323198485ull) >> 32) & _mask;
+}
+
+RepeatGroupIndex::Cell& RepeatGroupIndex::Group::cell(uint64_t _key) {
+    size_t mask = cells.size() - 1;
+    size_t slot = cellSlot(_key, mask);
+    while (cells[slot].head >= 0 && cells[slot].key != _key) {
+        slot = (slot + 1) & mask;
+    }
+    return cells[slot];
+}
+
+int32_t RepeatGroupIndex::Group::head(uint64_t _key) const {
+    size_t mask = cells.size() - 1;
+    size_t slot = cellSlot(_key, mask);
+    while (cells[slot].head >= 0) {
+        if (cells[slot].key == _key) { return cells[slot].head; }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+void RepeatGroupIndex::Group::addToGrid(int32_t _entry) {
+    auto& entry = entries[_entry];
+    uint64_t key = cellKey(glm::floor(entry.position / cellSize));
+
+    auto& c = cell(key);
+    if (c.head < 0) {
+        c.key = key;
+        numCells++;
+    }
+    entry.next = c.head;
+    c.head = _entry;
+}
+
+void RepeatGroupIndex::clear() {
+    m_groups.clear();
+}
+
+void RepeatGroupIndex::insert(size_t _group, glm::vec2 _position, float _repeatDistance) {
+
+    auto it = m_groups.find(_group);
+    if (it == m_groups.end()) {
+        it = m_groups.emplace(_group, Group{}).first;
+        it->second.cellSize = std::max(_repeatDistance, 1.f);
+    }
+    auto& group = it->second;
+
+    group.entries.push_back({ _position, -1 });
+    if (group.entries.size() <= linear_group_size) { return; }
+
+    // Keep the table at most half full
+    if (group.cells.empty() || (group.numCells + 1) * 2 > group.cells.size()) {
+        group.cells.assign(std::max(group.cells.size() * 2, linear_group_size * 4), Cell{ 0, -1 });
+        group.numCells = 0;
+        for (size_t i = 0; i < group.entries.size(); i++) {
+            group.addToGrid(i);
+        }
+    } else {
+        group.addToGrid(group.entries.size() - 1);
+    }
+}
+
+bool RepeatGroupIndex::within(size_t _group, glm::vec2 _position, float _distance) const {
+
+    auto it = m_groups.find(_group);
+    if (it == m_groups.end()) { return false; }
+
+    const auto& group = it->second;
+    float threshold2 = _distance * _distance;
+
+    glm::ivec2 min = glm::floor((_position - _distance) / group.cellSize);
+    glm::ivec2 max = glm::floor((_position + _distance) / group.cellSize);
+
+    // Check all entries when the group is small or the distance spans more cells than
+    // there are entries
+    if (group.cells.empty() ||
+        int64_t(max.x - min.x + 1) * (max.y - min.y + 1) > int64_t(group.entries.size())) {
+
+        for (auto& entry : group.entries) {
+            if (glm::distance2(_position, entry.position) < threshold2) { return true; }
+        }
+        return false;
+    }
+
+    for (int32_t y = min.y; y <= max.y; y++) {
+        for (int32_t x = min.x; x <= max.x; x++) {
+            for (int32_t i = group.head(cellKey({x, y})); i >= 0; i = group.entries[i].next) {
+                if (glm::distance2(_position, group.entries[i].position) < threshold2) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "glm/vec2.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/* RepeatGroupIndex - Screen positions of the placed labels of each repeat group
+ *
+ * Groups with more than linear_group_size labels are bucketed into a grid with
+ * cells the size of the repeat distance of the first label of the group, so that
+ * a repeat distance check only visits the labels in the cells around the position.
+ */
+class RepeatGroupIndex {
+
+public:
+
+    static const size_t linear_group_size = 16;
+
+    void clear();
+
+    void insert(size_t _group, glm::vec2 _position, float _repeatDistance);
+
+    // Whether a label of _group lies closer than _distance to _position
+    bool within(size_t _group, glm::vec2 _position, float _distance) const;
+
+private:
+
+    struct Entry {
+        glm::vec2 position;
+        // Next entry in the same cell, or -1
+        int32_t next;
+    };
+
+    struct Cell {
+        uint64_t key;
+        // First entry of the cell, or -1 for empty slots
+        int32_t head;
+    };
+
+    struct Group {
+        float cellSize;
+        std::vector<Entry> entries;
+        // Open addressing hash table of the occupied cells, empty while the
+        // group is checked linearly
+        std::vector<Cell> cells;
+        size_t numCells = 0;
+
+        Cell& cell(uint64_t _key);
+        int32_t head(uint64_t _key) const;
+        void addToGrid(int32_t _entry);
+    };
+
+    static uint64_t cellKey(glm::ivec2 _cell) {
+        return (uint64_t(uint32_t(_cell.x)) << 32) | uint32_t(_cell.y);
+    }
+
+    std::unordered_map<size_t, Group> m_groups;
+};
+
+}
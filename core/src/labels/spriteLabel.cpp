@@ -73,6 +73,21 @@ void SpriteLabel::applyAnchor(LabelProperty::Anchor _anchor) {
     m_anchor = LabelProperty::anchorDirection(_anchor) * m_dim * 0.5f;
 }
 
+bool SpriteLabel::pointExtent(glm::vec2& _position, AABB& _extent) {
+
+    if (m_options.flat) { return false; }
+
+    // Sprites grow by up to extrudeScale until the next zoom level, see obbs()
+    float extrude = std::max(m_vertexAttrib.extrudeScale, 0.f) * 0.5f;
+
+    _position = glm::vec2(m_coordinates);
+    _extent = m_options.anchors.extents(m_dim);
+    _extent.min += m_options.offset - extrude;
+    _extent.max += m_options.offset + extrude;
+
+    return true;
+}
+
 bool SpriteLabel::updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
                                         const AABB* _bounds, ScreenTransform& _transform) {
 
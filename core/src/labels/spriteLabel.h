@@ -48,6 +48,8 @@ public:
     bool updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
                                const AABB* _bounds, ScreenTransform& _transform) override;
 
+    bool pointExtent(glm::vec2& _position, AABB& _extent) override;
+
     void obbs(ScreenTransform& _transform, OBBBuffer& _obbs) override;
 
     void addVerticesToMesh(ScreenTransform& _transform, const glm::vec2& _screenSize) override;
@@ -68,6 +68,18 @@ void TextLabel::applyAnchor(Anchor _anchor) {
     m_anchor = LabelProperty::anchorDirection(_anchor) * offset * 0.5f;
 }
 
+bool TextLabel::pointExtent(glm::vec2& _position, AABB& _extent) {
+
+    if (m_type != Type::point && m_type != Type::debug) { return false; }
+
+    _position = m_coordinates[0];
+    _extent = m_options.anchors.extents(m_dim);
+    _extent.min += m_options.offset;
+    _extent.max += m_options.offset;
+
+    return true;
+}
+
 bool TextLabel::updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
                                       const AABB* _bounds, ScreenTransform& _transform) {
 
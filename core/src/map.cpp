@@ -2,11 +2,15 @@
 
 #include "debug/textDisplay.h"
 #include "debug/frameInfo.h"
+#include "data/clientDataSource.h"
+#include "data/regionDownload.h"
+#include "data/tileDataCache.h"
 #include "gl.h"
 #include "gl/glError.h"
 #include "gl/framebuffer.h"
 #include "gl/hardware.h"
 #include "gl/primitives.h"
+#include "gl/programBinaryCache.h"
 #include "gl/renderState.h"
 #include "gl/shaderProgram.h"
 #include "labels/labelManager.h"
@@ -19,6 +23,7 @@
 #include "style/material.h"
 #include "style/style.h"
 #include "text/fontContext.h"
+#include "tile/retainedMeshes.h"
 #include "tile/tile.h"
 #include "tile/tileCache.h"
 #include "util/asyncWorker.h"
@@ -45,6 +50,12 @@ struct CameraEase {
 
 using CameraAnimator = std::function<uint32_t(float dt)>;
 
+// Camera position (x and y in projected meters, zoom) of an animation at time t in [0, 1]
+using CameraPath = std::function<glm::dvec3(float t)>;
+
+// Number of positions along the predicted camera path for which tiles are prefetched
+static const int prefetch_path_samples = 4;
+
 struct ClientTileSource {
     std::shared_ptr<TileSource> tileSource;
     bool added = false;
@@ -58,13 +69,17 @@ public:
     explicit Impl(Platform& _platform) :
         platform(_platform),
         inputHandler(view),
-        scene(std::make_unique<Scene>(_platform)) {}
+        scene(std::make_unique<Scene>(_platform)) {
+        renderState.programBinaryCache = std::make_unique<ProgramBinaryCache>(_platform);
+    }
 
     void setPixelScale(float _pixelsPerPoint);
     SceneID loadScene(SceneOptions&& _sceneOptions);
     SceneID loadSceneAsync(SceneOptions&& _sceneOptions);
+    std::shared_ptr<RetainedMeshes> retainMeshes(const SceneOptions& _sceneOptions);
     void syncClientTileSources(bool _firstUpdate);
     bool updateCameraEase(float _dt);
+    void updatePrefetchPath();
 
     Platform& platform;
     RenderState renderState;
@@ -76,8 +91,14 @@ public:
 
     std::unique_ptr<Ease> ease;
 
+    // Path of the current camera ease, used to predict the tiles it will show
+    CameraPath easePath;
+
     std::unique_ptr<Scene> scene;
 
+    // Parsed TileData shared by subsequently loaded scenes
+    std::shared_ptr<TileDataCache> tileDataCache = std::make_shared<TileDataCache>();
+
     std::unique_ptr<FrameBuffer> selectionBuffer = std::make_unique<FrameBuffer>(0, 0);
 
     bool cacheGlState = false;
@@ -93,6 +114,15 @@ public:
 
     std::map<int32_t, ClientTileSource> clientTileSources;
 
+    // Tile sources of the ready scene, copied for downloadRegion(), which may be
+    // called while the scene is replaced or still loading its sources
+    std::mutex sceneSourcesMutex;
+    std::vector<std::shared_ptr<TileSource>> sceneSources;
+
+    std::mutex regionDownloadMutex;
+    std::map<RegionDownloadID, std::shared_ptr<RegionDownload>> regionDownloads;
+    RegionDownloadID lastRegionDownloadID = 0;
+
     // TODO MapOption
     Color background{0xffffffff};
 };
@@ -111,6 +141,13 @@ Map::~Map() {
     // and discard incoming UrlRequest directly.
     //
     // In any case after shutdown Platform may not call back into Map!
+    std::map<RegionDownloadID, std::shared_ptr<RegionDownload>> regionDownloads;
+    {
+        std::lock_guard<std::mutex> lock(impl->regionDownloadMutex);
+        regionDownloads.swap(impl->regionDownloads);
+    }
+    for (auto& download : regionDownloads) { download.second->cancel(); }
+
     platform->shutdown();
 
     // Impl will be automatically destroyed by unique_ptr, but threads owned by AsyncWorker and
@@ -135,10 +172,30 @@ SceneID Map::loadScene(SceneOptions&& _sceneOptions, bool _async) {
     }
 }
 
+std::shared_ptr<RetainedMeshes> Map::Impl::retainMeshes(const SceneOptions& _sceneOptions) {
+
+    if (!_sceneOptions.reuseTileMeshes) { return nullptr; }
+
+    auto meshes = std::make_shared<RetainedMeshes>();
+    if (scene && scene->isReady()) {
+        meshes->add(*scene);
+    }
+    return meshes;
+}
+
 SceneID Map::Impl::loadScene(SceneOptions&& _sceneOptions) {
 
+    auto retainedMeshes = retainMeshes(_sceneOptions);
+
+    {
+        std::lock_guard<std::mutex> lock(sceneSourcesMutex);
+        sceneSources.clear();
+    }
+
     // NB: This also disposes old scene which might be blocking
     scene = std::make_unique<Scene>(platform, std::move(_sceneOptions));
+    scene->setTileDataCache(tileDataCache);
+    scene->setRetainedMeshes(retainedMeshes);
 
     scene->load();
 
@@ -151,6 +208,13 @@ SceneID Map::Impl::loadScene(SceneOptions&& _sceneOptions) {
 
 SceneID Map::Impl::loadSceneAsync(SceneOptions&& _sceneOptions) {
 
+    auto retainedMeshes = retainMeshes(_sceneOptions);
+
+    {
+        std::lock_guard<std::mutex> lock(sceneSourcesMutex);
+        sceneSources.clear();
+    }
+
     // Move the previous scene into a shared_ptr so that it can be captured in a std::function
     // (unique_ptr can't be captured because std::function is copyable).
     std::shared_ptr<Scene> oldScene = std::move(scene);
@@ -168,6 +232,8 @@ SceneID Map::Impl::loadSceneAsync(SceneOptions&& _sceneOptions) {
     };
 
     scene = std::make_unique<Scene>(platform, std::move(_sceneOptions), prefetchCallback);
+    scene->setTileDataCache(tileDataCache);
+    scene->setRetainedMeshes(retainedMeshes);
 
     // This async task gets a raw pointer to the new scene and the following task takes ownership of the shared_ptr to
     // the old scene. Tasks in the async queue are executed one at a time in FIFO order, so even if another scene starts
@@ -242,6 +308,13 @@ MapState Map::update(float _dt) {
         bool firstUpdate = !wasReady;
         impl->syncClientTileSources(firstUpdate);
 
+        if (firstUpdate) {
+            std::lock_guard<std::mutex> lock(impl->sceneSourcesMutex);
+            impl->sceneSources = scene.tileSources();
+        }
+
+        impl->updatePrefetchPath();
+
         auto sceneState = scene.update(impl->view, _dt);
 
         if (sceneState.animateLabels || sceneState.animateMarkers) {
@@ -312,7 +385,7 @@ void Map::render() {
 
     if (drawSelectionDebug) {
         impl->selectionBuffer->drawDebug(renderState, viewport);
-        FrameInfo::draw(renderState, view, *scene.tileManager());
+        FrameInfo::draw(renderState, view, scene);
         return;
     }
 
@@ -324,7 +397,7 @@ void Map::render() {
         platform->setContinuousRendering(drawnAnimatedStyle);
     }
 
-    FrameInfo::draw(renderState, view, *scene.tileManager());
+    FrameInfo::draw(renderState, view, scene);
 }
 
 int Map::getViewportHeight() {
@@ -360,6 +433,7 @@ void Map::cancelCameraAnimation() {
     impl->inputHandler.cancelFling();
 
     impl->ease.reset();
+    impl->easePath = nullptr;
 
     if (impl->cameraAnimationListener) {
         impl->cameraAnimationListener(false);
@@ -413,11 +487,18 @@ void Map::setCameraPositionEased(const CameraPosition& _camera, float _duration,
     e.start.tilt = getTilt();
     e.end.tilt = _camera.tilt;
 
+    auto path = [=](float t) {
+        return glm::dvec3(ease(e.start.pos.x, e.end.pos.x, t, _e),
+                          ease(e.start.pos.y, e.end.pos.y, t, _e),
+                          ease(e.start.zoom, e.end.zoom, t, _e));
+    };
+
+    impl->easePath = path;
     impl->ease = std::make_unique<Ease>(_duration,
         [=](float t) {
-            impl->view.setPosition(ease(e.start.pos.x, e.end.pos.x, t, _e),
-                                   ease(e.start.pos.y, e.end.pos.y, t, _e));
-            impl->view.setZoom(ease(e.start.zoom, e.end.zoom, t, _e));
+            glm::dvec3 pos = path(t);
+            impl->view.setPosition(pos.x, pos.y);
+            impl->view.setZoom(pos.z);
 
             impl->view.setRoll(ease(e.start.rotation, e.end.rotation, t, _e));
 
@@ -437,11 +518,32 @@ bool Map::Impl::updateCameraEase(float _dt) {
             cameraAnimationListener(true);
         }
         ease.reset();
+        easePath = nullptr;
         return false;
     }
     return true;
 }
 
+void Map::Impl::updatePrefetchPath() {
+
+    std::vector<glm::dvec3> path;
+    glm::dvec3 flingTarget;
+
+    if (ease && easePath && ease->d > 0.f) {
+        float t = glm::clamp(ease->t / ease->d, 0.f, 1.f);
+        for (int i = 1; i <= prefetch_path_samples; i++) {
+            path.push_back(easePath(t + (1.f - t) * i / prefetch_path_samples));
+        }
+    } else if (inputHandler.getFlingTarget(flingTarget)) {
+        glm::dvec3 start(view.getPosition().x, view.getPosition().y, view.getZoom());
+        for (int i = 1; i <= prefetch_path_samples; i++) {
+            path.push_back(glm::mix(start, flingTarget, double(i) / prefetch_path_samples));
+        }
+    }
+
+    scene->tileManager()->setPrefetchPath(std::move(path));
+}
+
 void Map::updateCameraPosition(const CameraUpdate& _update, float _duration, EaseType _e) {
 
     CameraPosition camera{};
@@ -551,6 +653,15 @@ float Map::getTilt() {
     return impl->view.getPitch();
 }
 
+void Map::setMaxTileScreenSize(float _pixels) {
+    impl->view.setMaxTileScreenSize(_pixels);
+    impl->platform.requestRender();
+}
+
+float Map::getMaxTileScreenSize() const {
+    return impl->view.getMaxTileScreenSize();
+}
+
 void Map::setPadding(const EdgePadding& padding) {
     impl->view.setPadding(padding);
 }
@@ -645,6 +756,7 @@ void Map::flyTo(const CameraPosition& _camera, float _duration, float _speed) {
     cancelCameraAnimation();
 
     impl->ease = std::make_unique<Ease>(duration, cb);
+    impl->easePath = fn;
 
     platform->requestRender();
 }
@@ -700,6 +812,11 @@ void Map::addTileSource(std::shared_ptr<TileSource> _source) {
     auto& tileSources = impl->clientTileSources;
     auto& entry = tileSources[_source->id()];
 
+    if (_source->cacheKey().empty()) {
+        _source->setCacheKey("client:" + std::to_string(_source->id()));
+    }
+    _source->setTileDataCache(impl->tileDataCache);
+
     entry.tileSource = _source;
     entry.added = true;
 }
@@ -731,6 +848,70 @@ bool Map::clearTileSource(TileSource& _source, bool _data, bool _tiles) {
     return false;
 }
 
+RegionDownloadID Map::downloadRegion(const std::string& _sourceName, RegionDownloadOptions _options,
+                                     RegionDownloadCallback _callback) {
+
+    std::shared_ptr<TileSource> source;
+    {
+        std::lock_guard<std::mutex> lock(impl->sceneSourcesMutex);
+        auto it = std::find_if(impl->sceneSources.begin(), impl->sceneSources.end(),
+                               [&](auto& s) { return s->name() == _sourceName; });
+        if (it != impl->sceneSources.end()) { source = *it; }
+    }
+
+    if (!source) {
+        LOGW("Cannot download region of unknown source: %s", _sourceName.c_str());
+        return 0;
+    }
+    // Only sources that load tiles from the network or MBTiles have data to download
+    if (dynamic_cast<ClientDataSource*>(source.get())) {
+        LOGW("Cannot download region of client source: %s", _sourceName.c_str());
+        return 0;
+    }
+
+    uint64_t maxTiles = RegionDownload::maxRegionTiles(_options.polygon, _options.minZoom,
+                                                       std::min(_options.maxZoom, source->maxZoom()));
+    if (maxTiles > _options.maxTiles) {
+        LOGW("Cannot download region of up to %llu tiles, more than the limit of %llu",
+             (unsigned long long)maxTiles, (unsigned long long)_options.maxTiles);
+        return 0;
+    }
+
+    auto download = std::make_shared<RegionDownload>(source, std::move(_options), std::move(_callback));
+
+    std::lock_guard<std::mutex> lock(impl->regionDownloadMutex);
+
+    // Release finished downloads
+    for (auto d = impl->regionDownloads.begin(); d != impl->regionDownloads.end(); ) {
+        if (d->second->progress().finished) {
+            d = impl->regionDownloads.erase(d);
+        } else {
+            ++d;
+        }
+    }
+
+    RegionDownloadID id = ++impl->lastRegionDownloadID;
+    impl->regionDownloads.emplace(id, download);
+
+    download->start();
+
+    return id;
+}
+
+bool Map::cancelRegionDownload(RegionDownloadID _id) {
+    std::shared_ptr<RegionDownload> download;
+    {
+        std::lock_guard<std::mutex> lock(impl->regionDownloadMutex);
+        auto it = impl->regionDownloads.find(_id);
+        if (it == impl->regionDownloads.end()) { return false; }
+
+        download = std::move(it->second);
+        impl->regionDownloads.erase(it);
+    }
+    download->cancel();
+    return true;
+}
+
 void Map::Impl::syncClientTileSources(bool _firstUpdate) {
     std::lock_guard<std::mutex> lock(tileSourceMutex);
 
@@ -894,6 +1075,10 @@ void Map::setupGL() {
     //impl->scene->tileManager()->clearTileSets();
     impl->scene->markerManager()->rebuildAll();
 
+    // Meshes that are only uploaded by a full update, like those of labels, would
+    // keep their buffers of the previous context on an idle map
+    impl->scene->tileManager()->setNeedsUpdate();
+
     if (impl->selectionBuffer->valid()) {
         impl->selectionBuffer = std::make_unique<FrameBuffer>(impl->selectionBuffer->getWidth(),
                                                               impl->selectionBuffer->getHeight());
@@ -922,6 +1107,7 @@ void Map::runAsyncTask(std::function<void()> _task) {
 void Map::onMemoryWarning() {
 
     impl->scene->tileManager()->clearTileSets(true);
+    impl->tileDataCache->clear();
 
     if (impl->scene && impl->scene->fontContext()) {
         impl->scene->fontContext()->releaseFonts();
@@ -55,6 +55,15 @@ std::vector<FontSourceHandle> Platform::systemFontFallbacksHandle() const {
     return {};
 }
 
+std::vector<char> Platform::loadProgramBinary(const std::string& _key) const {
+    // No-op by default
+    return {};
+}
+
+void Platform::storeProgramBinary(const std::string& _key, const std::vector<char>& _binary) {
+    // No-op by default
+}
+
 void Platform::shutdown() {
     if (m_shutdown.exchange(true)) { return; }
 
@@ -78,6 +87,15 @@ void Platform::shutdown() {
 }
 
 UrlRequestHandle Platform::startUrlRequest(Url _url, UrlCallback&& _callback) {
+    return startUrlRequest(std::move(_url), UrlCacheInfo{}, std::move(_callback));
+}
+
+UrlRequestHandle Platform::startUrlRequest(Url _url, const UrlCacheInfo& _cacheInfo, UrlCallback&& _callback) {
+    return startUrlRequest(std::move(_url), _cacheInfo, std::move(_callback), UrlStreamCallback{});
+}
+
+UrlRequestHandle Platform::startUrlRequest(Url _url, const UrlCacheInfo& _cacheInfo, UrlCallback&& _callback,
+                                           UrlStreamCallback&& _stream) {
 
     assert(_callback);
 
@@ -94,12 +112,23 @@ UrlRequestHandle Platform::startUrlRequest(Url _url, UrlCallback&& _callback) {
     UrlRequestEntry* entry = nullptr;
     {
         std::lock_guard<std::mutex> lock(m_callbackMutex);
-        auto it = m_urlCallbacks.emplace(handle, UrlRequestEntry{std::move(_callback), 0, false});
+        std::shared_ptr<UrlStreamCallback> stream;
+        if (_stream) { stream = std::make_shared<UrlStreamCallback>(std::move(_stream)); }
+        auto it = m_urlCallbacks.emplace(handle, UrlRequestEntry{std::move(_callback), 0, false, std::move(stream)});
         entry = &it.first->second;
     }
 
     // Start Platform specific url request
-    if (startUrlRequestImpl(_url, handle, entry->id)) {
+    bool cancelable = false;
+    if (entry->stream) {
+        cancelable = startStreamingUrlRequestImpl(_url, _cacheInfo, handle, entry->id);
+    } else if (_cacheInfo.canRevalidate()) {
+        cancelable = startConditionalUrlRequestImpl(_url, _cacheInfo, handle, entry->id);
+    } else {
+        cancelable = startUrlRequestImpl(_url, handle, entry->id);
+    }
+
+    if (cancelable) {
         entry->cancelable = true;
     }
 
@@ -140,6 +169,20 @@ void Platform::cancelUrlRequest(const UrlRequestHandle _request) {
     }
 }
 
+void Platform::setUrlRequestPriority(const UrlRequestHandle _request, double _priority) {
+    if (_request == 0) { return; }
+
+    UrlRequestId id = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        auto it = m_urlCallbacks.find(_request);
+        if (it == m_urlCallbacks.end() || !it->second.cancelable) { return; }
+        id = it->second.id;
+    }
+
+    setUrlRequestPriorityImpl(id, _priority);
+}
+
 void Platform::onUrlResponse(const UrlRequestHandle _request, UrlResponse&& _response) {
     if (m_shutdown) {
         LOGW("onUrlResponse after shutdown");
@@ -158,4 +201,18 @@ void Platform::onUrlResponse(const UrlRequestHandle _request, UrlResponse&& _res
     if (callback) { callback(std::move(_response)); }
 }
 
+void Platform::onUrlData(const UrlRequestHandle _request, size_t _offset, const char* _data, size_t _size) {
+    if (m_shutdown) { return; }
+
+    std::shared_ptr<UrlStreamCallback> stream;
+    {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        auto it = m_urlCallbacks.find(_request);
+        if (it != m_urlCallbacks.end()) {
+            stream = it->second.stream;
+        }
+    }
+    if (stream) { (*stream)(_offset, _data, _size); }
+}
+
 } // namespace Tangram
@@ -1,6 +1,8 @@
 #include "scene/scene.h"
 
+#include "data/tileDataCache.h"
 #include "data/tileSource.h"
+#include "data/urlRequestCoalescer.h"
 #include "gl/framebuffer.h"
 #include "gl/shaderProgram.h"
 #include "labels/labelManager.h"
@@ -21,6 +23,7 @@
 #include "style/rasterStyle.h"
 #include "style/style.h"
 #include "text/fontContext.h"
+#include "tile/retainedMeshes.h"
 #include "util/base64.h"
 #include "util/util.h"
 #include "log.h"
@@ -125,9 +128,19 @@ bool Scene::load() {
     SceneLoader::applyGlobals(m_config, m_config);
     LOGTO("<<< applyGlobals");
 
-    m_tileSources = SceneLoader::applySources(m_config, m_options, m_platform);
+    // Shares requests of sources loading the same tiles
+    m_requestCoalescer = std::make_shared<UrlRequestCoalescer>(m_platform);
+
+    m_tileSources = SceneLoader::applySources(m_config, m_options, m_platform, m_requestCoalescer);
     LOGTO("<<< applySources");
 
+    if (m_tileDataCache) {
+        m_tileDataCache->setMaxUsage(m_options.retainedTileDataSize);
+        for (auto& source : m_tileSources) {
+            source->setTileDataCache(m_tileDataCache);
+        }
+    }
+
     SceneLoader::applyCameras(m_config, m_camera);
     LOGTO("<<< applyCameras");
 
@@ -141,8 +154,15 @@ bool Scene::load() {
         m_tilePrefetchCallback(this);
     }
 
-    m_fontContext = std::make_unique<FontContext>(m_platform);
+    m_fontContext = std::make_unique<FontContext>(m_platform, m_options.glyphAtlasSize);
     m_fontContext->loadFonts();
+
+    if (!m_options.glyphBundlePath.empty()) {
+        auto glyphBundle = std::make_shared<GlyphBundle>();
+        if (glyphBundle->load(m_options.glyphBundlePath)) {
+            m_fontContext->setGlyphBundle(glyphBundle);
+        }
+    }
     LOGTO("<<< initFonts");
 
     SceneLoader::applyFonts(m_config["fonts"], m_fonts);
@@ -185,6 +205,11 @@ bool Scene::load() {
     m_layers = SceneLoader::applyLayers(m_config["layers"], m_jsFunctions, m_stops, m_names);
     LOGTO("<<< applyLayers");
 
+    if (m_retainedMeshes) {
+        m_styleHashes = SceneLoader::applyStyleDependencies(m_config);
+        LOGTO("<<< applyStyleDependencies");
+    }
+
     for (auto& style : m_styles) { style->build(*this); }
     LOGTO("<<< buildStyles");
 
@@ -196,7 +221,7 @@ bool Scene::load() {
     m_tileWorker->setScene(*this);
 
     m_featureSelection = std::make_unique<FeatureSelection>();
-    m_labelManager = std::make_unique<LabelManager>();
+    m_labelManager = std::make_unique<LabelManager>(m_options.numLabelWorkers);
 
     m_state = State::pending_resources;
 
@@ -505,12 +530,23 @@ Scene::UpdateState Scene::update(const View& _view, float _dt) {
 
     bool markersChanged = m_markerManager->update(_view, _dt);
 
+    if (!markersChanged && !m_labelManager->needUpdate() && !m_tileManager->needsUpdate(_view)) {
+        // Neither the view, the tiles nor any label or marker changed: keep the tiles
+        // and the label meshes of the last update
+        return { false, false, false };
+    }
+
     for (const auto& style : m_styles) {
         style->onBeginUpdate();
     }
 
     m_tileManager->updateTileSets(_view);
 
+    // Meshes of the previous Scene are not needed anymore once the tiles for the view are built
+    if (m_retainedMeshes && !m_tileManager->hasLoadingTiles() && !m_retainedMeshes->empty()) {
+        m_retainedMeshes->clear();
+    }
+
     auto& tiles = m_tileManager->getVisibleTiles();
     auto& markers = m_markerManager->markers();
 
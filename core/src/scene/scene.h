@@ -7,6 +7,7 @@
 #include "text/fontContext.h" // For FontDescription
 #include "tile/tileManager.h"
 #include "util/color.h"
+#include "util/fastmap.h"
 #include "util/url.h"
 #include "util/yamlPath.h"
 #include "view/view.h"
@@ -37,11 +38,14 @@ class Light;
 class MapProjection;
 class MarkerManager;
 class Platform;
+class RetainedMeshes;
 class SceneLayer;
 class SelectionQuery;
 class Style;
 class Texture;
+class TileDataCache;
 class TileSource;
+class UrlRequestCoalescer;
 struct SceneLoader;
 
 struct SceneCamera : public Camera {
@@ -105,7 +109,17 @@ public:
     /// Load the whole Scene
     bool load();
 
+    /// Set the cache for retaining TileData of this Scene's sources.
+    /// Must be called before load().
+    void setTileDataCache(std::shared_ptr<TileDataCache> _cache) { m_tileDataCache = _cache; }
+
+    /// Set meshes of the previous Scene that may be reused for styles that did not change.
+    /// Must be called before load().
+    void setRetainedMeshes(std::shared_ptr<RetainedMeshes> _meshes) { m_retainedMeshes = _meshes; }
+
     auto& tileSources() const { return m_tileSources; }
+    auto& requestCoalescer() const { return m_requestCoalescer; }
+    auto& tileDataCache() const { return m_tileDataCache; }
     auto& featureSelection() const { return m_featureSelection; }
     auto& fontContext() const { return m_fontContext; }
 
@@ -116,6 +130,8 @@ public:
     const auto& lights() const { return m_lights; }
     const auto& options() const { return m_options; }
     const auto& styles() const { return m_styles; }
+    const auto& styleHashes() const { return m_styleHashes; }
+    RetainedMeshes* retainedMeshes() const { return m_retainedMeshes.get(); }
     const auto& textures() const { return m_textures.textures; }
 
     std::shared_ptr<TileSource> getTileSource(int32_t id) const;
@@ -180,6 +196,9 @@ public:
     using Styles = std::vector<std::unique_ptr<Style>>;
     using Layers = std::vector<DataLayer>;
 
+    /// Style name -> hash of the scene config its tile meshes are built from
+    using StyleHashes = fastmap<std::string, size_t>;
+
 protected:
 
     Platform& m_platform;
@@ -213,6 +232,7 @@ protected:
     Layers m_layers;
     TileSources m_tileSources;
     Styles m_styles;
+    StyleHashes m_styleHashes;
 
     Lights m_lights;
     LightShaderBlocks m_lightShaderBlocks;
@@ -247,6 +267,9 @@ protected:
     std::unique_ptr<FeatureSelection> m_featureSelection;
     std::unique_ptr<TileWorker> m_tileWorker;
     std::unique_ptr<TileManager> m_tileManager;
+    std::shared_ptr<TileDataCache> m_tileDataCache;
+    std::shared_ptr<RetainedMeshes> m_retainedMeshes;
+    std::shared_ptr<UrlRequestCoalescer> m_requestCoalescer;
     std::unique_ptr<MarkerManager> m_markerManager;
     std::unique_ptr<LabelManager> m_labelManager;
 
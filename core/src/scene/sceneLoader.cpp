@@ -26,6 +26,7 @@
 #include "scene/styleMixer.h"
 #include "scene/styleParam.h"
 #include "util/floatFormatter.h"
+#include "util/hash.h"
 #include "util/yamlPath.h"
 #include "util/yamlUtil.h"
 
@@ -37,7 +38,9 @@
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <map>
 #include <regex>
+#include <set>
 #include <vector>
 
 using YAML::Node;
@@ -598,7 +601,8 @@ void SceneLoader::loadFontDescription(const Node& _node, const std::string& _fam
 }
 
 Scene::TileSources SceneLoader::applySources(const Node& _config, const SceneOptions& _options,
-                                             Platform& _platform) {
+                                             Platform& _platform,
+                                             std::shared_ptr<UrlRequestCoalescer> _requestCoalescer) {
 
     Scene::TileSources tileSources;
 
@@ -610,7 +614,7 @@ Scene::TileSources SceneLoader::applySources(const Node& _config, const SceneOpt
     for (const auto& source : sources) {
         std::string srcName = source.first.Scalar();
         try {
-            if (auto tileSource = loadSource(source.second, srcName, _options, _platform)) {
+            if (auto tileSource = loadSource(source.second, srcName, _options, _platform, _requestCoalescer)) {
                 tileSources.push_back(std::move(tileSource));
             }
         }
@@ -693,7 +697,8 @@ Scene::TileSources SceneLoader::applySources(const Node& _config, const SceneOpt
 }
 
 std::shared_ptr<TileSource> SceneLoader::loadSource(const Node& _source, const std::string& _name,
-                                                    const SceneOptions& _options, Platform& _platform) {
+                                                    const SceneOptions& _options, Platform& _platform,
+                                                    std::shared_ptr<UrlRequestCoalescer> _requestCoalescer) {
 
     std::string type;
     std::string url;
@@ -819,6 +824,7 @@ std::shared_ptr<TileSource> SceneLoader::loadSource(const Node& _source, const s
         }
 
         auto s = std::make_unique<NetworkDataSource>(_platform, url, urlOptions);
+        s->setRequestCoalescer(_requestCoalescer);
         if (rawSources) {
             rawSources->next = std::move(s);
         } else {
@@ -859,6 +865,17 @@ std::shared_ptr<TileSource> SceneLoader::loadSource(const Node& _source, const s
         }
     }
 
+    // Sources of later scenes with identical configuration can reuse retained TileData.
+    // Client sources keep the key of their instance.
+    if (sourcePtr->cacheKey().empty()) {
+        sourcePtr->setCacheKey(_name + "\n" + Dump(_source));
+    }
+
+    // Sources loading the same tiles share their TileData
+    if (isTiled && !isMBTilesFile && type != "Raster") {
+        sourcePtr->setDataKey(type + "\n" + url + (urlOptions.isTms ? "\ntms" : ""));
+    }
+
     return sourcePtr;
 }
 
@@ -1008,6 +1025,13 @@ void SceneLoader::loadStyleProps(const Node& _styleNode, Style& _style, SceneTex
         }
     }
 
+    if (const Node& compactNode = _styleNode["compact_vertices"]) {
+        bool boolValue;
+        if (YamlUtil::getBool(compactNode, boolValue)) {
+            _style.setCompactVertices(boolValue);
+        }
+    }
+
     if (const Node& dashNode = _styleNode["dash"]) {
         if (auto polylineStyle = dynamic_cast<PolylineStyle*>(&_style)) {
             if (dashNode.IsSequence()) {
@@ -1598,6 +1622,104 @@ SceneLayer SceneLoader::loadSublayer(const Node& _layer, const std::string& _lay
     return { _layerName, std::move(filter), std::move(rules), std::move(sublayers), layerOptions };
 }
 
+// Layer members that select features, as opposed to 'draw' and sublayers
+static bool isLayerOption(const std::string& _key) {
+    return _key == "data" || _key == "filter" || _key == "visible" ||
+        _key == "enabled" || _key == "exclusive" || _key == "priority";
+}
+
+struct DrawGroupDependencies {
+    size_t hash = 0;
+    std::set<std::string> styles;
+};
+
+static void collectStyleDependencies(const Node& _layer, const std::string& _path,
+                                     std::map<std::string, std::string> _groupStyles,
+                                     size_t& _options,
+                                     std::map<std::string, DrawGroupDependencies>& _groups) {
+    if (!_layer.IsMap()) { return; }
+
+    hash_combine(_options, _path);
+
+    for (const auto& member : _layer) {
+        const std::string& key = member.first.Scalar();
+
+        if (isLayerOption(key)) {
+            hash_combine(_options, key);
+            hash_combine(_options, Dump(member.second));
+
+        } else if (key == "draw") {
+            if (!member.second.IsMap()) { continue; }
+
+            for (const auto& group : member.second) {
+                const std::string& name = group.first.Scalar();
+
+                // Draw groups inherit the style of the parent layer's group with the same name
+                auto& style = _groupStyles[name];
+                if (const Node& styleNode = group.second["style"]) {
+                    style = styleNode.Scalar();
+                } else if (style.empty()) {
+                    style = name;
+                }
+
+                auto& dependencies = _groups[name];
+                hash_combine(dependencies.hash, _path);
+                hash_combine(dependencies.hash, Dump(group.second));
+                dependencies.styles.insert(style);
+
+                if (const Node& outline = group.second["outline"]) {
+                    if (const Node& outlineStyle = outline["style"]) {
+                        dependencies.styles.insert(outlineStyle.Scalar());
+                    }
+                }
+            }
+        }
+    }
+
+    for (const auto& member : _layer) {
+        const std::string& key = member.first.Scalar();
+        if (isLayerOption(key) || key == "draw") { continue; }
+
+        collectStyleDependencies(member.second, _path + DELIMITER + key, _groupStyles, _options, _groups);
+    }
+}
+
+Scene::StyleHashes SceneLoader::applyStyleDependencies(const Node& _config) {
+
+    Scene::StyleHashes hashes;
+
+    // Draw rules are only merged within a top-level layer: a change in one of its layers
+    // affects the styles that the draw groups of the same name resolve to in this layer tree.
+    if (const Node& layers = _config["layers"]) {
+        for (const auto& layer : layers) {
+            const std::string& name = layer.first.Scalar();
+
+            size_t options = 0;
+            std::map<std::string, DrawGroupDependencies> groups;
+            collectStyleDependencies(layer.second, name, {}, options, groups);
+
+            for (const auto& group : groups) {
+                size_t groupHash = options;
+                hash_combine(groupHash, group.first);
+                hash_combine(groupHash, group.second.hash);
+
+                for (const auto& style : group.second.styles) {
+                    hash_combine(hashes[style], groupHash);
+                }
+            }
+        }
+    }
+
+    // Style definitions, already mixed with the styles they are based on
+    if (const Node& styles = _config["styles"]) {
+        for (const auto& style : styles) {
+            hash_combine(hashes[style.first.Scalar()], Dump(style.second));
+        }
+    }
+
+    return hashes;
+}
+
 void printFilters(const SceneLayer& layer, int indent){
     LOG("%*s >>> %s\n", indent, "", layer.name().c_str());
     layer.filter().print(indent + 2);
@@ -60,10 +60,12 @@ struct SceneLoader {
     static void loadFontDescription(const Node& font, const std::string& family, SceneFonts& fonts);
 
     /// Sources
-    static Scene::TileSources applySources(const Node& config, const SceneOptions& options, Platform& platform);
+    static Scene::TileSources applySources(const Node& config, const SceneOptions& options, Platform& platform,
+                                           std::shared_ptr<UrlRequestCoalescer> requestCoalescer = nullptr);
 
     static std::shared_ptr<TileSource> loadSource(const Node& source, const std::string& name,
-                                                  const SceneOptions& options, Platform& platform);
+                                                  const SceneOptions& options, Platform& platform,
+                                                  std::shared_ptr<UrlRequestCoalescer> requestCoalescer = nullptr);
 
     /// Styles
     static Scene::Styles applyStyles(const Node& stylesNode, SceneTextures& textures, SceneFunctions& functions,
@@ -93,6 +95,9 @@ struct SceneLoader {
 
     static SceneLayer loadSublayer(const Node& layer, const std::string& name, SceneFunctions& functions,
                                    SceneStops& stops, DrawRuleNames& ruleNames);
+
+    /// Hash the parts of the config that the tile meshes of each style depend on
+    static Scene::StyleHashes applyStyleDependencies(const Node& config);
     /// - Filter
     static Filter generateFilter(SceneFunctions& functions, const Node& filter);
     static Filter generateAnyFilter(SceneFunctions& functions, const Node& filter);
@@ -2,17 +2,17 @@
 
 namespace Tangram {
 
-FeatureSelection::FeatureSelection() :
-    m_entry(0) {
-}
+std::atomic<uint32_t> FeatureSelection::s_entry(0);
+
+FeatureSelection::FeatureSelection() {}
 
 uint32_t FeatureSelection::nextColorIdentifier() {
 
-    uint32_t entry = m_entry++;
+    uint32_t entry = s_entry++;
 
     // skip zero every 2^32 features
     while (entry == 0) {
-        entry = m_entry++;
+        entry = s_entry++;
     }
 
     return entry;
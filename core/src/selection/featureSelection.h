@@ -14,7 +14,9 @@ public:
 
 private:
 
-    std::atomic<uint32_t> m_entry;
+    // Shared by all instances: meshes of a previous Scene may be reused by the next one,
+    // so their selection colors must not be handed out again.
+    static std::atomic<uint32_t> s_entry;
 
 };
 
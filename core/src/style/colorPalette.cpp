@@ -0,0 +1,59 @@
+#include "style/colorPalette.h"
+
+namespace Tangram {
+
+bool ColorPalette::add(GLuint _abgr, GLuint _selection, uint16_t& _index) {
+
+    uint64_t key = (uint64_t(_abgr) << 32) | _selection;
+
+    auto it = m_indices.find(key);
+    if (it != m_indices.end()) {
+        _index = it->second;
+        return true;
+    }
+
+    if (m_colors.size() == maxEntries) { return false; }
+
+    _index = m_colors.size();
+    m_colors.push_back(_abgr);
+    m_selectionColors.push_back(_selection);
+    m_indices.emplace(key, _index);
+
+    return true;
+}
+
+void ColorPalette::clear() {
+    m_colors.clear();
+    m_selectionColors.clear();
+    m_indices.clear();
+}
+
+std::unique_ptr<Texture> ColorPalette::createTexture() const {
+
+    TextureOptions options;
+    options.minFilter = TextureMinFilter::NEAREST;
+    options.magFilter = TextureMagFilter::NEAREST;
+
+    auto texture = std::make_unique<Texture>(options);
+    if (m_colors.empty()) { return texture; }
+
+    int width = std::min<int>(m_colors.size(), rowLength);
+    int rows = (m_colors.size() + width - 1) / width;
+    int height = rows * 2;
+
+    std::vector<GLuint> pixels(width * height, 0);
+
+    for (size_t i = 0; i < m_colors.size(); i++) {
+        size_t x = i % width;
+        size_t y = (i / width) * 2;
+        pixels[y * width + x] = m_colors[i];
+        pixels[(y + 1) * width + x] = m_selectionColors[i];
+    }
+
+    texture->setPixelData(width, height, sizeof(GLuint),
+                          reinterpret_cast<GLubyte*>(pixels.data()),
+                          pixels.size() * sizeof(GLuint));
+    return texture;
+}
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "gl.h"
+#include "gl/mesh.h"
+#include "gl/texture.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/* Colors of a feature as passed to vertex constructors */
+struct VertexColors {
+    GLuint abgr = 0;
+    GLuint selection = 0;
+};
+
+/* ColorPalette - Collects the distinct pairs of color and selection color used
+ * by the features of one mesh, so that vertices can refer to them by a 16 bit index
+ */
+class ColorPalette {
+
+public:
+
+    // Number of palette entries per texture row
+    static constexpr int rowLength = 256;
+
+    static constexpr size_t maxEntries = 65536;
+
+    // Set _index to the palette index of the color pair, adding it when it is not yet
+    // in the palette. Returns false when the palette is full.
+    bool add(GLuint _abgr, GLuint _selection, uint16_t& _index);
+
+    size_t size() const { return m_colors.size(); }
+
+    bool empty() const { return m_colors.empty(); }
+
+    void clear();
+
+    // Create a texture with one texel per entry: colors are stored in even rows
+    // and the corresponding selection colors in the odd row below them.
+    std::unique_ptr<Texture> createTexture() const;
+
+private:
+
+    std::vector<GLuint> m_colors;
+    std::vector<GLuint> m_selectionColors;
+
+    std::unordered_map<uint64_t, uint16_t> m_indices;
+
+};
+
+/* Converts _vertices to compact vertices that refer to their colors in _palette.
+ * Returns false when _palette cannot hold all colors of the vertices.
+ */
+template<class C, class V>
+bool compactVertices(const std::vector<V>& _vertices, ColorPalette& _palette, std::vector<C>& _compact) {
+
+    _compact.reserve(_compact.size() + _vertices.size());
+
+    // Consecutive vertices mostly belong to the same feature
+    const V* last = nullptr;
+    uint16_t index = 0;
+
+    for (const auto& vertex : _vertices) {
+        if (!last || vertex.abgr != last->abgr || vertex.selection != last->selection) {
+            if (!_palette.add(vertex.abgr, vertex.selection, index)) { return false; }
+            last = &vertex;
+        }
+        _compact.emplace_back(vertex, index);
+    }
+    return true;
+}
+
+/* Mesh that carries a color palette texture for its compact vertices */
+template<class T>
+class PaletteMesh : public Mesh<T> {
+public:
+
+    PaletteMesh(std::shared_ptr<VertexLayout> _vertexLayout, GLenum _drawMode,
+                std::unique_ptr<Texture> _palette)
+        : Mesh<T>(_vertexLayout, _drawMode),
+          m_palette(std::move(_palette)) {}
+
+    size_t bufferSize() const override {
+        return Mesh<T>::bufferSize() + m_palette->bufferSize();
+    }
+
+    Texture* palette() const override { return m_palette.get(); }
+
+private:
+
+    std::unique_ptr<Texture> m_palette;
+};
+
+}
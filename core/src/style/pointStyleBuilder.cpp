@@ -30,6 +30,8 @@ void IconMesh::setTextLabels(std::unique_ptr<StyledMesh> _textLabels) {
 
     labels.clear();
 
+    updatePointAnchors();
+
     textLabels = std::move(_textLabels);
 }
 
@@ -1,12 +1,15 @@
 #include "style/polygonStyle.h"
 
+#include "gl/hardware.h"
 #include "gl/mesh.h"
 #include "gl/shaderProgram.h"
+#include "log.h"
 #include "map.h"
 #include "marker/marker.h"
 #include "material.h"
 #include "platform.h"
 #include "scene/drawRule.h"
+#include "style/colorPalette.h"
 #include "tile/tile.h"
 #include "util/builders.h"
 #include "util/color.h"
@@ -29,11 +32,12 @@ namespace Tangram {
 
 struct PolygonVertexNoUVs {
 
-    PolygonVertexNoUVs(glm::vec3 position, uint32_t order, glm::vec3 normal, glm::vec2 uv, GLuint abgr, GLuint selection)
+    PolygonVertexNoUVs(glm::vec3 position, uint32_t order, glm::vec3 normal, glm::vec2 uv,
+                       const VertexColors& colors)
         : pos(glm::i16vec4{ glm::round(position * position_scale), order }),
           norm(normal * normal_scale),
-          abgr(abgr),
-          selection(selection) {}
+          abgr(colors.abgr),
+          selection(colors.selection) {}
 
     glm::i16vec4 pos; // pos.w contains layer (params.order)
     glm::i8vec3 norm;
@@ -44,8 +48,31 @@ struct PolygonVertexNoUVs {
 
 struct PolygonVertex : PolygonVertexNoUVs {
 
-    PolygonVertex(glm::vec3 position, uint32_t order, glm::vec3 normal, glm::vec2 uv, GLuint abgr, GLuint selection)
-        : PolygonVertexNoUVs(position, order, normal, uv, abgr, selection), texcoord(uv * texture_scale) {}
+    PolygonVertex(glm::vec3 position, uint32_t order, glm::vec3 normal, glm::vec2 uv,
+                  const VertexColors& colors)
+        : PolygonVertexNoUVs(position, order, normal, uv, colors), texcoord(uv * texture_scale) {}
+
+    glm::u16vec2 texcoord;
+};
+
+// Colors are replaced by an index into the palette of the mesh and only x and y
+// of the normal are stored, z is never negative: 12 instead of 20 bytes
+struct CompactPolygonVertexNoUVs {
+
+    CompactPolygonVertexNoUVs(const PolygonVertexNoUVs& v, uint16_t paletteIndex)
+        : pos(v.pos),
+          norm(v.norm.x, v.norm.y),
+          palette(paletteIndex) {}
+
+    glm::i16vec4 pos; // pos.w contains layer (params.order)
+    glm::i8vec2 norm;
+    uint16_t palette;
+};
+
+struct CompactPolygonVertex : CompactPolygonVertexNoUVs {
+
+    CompactPolygonVertex(const PolygonVertex& v, uint16_t paletteIndex)
+        : CompactPolygonVertexNoUVs(v, paletteIndex), texcoord(v.texcoord) {}
 
     glm::u16vec2 texcoord;
 };
@@ -58,6 +85,18 @@ PolygonStyle::PolygonStyle(std::string _name, Blending _blendMode, GLenum _drawM
 
 void PolygonStyle::constructVertexLayout() {
 
+    if (m_compactVertices) {
+        std::vector<VertexLayout::VertexAttrib> attribs = {
+            {"a_position", 4, GL_SHORT, false, 0},
+            {"a_normal", 2, GL_BYTE, true, 0},
+            {"a_palette", 1, GL_UNSIGNED_SHORT, false, 0},
+        };
+        if (m_texCoordsGeneration) {
+            attribs.push_back({"a_texcoord", 2, GL_UNSIGNED_SHORT, true, 0});
+        }
+        m_compactVertexLayout = std::make_shared<VertexLayout>(attribs);
+    }
+
     if (m_texCoordsGeneration) {
         m_vertexLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
             {"a_position", 4, GL_SHORT, false, 0},
@@ -86,7 +125,9 @@ void PolygonStyle::constructShaderProgram() {
     }
 }
 
-template <class V>
+// Meshes are built with vertices of type V. When the style uses compact vertices
+// they are converted to C, unless the palette of the mesh overflows.
+template <class V, class C>
 struct PolygonStyleBuilder : public StyleBuilder {
 
 public:
@@ -105,12 +146,20 @@ public:
         m_tileUnitsPerMeter = _tile.getInverseScale();
         m_zoom = _tile.getID().z;
         m_meshData.clear();
+        m_palette.clear();
+        m_builder.tessellationCache = nullptr;
     }
 
     void setup(const Marker& _marker, int zoom) override {
         m_zoom = zoom;
         m_tileUnitsPerMeter = 1.f / _marker.extent();
         m_meshData.clear();
+        m_palette.clear();
+        m_builder.tessellationCache = nullptr;
+    }
+
+    void setTessellationCache(TessellationCache* _cache) override {
+        m_builder.tessellationCache = _cache;
     }
 
     bool addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) override;
@@ -119,6 +168,8 @@ public:
 
     std::unique_ptr<StyledMesh> build() override;
 
+    std::unique_ptr<StyledMesh> buildCompactMesh();
+
     PolygonStyleBuilder(const PolygonStyle& _style) : m_style(_style) {}
 
     Parameters parseRule(const DrawRule& _rule, const Properties& _props);
@@ -133,25 +184,55 @@ private:
 
     MeshData<V> m_meshData;
 
+    ColorPalette m_palette;
+
     float m_tileUnitsPerMeter = 0;
     int m_zoom = 0;
 
 };
 
-template <class V>
-std::unique_ptr<StyledMesh> PolygonStyleBuilder<V>::build() {
+template <class V, class C>
+std::unique_ptr<StyledMesh> PolygonStyleBuilder<V, C>::build() {
     if (m_meshData.vertices.empty()) { return nullptr; }
 
-    auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(),
-                                                      m_style.drawMode());
+    // The palette is sampled in the vertex shader
+    if (m_style.compactVertices() && Hardware::supportsVertexTextureFetch) {
+        if (auto mesh = buildCompactMesh()) { return mesh; }
+    }
+
+    auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(), m_style.drawMode());
     mesh->compile(m_meshData);
     m_meshData.clear();
 
     return std::move(mesh);
 }
 
-template <class V>
-auto PolygonStyleBuilder<V>::parseRule(const DrawRule& _rule, const Properties& _props) -> Parameters {
+template <class V, class C>
+std::unique_ptr<StyledMesh> PolygonStyleBuilder<V, C>::buildCompactMesh() {
+
+    MeshData<C> compactData;
+    bool compacted = compactVertices(m_meshData.vertices, m_palette, compactData.vertices);
+
+    if (!compacted) {
+        LOGN("Style '%s': too many colors for compact vertices", m_style.getName().c_str());
+        m_palette.clear();
+        return nullptr;
+    }
+
+    compactData.indices = std::move(m_meshData.indices);
+    compactData.offsets = std::move(m_meshData.offsets);
+    m_meshData.clear();
+
+    auto mesh = std::make_unique<PaletteMesh<C>>(m_style.compactVertexLayout(), m_style.drawMode(),
+                                                 m_palette.createTexture());
+    mesh->compile(compactData);
+    m_palette.clear();
+
+    return std::move(mesh);
+}
+
+template <class V, class C>
+auto PolygonStyleBuilder<V, C>::parseRule(const DrawRule& _rule, const Properties& _props) -> Parameters {
     Parameters p;
     _rule.get(StyleParamKey::color, p.color);
     float alpha = 1;
@@ -175,17 +256,19 @@ auto PolygonStyleBuilder<V>::parseRule(const DrawRule& _rule, const Properties&
     return p;
 }
 
-template <class V>
-bool PolygonStyleBuilder<V>::addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) {
+template <class V, class C>
+bool PolygonStyleBuilder<V, C>::addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) {
 
     auto p = parseRule(_rule, _props);
 
     m_builder.keepTileEdges = p.keepTileEdges;
 
-    m_builder.addVertex = [this, p](const glm::vec3& coord,
-                                 const glm::vec3& normal,
-                                 const glm::vec2& uv) {
-        m_meshData.vertices.push_back({ coord, p.order, normal, uv, p.color, p.selectionColor });
+    VertexColors colors{ p.color, p.selectionColor };
+
+    m_builder.addVertex = [this, p, colors](const glm::vec3& coord,
+                                         const glm::vec3& normal,
+                                         const glm::vec2& uv) {
+        m_meshData.vertices.push_back({ coord, p.order, normal, uv, colors });
     };
 
     if (p.minHeight != p.height) {
@@ -208,11 +291,11 @@ bool PolygonStyleBuilder<V>::addPolygon(const Polygon& _polygon, const Propertie
 
 std::unique_ptr<StyleBuilder> PolygonStyle::createBuilder() const {
     if (m_texCoordsGeneration) {
-        auto builder = std::make_unique<PolygonStyleBuilder<PolygonVertex>>(*this);
+        auto builder = std::make_unique<PolygonStyleBuilder<PolygonVertex, CompactPolygonVertex>>(*this);
         builder->polygonBuilder().useTexCoords = true;
         return std::move(builder);
     } else {
-        auto builder = std::make_unique<PolygonStyleBuilder<PolygonVertexNoUVs>>(*this);
+        auto builder = std::make_unique<PolygonStyleBuilder<PolygonVertexNoUVs, CompactPolygonVertexNoUVs>>(*this);
         builder->polygonBuilder().useTexCoords = false;
         return std::move(builder);
     }
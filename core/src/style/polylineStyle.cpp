@@ -1,5 +1,6 @@
 #include "style/polylineStyle.h"
 
+#include "gl/hardware.h"
 #include "gl/shaderProgram.h"
 #include "gl/mesh.h"
 #include "gl/texture.h"
@@ -11,6 +12,7 @@
 #include "platform.h"
 #include "scene/stops.h"
 #include "scene/drawRule.h"
+#include "style/colorPalette.h"
 #include "tile/tile.h"
 #include "util/builders.h"
 #include "util/dashArray.h"
@@ -34,17 +36,17 @@ namespace Tangram {
 
 struct PolylineVertexNoUVs {
     PolylineVertexNoUVs(glm::vec2 position, glm::vec2 extrude, glm::vec2 uv,
-                        glm::i16vec2 width, glm::i16vec2 height, GLuint abgr, GLuint selection)
+                        glm::i16vec2 width, glm::i16vec2 height, const VertexColors& colors)
         : pos(glm::i16vec2{ glm::round(position * position_scale)}, height),
           extrude(glm::i16vec2{extrude * extrusion_scale}, width),
-          abgr(abgr),
-          selection(selection) {}
+          abgr(colors.abgr),
+          selection(colors.selection) {}
 
-    PolylineVertexNoUVs(PolylineVertexNoUVs v, short order, glm::i16vec2 width, GLuint abgr, GLuint selection)
+    PolylineVertexNoUVs(PolylineVertexNoUVs v, short order, glm::i16vec2 width, const VertexColors& colors)
         : pos(glm::i16vec4{glm::i16vec3{v.pos}, order}),
           extrude(glm::i16vec4{ v.extrude.x, v.extrude.y, width }),
-          abgr(abgr),
-          selection(selection) {}
+          abgr(colors.abgr),
+          selection(colors.selection) {}
 
     glm::i16vec4 pos;
     glm::i16vec4 extrude;
@@ -54,12 +56,33 @@ struct PolylineVertexNoUVs {
 
 struct PolylineVertex : PolylineVertexNoUVs {
     PolylineVertex(glm::vec2 position, glm::vec2 extrude, glm::vec2 uv,
-                   glm::i16vec2 width, glm::i16vec2 height, GLuint abgr, GLuint selection)
-        : PolylineVertexNoUVs(position, extrude, uv, width, height, abgr, selection),
+                   glm::i16vec2 width, glm::i16vec2 height, const VertexColors& colors)
+        : PolylineVertexNoUVs(position, extrude, uv, width, height, colors),
           texcoord(uv * texture_scale) {}
 
-    PolylineVertex(PolylineVertex v, short order, glm::i16vec2 width, GLuint abgr, GLuint selection)
-        : PolylineVertexNoUVs(v, order, width, abgr, selection),
+    PolylineVertex(PolylineVertex v, short order, glm::i16vec2 width, const VertexColors& colors)
+        : PolylineVertexNoUVs(v, order, width, colors),
+          texcoord(v.texcoord) {}
+
+    glm::u16vec2 texcoord;
+};
+
+// Colors are replaced by an index into the palette of the mesh: 20 instead of 24 bytes
+struct CompactPolylineVertexNoUVs {
+    CompactPolylineVertexNoUVs(const PolylineVertexNoUVs& v, uint16_t paletteIndex)
+        : pos(v.pos),
+          extrude(v.extrude),
+          palette(paletteIndex) {}
+
+    glm::i16vec4 pos;
+    glm::i16vec4 extrude;
+    uint16_t palette;
+    uint16_t padding = 0;
+};
+
+struct CompactPolylineVertex : CompactPolylineVertexNoUVs {
+    CompactPolylineVertex(const PolylineVertex& v, uint16_t paletteIndex)
+        : CompactPolylineVertexNoUVs(v, paletteIndex),
           texcoord(v.texcoord) {}
 
     glm::u16vec2 texcoord;
@@ -74,6 +97,18 @@ PolylineStyle::PolylineStyle(std::string _name, Blending _blendMode, GLenum _dra
 void PolylineStyle::constructVertexLayout() {
 
     // TODO: Ideally this would be in the same location as the struct that it basically describes
+    if (m_compactVertices) {
+        std::vector<VertexLayout::VertexAttrib> attribs = {
+            {"a_position", 4, GL_SHORT, false, 0},
+            {"a_extrude", 4, GL_SHORT, false, 0},
+            {"a_palette", 2, GL_UNSIGNED_SHORT, false, 0}, // The 2nd short is for padding
+        };
+        if (m_texCoordsGeneration) {
+            attribs.push_back({"a_texcoord", 2, GL_UNSIGNED_SHORT, false, 0});
+        }
+        m_compactVertexLayout = std::make_shared<VertexLayout>(attribs);
+    }
+
     if (m_texCoordsGeneration) {
         m_vertexLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
             {"a_position", 4, GL_SHORT, false, 0},
@@ -149,7 +184,9 @@ void PolylineStyle::constructShaderProgram() {
     }
 }
 
-template <class V>
+// Meshes are built with vertices of type V. When the style uses compact vertices
+// they are converted to C, unless the palette of the mesh overflows.
+template <class V, class C>
 struct PolylineStyleBuilder : public StyleBuilder {
 
 public:
@@ -187,6 +224,8 @@ public:
 
     std::unique_ptr<StyledMesh> build() override;
 
+    std::unique_ptr<StyledMesh> buildCompactMesh();
+
     PolylineStyleBuilder(const PolylineStyle& _style)
         : m_style(_style),
           m_meshData(2) {}
@@ -209,14 +248,16 @@ private:
 
     std::vector<MeshData<V>> m_meshData;
 
+    ColorPalette m_palette;
+
     float m_tileUnitsPerMeter = 0;
     float m_tileUnitsPerPixel = 0;
     int m_zoom = 0;
     float m_overzoom2 = 1;
 };
 
-template <class V>
-void PolylineStyleBuilder<V>::setup(const Tile& tile) {
+template <class V, class C>
+void PolylineStyleBuilder<V, C>::setup(const Tile& tile) {
 
     const auto& id = tile.getID();
 
@@ -232,8 +273,8 @@ void PolylineStyleBuilder<V>::setup(const Tile& tile) {
     // prevent loss of precision for small dimensions in packed attributes.
 }
 
-template <class V>
-void PolylineStyleBuilder<V>::setup(const Marker& marker, int zoom) {
+template <class V, class C>
+void PolylineStyleBuilder<V, C>::setup(const Marker& marker, int zoom) {
 
     m_zoom = zoom;
     m_overzoom2 = 1.f;
@@ -247,21 +288,25 @@ void PolylineStyleBuilder<V>::setup(const Marker& marker, int zoom) {
 
 }
 
-template <class V>
-std::unique_ptr<StyledMesh> PolylineStyleBuilder<V>::build() {
+template <class V, class C>
+std::unique_ptr<StyledMesh> PolylineStyleBuilder<V, C>::build() {
     if (m_meshData[0].vertices.empty() &&
         m_meshData[1].vertices.empty()) {
         return nullptr;
     }
 
-    auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(), m_style.drawMode());
-
     bool painterMode = (m_style.blendMode() == Blending::overlay ||
                         m_style.blendMode() == Blending::inlay);
 
     // Swap draw order to draw outline first when not using depth testing
     if (painterMode) { std::swap(m_meshData[0], m_meshData[1]); }
 
+    // The palette is sampled in the vertex shader
+    if (m_style.compactVertices() && Hardware::supportsVertexTextureFetch) {
+        if (auto mesh = buildCompactMesh()) { return mesh; }
+    }
+
+    auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(), m_style.drawMode());
     mesh->compile(m_meshData);
 
     // Swapping back since fill mesh may have more vertices than outline
@@ -272,8 +317,34 @@ std::unique_ptr<StyledMesh> PolylineStyleBuilder<V>::build() {
     return std::move(mesh);
 }
 
-template <class V>
-auto PolylineStyleBuilder<V>::parseRule(const DrawRule& _rule, const Properties& _props) -> Parameters {
+template <class V, class C>
+std::unique_ptr<StyledMesh> PolylineStyleBuilder<V, C>::buildCompactMesh() {
+
+    std::vector<MeshData<C>> compactData(m_meshData.size());
+    for (size_t i = 0; i < m_meshData.size(); i++) {
+        if (!compactVertices(m_meshData[i].vertices, m_palette, compactData[i].vertices)) {
+            LOGN("Style '%s': too many colors for compact vertices", m_style.getName().c_str());
+            m_palette.clear();
+            return nullptr;
+        }
+    }
+
+    for (size_t i = 0; i < m_meshData.size(); i++) {
+        compactData[i].indices = std::move(m_meshData[i].indices);
+        compactData[i].offsets = std::move(m_meshData[i].offsets);
+        m_meshData[i].clear();
+    }
+
+    auto mesh = std::make_unique<PaletteMesh<C>>(m_style.compactVertexLayout(), m_style.drawMode(),
+                                                 m_palette.createTexture());
+    mesh->compile(compactData);
+    m_palette.clear();
+
+    return std::move(mesh);
+}
+
+template <class V, class C>
+auto PolylineStyleBuilder<V, C>::parseRule(const DrawRule& _rule, const Properties& _props) -> Parameters {
     Parameters p;
 
     uint32_t cap = 0, join = 0;
@@ -375,8 +446,8 @@ auto PolylineStyleBuilder<V>::parseRule(const DrawRule& _rule, const Properties&
     return p;
 }
 
-template <class V>
-bool PolylineStyleBuilder<V>::evalWidth(const StyleParam& _styleParam, float& width, float& slope) {
+template <class V, class C>
+bool PolylineStyleBuilder<V, C>::evalWidth(const StyleParam& _styleParam, float& width, float& slope) {
 
     // NB: 0.5 because 'width' will be extruded in both directions
     float pixelWidthScale = .5f * m_tileUnitsPerPixel;
@@ -411,8 +482,8 @@ bool PolylineStyleBuilder<V>::evalWidth(const StyleParam& _styleParam, float& wi
     return false;
 }
 
-template <class V>
-bool PolylineStyleBuilder<V>::addFeature(const Feature& _feat, const DrawRule& _rule) {
+template <class V, class C>
+bool PolylineStyleBuilder<V, C>::addFeature(const Feature& _feat, const DrawRule& _rule) {
 
     if (_feat.geometryType == GeometryType::points) { return false; }
     if (!checkRule(_rule)) { return false; }
@@ -441,14 +512,15 @@ bool PolylineStyleBuilder<V>::addFeature(const Feature& _feat, const DrawRule& _
     return true;
 }
 
-template <class V>
-void PolylineStyleBuilder<V>::buildLine(const Line& _line, const typename Parameters::Attributes& _att,
+template <class V, class C>
+void PolylineStyleBuilder<V, C>::buildLine(const Line& _line, const typename Parameters::Attributes& _att,
                                         MeshData<V>& _mesh, GLuint selection) {
 
     float zoom = m_overzoom2;
+    VertexColors colors{ _att.color, selection };
     m_builder.addVertex = [&](const glm::vec2& coord, const glm::vec2& normal, const glm::vec2& uv) {
         _mesh.vertices.push_back({{ coord.x,coord.y }, normal, { uv.x, uv.y * zoom },
-                                  _att.width, _att.height, _att.color, selection});
+                                  _att.width, _att.height, colors});
     };
 
     Builders::buildPolyLine(_line, m_builder);
@@ -463,8 +535,8 @@ void PolylineStyleBuilder<V>::buildLine(const Line& _line, const typename Parame
     m_builder.clear();
 }
 
-template <class V>
-void PolylineStyleBuilder<V>::addMesh(const Line& _line, const Parameters& _params) {
+template <class V, class C>
+void PolylineStyleBuilder<V, C>::addMesh(const Line& _line, const Parameters& _params) {
 
     m_builder.cap = _params.fill.cap;
     m_builder.join = _params.fill.join;
@@ -504,22 +576,22 @@ void PolylineStyleBuilder<V>::addMesh(const Line& _line, const Parameters& _para
         auto vertexIt = fill.vertices.end() - nVertices;
 
         glm::vec2 width = _params.stroke.width;
-        GLuint abgr = _params.stroke.color;
+        VertexColors colors{ _params.stroke.color, _params.selectionColor };
         short order = _params.stroke.height[1];
 
         for (; vertexIt != fill.vertices.end(); ++vertexIt) {
-            stroke.vertices.emplace_back(*vertexIt, order, width, abgr, _params.selectionColor);
+            stroke.vertices.emplace_back(*vertexIt, order, width, colors);
         }
     }
 }
 
 std::unique_ptr<StyleBuilder> PolylineStyle::createBuilder() const {
     if (m_texCoordsGeneration) {
-        auto builder = std::make_unique<PolylineStyleBuilder<PolylineVertex>>(*this);
+        auto builder = std::make_unique<PolylineStyleBuilder<PolylineVertex, CompactPolylineVertex>>(*this);
         builder->polylineBuilder().useTexCoords = true;
         return std::move(builder);
     } else {
-        auto builder = std::make_unique<PolylineStyleBuilder<PolylineVertexNoUVs>>(*this);
+        auto builder = std::make_unique<PolylineStyleBuilder<PolylineVertexNoUVs, CompactPolylineVertexNoUVs>>(*this);
         builder->polylineBuilder().useTexCoords = false;
         return std::move(builder);
     }
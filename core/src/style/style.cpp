@@ -4,6 +4,7 @@
 #include "gl/renderState.h"
 #include "gl/shaderProgram.h"
 #include "gl/mesh.h"
+#include "gl/texture.h"
 #include "log.h"
 #include "map.h"
 #include "marker/marker.h"
@@ -53,6 +54,11 @@ void Style::build(const Scene& _scene) {
 
     m_shaderSource->addSourceBlock("defines", blendingDefine, false);
 
+    if (m_compactVertices) {
+        // Meshes of the style may use either vertex layout, see bindPalette()
+        m_shaderSource->addSourceBlock("defines", "#define TANGRAM_COMPACT_VERTICES\n", false);
+    }
+
     if (m_material.material) {
         m_material.uniforms = m_material.material->injectOnProgram(*m_shaderSource);
     }
@@ -233,6 +239,24 @@ void Style::setupShaderUniforms(RenderState& rs, ShaderProgram& _program, const
 
 }
 
+bool Style::bindPalette(RenderState& rs, ShaderProgram& _program, UniformBlock& _uniforms,
+                        const StyledMesh& _mesh) {
+
+    auto* palette = _mesh.palette();
+    if (!palette) {
+        // The colors are stored in the vertices
+        if (m_compactVertices) { _program.setUniformf(rs, _uniforms.uPaletteSize, 0.f, 0.f); }
+        return false;
+    }
+
+    palette->bind(rs, rs.nextAvailableTextureUnit());
+
+    _program.setUniformi(rs, _uniforms.uPalette, rs.currentTextureUnit());
+    _program.setUniformf(rs, _uniforms.uPaletteSize, palette->width(), palette->height());
+
+    return true;
+}
+
 void Style::onBeginDrawFrame(RenderState& rs, const View& _view) {
 
     setupShaderUniforms(rs, *m_shaderProgram, _view, m_mainUniforms);
@@ -337,9 +361,13 @@ void Style::drawSelectionFrame(RenderState& _rs, const Marker& _marker) {
                                     _marker.origin().x, _marker.origin().y,
                                     _marker.builtZoomLevel(), _marker.builtZoomLevel());
 
+    bool hasPalette = bindPalette(_rs, *m_selectionProgram, m_selectionUniforms, *mesh);
+
     if (!mesh->draw(_rs, *m_selectionProgram, false)) {
         LOGN("Mesh built by style %s cannot be drawn", m_name.c_str());
     }
+
+    if (hasPalette) { _rs.releaseTextureUnit(); }
 }
 
 void Style::drawSelectionFrame(Tangram::RenderState& rs, const Tangram::Tile &_tile) {
@@ -362,10 +390,14 @@ void Style::drawSelectionFrame(Tangram::RenderState& rs, const Tangram::Tile &_t
                                     tileID.s,
                                     tileID.z);
 
+    bool hasPalette = bindPalette(rs, *m_selectionProgram, m_selectionUniforms, *styleMesh);
+
     if (!styleMesh->draw(rs, *m_selectionProgram, false)) {
         LOGN("Mesh built by style %s cannot be drawn", m_name.c_str());
     }
 
+    if (hasPalette) { rs.releaseTextureUnit(); }
+
 }
 
 bool Style::draw(RenderState& rs, const View& _view,
@@ -473,11 +505,15 @@ bool Style::draw(RenderState& rs, const Tile& _tile) {
                                  tileID.s,
                                  tileID.z);
 
+    bool hasPalette = bindPalette(rs, *m_shaderProgram, m_mainUniforms, *styleMesh);
+
     if (!styleMesh->draw(rs, *m_shaderProgram)) {
         LOGN("Mesh built by style %s cannot be drawn", m_name.c_str());
         styleMeshDrawn = false;
     }
 
+    if (hasPalette) { rs.releaseTextureUnit(); }
+
     if (hasRasters()) {
         for (auto& raster : _tile.rasters()) {
             if (raster.isValid()) {
@@ -503,11 +539,15 @@ bool Style::draw(RenderState& rs, const Marker& marker) {
                                  marker.origin().x, marker.origin().y,
                                  marker.builtZoomLevel(), marker.builtZoomLevel());
 
+    bool hasPalette = bindPalette(rs, *m_shaderProgram, m_mainUniforms, *mesh);
+
     if (!mesh->draw(rs, *m_shaderProgram)) {
         LOGN("Mesh built by style %s cannot be drawn", m_name.c_str());
         styleMeshDrawn = false;
     }
 
+    if (hasPalette) { rs.releaseTextureUnit(); }
+
     return styleMeshDrawn;
 }
 
@@ -23,8 +23,10 @@ class Scene;
 class ShaderProgram;
 class ShaderSource;
 class Style;
+class TessellationCache;
 class Tile;
 class TileSource;
+class Texture;
 class VertexLayout;
 class View;
 struct DrawRule;
@@ -67,6 +69,9 @@ struct StyledMesh {
     virtual bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao = true) = 0;
     virtual size_t bufferSize() const = 0;
 
+    // Color palette texture for meshes with compact vertices, nullptr otherwise
+    virtual Texture* palette() const { return nullptr; }
+
     virtual ~StyledMesh() {}
 };
 
@@ -79,6 +84,9 @@ public:
 
     virtual void setup(const Marker& _marker, int zoom) = 0;
 
+    /* Set the cache for polygon triangulations of the tile data being built, or nullptr */
+    virtual void setTessellationCache(TessellationCache* _cache) {}
+
     virtual bool addFeature(const Feature& _feat, const DrawRule& _rule);
 
     /* Build styled vertex data for point geometry */
@@ -135,6 +143,9 @@ protected:
     /* <VertexLayout> shared between meshes using this style */
     std::shared_ptr<VertexLayout> m_vertexLayout;
 
+    /* Vertex layout of meshes with compact vertices, when the style uses them */
+    std::shared_ptr<VertexLayout> m_compactVertexLayout;
+
     /* Stores default style draw rules*/
     std::unique_ptr<DrawRuleData> m_defaultDrawRule = nullptr;
 
@@ -153,6 +164,9 @@ protected:
     /* Whether the style should generate texture coordinates */
     bool m_texCoordsGeneration = false;
 
+    /* Whether meshes should use quantized vertices with a per-mesh color palette */
+    bool m_compactVertices = false;
+
     bool m_hasColorShaderBlock = false;
 
     RasterType m_rasterType = RasterType::none;
@@ -179,6 +193,9 @@ protected:
         UniformLocation uRasters{"u_rasters"};
         UniformLocation uRasterSizes{"u_raster_sizes"};
         UniformLocation uRasterOffsets{"u_raster_offsets"};
+        // Mesh uniforms
+        UniformLocation uPalette{"u_palette"};
+        UniformLocation uPaletteSize{"u_palette_size"};
 
         std::vector<StyleUniform> styleUniforms;
     } m_mainUniforms, m_selectionUniforms;
@@ -190,6 +207,13 @@ protected:
     void setupShaderUniforms(RenderState& rs, ShaderProgram& _program, const View& _view,
                              UniformBlock& _uniformBlock);
 
+    /* Bind the color palette of _mesh when it has one, otherwise let the shader use
+     * the vertex colors. Returns true when a texture unit was taken, which must be
+     * released after drawing the mesh.
+     */
+    bool bindPalette(RenderState& rs, ShaderProgram& _program, UniformBlock& _uniformBlock,
+                     const StyledMesh& _mesh);
+
     struct LightHandle {
         LightHandle(Light* _light, std::unique_ptr<LightUniforms> _uniforms);
         Light *light;
@@ -302,6 +326,10 @@ public:
 
     bool genTexCoords() const { return m_texCoordsGeneration; }
 
+    void setCompactVertices(bool _compactVertices) { m_compactVertices = _compactVertices; }
+
+    bool compactVertices() const { return m_compactVertices; }
+
     void setID(uint32_t _id) { m_id = _id; }
 
     Material& getMaterial() { return *m_material.material; }
@@ -326,6 +354,8 @@ public:
     float pixelScale() const { return m_pixelScale; }
     const auto& vertexLayout() const { return m_vertexLayout; }
 
+    const auto& compactVertexLayout() const { return m_compactVertexLayout; }
+
     bool hasColorShaderBlock() const { return m_hasColorShaderBlock; }
 
 };
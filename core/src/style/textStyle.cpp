@@ -78,7 +78,7 @@ void TextStyle::onBeginDrawFrame(RenderState& rs, const View& _view) {
     m_shaderProgram->setUniformf(rs, m_mainUniforms.uMaxStrokeWidth,
                                  m_context->maxStrokeWidth());
     m_shaderProgram->setUniformf(rs, m_mainUniforms.uTexScaleFactor,
-                                 glm::vec2(1.0f / GlyphTexture::size));
+                                 glm::vec2(1.0f / m_context->atlasSize()));
     m_shaderProgram->setUniformi(rs, m_mainUniforms.uTex, texUnit);
     m_shaderProgram->setUniformMatrix4f(rs, m_mainUniforms.uOrtho,
                                         _view.getOrthoViewportMatrix());
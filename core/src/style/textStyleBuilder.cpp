@@ -824,8 +824,11 @@ bool TextStyleBuilder::prepareLabel(TextStyle::Parameters& _params, Label::Type
     _attributes.quadsStart = m_quads.size();
     _attributes.textRanges = TextRange{};
 
+    if (!m_shaper) { m_shaper = ctx->createShaper(); }
+
     glm::vec2 bbox(0);
-    if (ctx->layoutText(_params, text, m_quads, m_atlasRefs, bbox, _attributes.textRanges)) {
+    if (ctx->layoutText(*m_shaper, _params, text, m_quads, m_atlasRefs, bbox,
+                        _attributes.textRanges)) {
 
         int start = _attributes.quadsStart;
         for (auto& range : _attributes.textRanges) {
@@ -74,6 +74,9 @@ protected:
     std::bitset<FontContext::max_textures> m_atlasRefs;
     std::vector<std::unique_ptr<Label>> m_labels;
 
+    // Text layout state of this builder's worker, created on first use
+    std::unique_ptr<FontContext::Shaper> m_shaper;
+
     float m_tileSize = 0;
     float m_tileScale = 0;
 
@@ -6,6 +6,8 @@
 #define SDF_IMPLEMENTATION
 #include "sdf.h"
 
+#include <algorithm>
+#include <cassert>
 #include <memory>
 #include <regex>
 
@@ -17,14 +19,16 @@ namespace Tangram {
 
 const std::vector<float> FontContext::s_fontRasterSizes = { 16, 28, 40 };
 
-FontContext::FontContext(Platform& _platform) :
+FontContext::FontContext(Platform& _platform, int _atlasSize) :
     m_sdfRadius(SDF_WIDTH),
-    m_atlas(*this, GlyphTexture::size, m_sdfRadius),
-    m_batch(m_atlas, m_scratch),
+    m_atlasSize(_atlasSize),
+    m_atlas(*this, m_atlasSize, m_sdfRadius),
+    m_layoutCache(max_cached_layouts),
     m_platform(_platform) {}
 
 void FontContext::setPixelScale(float _scale) {
     m_sdfRadius = SDF_WIDTH * _scale;
+    m_layoutCache.clear();
 }
 
 void FontContext::loadFonts() {
@@ -69,7 +73,17 @@ void FontContext::loadFonts() {
     }
 }
 
-// Synchronized on m_mutex in layoutText(), called on tile-worker threads
+void FontContext::setGlyphBundle(std::shared_ptr<GlyphBundle> _bundle, bool _record) {
+    std::lock_guard<std::mutex> lock(m_textureMutex);
+
+    // Glyphs that were already added would not be looked up or recorded
+    assert(m_textures.empty());
+
+    m_glyphBundle = std::move(_bundle);
+    m_recordGlyphBundle = _record;
+}
+
+// Synchronized on m_fontMutex in layoutText(), called on tile-worker threads
 void FontContext::addTexture(alfons::AtlasID id, uint16_t width, uint16_t height) {
 
     std::lock_guard<std::mutex> lock(m_textureMutex);
@@ -78,10 +92,12 @@ void FontContext::addTexture(alfons::AtlasID id, uint16_t width, uint16_t height
         LOGE("Way too many glyph textures!");
         return;
     }
-    m_textures.push_back(std::make_unique<GlyphTexture>());
+    m_textures.push_back(std::make_unique<GlyphTexture>(m_atlasSize));
 }
 
-// Synchronized on m_mutex in layoutText(), called on tile-worker threads
+// Synchronized on m_fontMutex in layoutText(), called on tile-worker threads.
+// Only copies the glyph bitmap: the distance field is computed by rasterizeGlyphs()
+// after the font lock is released.
 void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_t gw, uint16_t gh,
                            const unsigned char* src, uint16_t pad) {
 
@@ -89,11 +105,10 @@ void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_
 
     if (id >= max_textures) { return; }
 
-    auto texData = m_textures[id]->buffer();
-    auto& texture = m_textures[id];
+    auto texture = m_textures[id].get();
+    auto texData = texture->buffer();
 
-    size_t stride = GlyphTexture::size;
-    size_t width =  GlyphTexture::size;
+    size_t stride = m_atlasSize;
 
     unsigned char* dst = &texData[(gx + pad) + (gy + pad) * stride];
 
@@ -101,20 +116,102 @@ void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_
         std::memcpy(dst + (y * stride), src + pos, gw);
     }
 
-    dst = &texData[size_t(gx) + (size_t(gy) * width)];
     gw += pad * 2;
     gh += pad * 2;
 
-    size_t bytes = size_t(gw) * size_t(gh) * sizeof(float) * 3;
-    if (m_sdfBuffer.size() < bytes) {
-        m_sdfBuffer.resize(bytes);
+    m_glyphRequests.push_back({ id, texture, gx, gy, gw, gh });
+    m_pendingGlyphs[id] += 1;
+
+    m_atlasGlyphs[id] += 1;
+    m_atlasArea[id] += size_t(gw) * size_t(gh);
+}
+
+// Computes the distance fields of the glyphs added by the last layout of _shaper.
+// The glyph cells are copied to the scratch memory of _shaper, so that workers do
+// not write the atlas while the render thread uploads it.
+void FontContext::rasterizeGlyphs(Shaper& _shaper) {
+    if (_shaper.glyphs.empty()) { return; }
+
+    size_t cells = 0;
+    size_t maxCell = 0;
+    for (const auto& glyph : _shaper.glyphs) {
+        size_t cell = size_t(glyph.width) * size_t(glyph.height);
+        cells += cell;
+        maxCell = std::max(maxCell, cell);
+    }
+    if (_shaper.glyphBitmaps.size() < cells) {
+        _shaper.glyphBitmaps.resize(cells);
+    }
+    if (_shaper.sdfBuffer.size() < maxCell * sizeof(float) * 3) {
+        _shaper.sdfBuffer.resize(maxCell * sizeof(float) * 3);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+
+        unsigned char* bitmap = _shaper.glyphBitmaps.data();
+        for (const auto& glyph : _shaper.glyphs) {
+            glyph.texture->readCell(glyph.x, glyph.y, glyph.width, glyph.height, bitmap);
+            bitmap += size_t(glyph.width) * size_t(glyph.height);
+        }
+    }
+
+    unsigned char* bitmap = _shaper.glyphBitmaps.data();
+    for (const auto& glyph : _shaper.glyphs) {
+        unsigned char* dst = bitmap;
+        size_t stride = glyph.width;
+        bitmap += size_t(glyph.width) * size_t(glyph.height);
+
+        if (glyph.width == 0 || glyph.height == 0) { continue; }
+
+        uint64_t bundleKey = 0;
+        if (m_glyphBundle) {
+            bundleKey = GlyphBundle::key(dst, stride, glyph.width, glyph.height, m_sdfRadius);
+
+            if (!m_recordGlyphBundle) {
+                if (auto sdf = m_glyphBundle->find(bundleKey, glyph.width, glyph.height)) {
+                    std::memcpy(dst, sdf, size_t(glyph.width) * size_t(glyph.height));
+                    continue;
+                }
+            }
+        }
+
+        sdfBuildDistanceFieldNoAlloc(dst, stride, m_sdfRadius,
+                                     dst, glyph.width, glyph.height, stride,
+                                     &_shaper.sdfBuffer[0]);
+
+        if (m_recordGlyphBundle) {
+            std::lock_guard<std::mutex> lock(m_glyphBundleMutex);
+            m_glyphBundle->add(bundleKey, dst, stride, glyph.width, glyph.height);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+
+        bitmap = _shaper.glyphBitmaps.data();
+        for (const auto& glyph : _shaper.glyphs) {
+            glyph.texture->writeCell(glyph.x, glyph.y, glyph.width, glyph.height, bitmap);
+            bitmap += size_t(glyph.width) * size_t(glyph.height);
+            m_pendingGlyphs[glyph.atlas] -= 1;
+        }
     }
+    _shaper.glyphs.clear();
 
-    sdfBuildDistanceFieldNoAlloc(dst, width, m_sdfRadius,
-                                 dst, gw, gh, width,
-                                 &m_sdfBuffer[0]);
+    m_glyphsDone.notify_all();
+}
+
+// Wait until the distance fields of all glyphs in _atlases are computed, as the
+// glyphs of a laid out text may have been added by another worker.
+void FontContext::waitForGlyphs(const std::bitset<max_textures>& _atlases) {
+    std::unique_lock<std::mutex> lock(m_textureMutex);
 
-    texture->setRowsDirty(gy, gh);
+    m_glyphsDone.wait(lock, [&]() {
+        for (size_t i = 0; i < m_textures.size(); i++) {
+            if (_atlases[i] && m_pendingGlyphs[i] > 0) { return false; }
+        }
+        return true;
+    });
 }
 
 void FontContext::releaseAtlas(std::bitset<max_textures> _refs) {
@@ -122,45 +219,88 @@ void FontContext::releaseAtlas(std::bitset<max_textures> _refs) {
     std::lock_guard<std::mutex> lock(m_textureMutex);
 
     for (size_t i = 0; i < m_textures.size(); i++) {
-        if (_refs[i]) { m_atlasRefCount[i] -= 1; }
+        if (_refs[i]) {
+            m_atlasRefCount[i] -= 1;
+            // Keep the glyphs of unused atlases for reuse until the atlas gets evicted
+            if (m_atlasRefCount[i] == 0) { m_unusedAtlases.push_back(i); }
+        }
     }
 }
 
-void FontContext::updateTextures(RenderState& rs) {
-    std::lock_guard<std::mutex> lock(m_textureMutex);
+// Called with m_textureMutex locked
+void FontContext::useAtlas(size_t _id, std::bitset<max_textures>& _refs) {
+    if (_refs[_id]) { return; }
 
-    for (auto& gt : m_textures) { gt->bind(rs, 0); }
+    _refs[_id] = true;
+    if (m_atlasRefCount[_id]++ == 0) {
+        auto it = std::find(m_unusedAtlases.begin(), m_unusedAtlases.end(), _id);
+        if (it != m_unusedAtlases.end()) { m_unusedAtlases.erase(it); }
+    }
 }
 
-void FontContext::bindTexture(RenderState& rs, alfons::AtlasID _id, GLuint _unit) {
+// Called with m_fontMutex locked, as clearing the atlas invalidates glyphs of the
+// shared font faces
+void FontContext::evictUnusedAtlases() {
     std::lock_guard<std::mutex> lock(m_textureMutex);
 
-    m_textures[_id]->bind(rs, _unit);
-}
+    // Free at least one atlas for new glyphs when no new texture can be added
+    size_t keep = m_textures.size() < max_textures ? max_unused_atlases : 0;
 
-bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeString& _text,
-                             std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs,
-                             glm::vec2& _size, TextRange& _textRanges) {
+    while (m_unusedAtlases.size() > keep) {
+        // Atlases are cleared least recently released first, skipping those
+        // with glyphs that are still being rasterized
+        auto it = std::find_if(m_unusedAtlases.begin(), m_unusedAtlases.end(),
+                               [&](size_t id) { return m_pendingGlyphs[id] == 0; });
+        if (it == m_unusedAtlases.end()) { break; }
 
-    std::lock_guard<std::mutex> lock(m_fontMutex);
+        size_t id = *it;
+        m_unusedAtlases.erase(it);
 
-    alfons::LineLayout line = m_shaper.shapeICU(_params.font, _text, MIN_LINE_WIDTH,
-                                                _params.wordWrap ? _params.maxLineWidth : 0);
+        m_atlas.clear(id);
+        std::memset(m_textures[id]->buffer(), 0, m_atlasSize * m_atlasSize);
+        m_atlasGeneration[id] += 1;
+        m_atlasGlyphs[id] = 0;
+        m_atlasArea[id] = 0;
 
-    if (line.missingGlyphs() || line.shapes().size() == 0) {
-        // Nothing to do!
-        return false;
+        if (keep == 0) { break; }
     }
+}
 
-    line.setScale(_params.fontScale);
+FontContext::AtlasStats FontContext::atlasStats() {
+    std::lock_guard<std::mutex> lock(m_textureMutex);
 
-    // m_batch.drawShapeRange() calls FontContext's TextureCallback for new glyphs
-    // and MeshCallback (drawGlyph) for vertex quads of each glyph in LineLayout.
+    AtlasStats stats{};
+    stats.textures = m_textures.size();
+    stats.memoryUsage = m_textures.size() * m_atlasSize * m_atlasSize;
 
-    m_scratch.quads = &_quads;
+    size_t area = 0;
+    for (size_t i = 0; i < m_textures.size(); i++) {
+        if (m_atlasRefCount[i] > 0) { stats.usedTextures++; }
+        stats.glyphs += m_atlasGlyphs[i];
+        area += m_atlasArea[i];
+    }
+    if (stats.memoryUsage > 0) {
+        stats.occupancy = float(area) / stats.memoryUsage;
+    }
+    return stats;
+}
 
-    size_t quadsStart = _quads.size();
-    alfons::LineMetrics metrics;
+void FontContext::updateTextures(RenderState& rs) {
+    std::lock_guard<std::mutex> lock(m_textureMutex);
+
+    for (auto& gt : m_textures) { gt->bind(rs, 0); }
+}
+
+void FontContext::bindTexture(RenderState& rs, alfons::AtlasID _id, GLuint _unit) {
+    std::lock_guard<std::mutex> lock(m_textureMutex);
+
+    m_textures[_id]->bind(rs, _unit);
+}
+
+bool FontContext::layoutText(Shaper& _shaper, TextStyle::Parameters& _params,
+                             const icu::UnicodeString& _text, std::vector<GlyphQuad>& _quads,
+                             std::bitset<max_textures>& _refs, glm::vec2& _size,
+                             TextRange& _textRanges) {
 
     std::array<bool, 3> alignments = {};
     if (_params.align != TextLabelProperty::Align::none) {
@@ -176,8 +316,67 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
         }
     }
 
+    // Wrapping parameters and alignments only apply to wrapped text
+    TextLayoutCache::Key key{ _params.font.get(), _params.fontScale, _text, 0, 0, 0, 0 };
+    if (_params.wordWrap) {
+        key.maxLineWidth = _params.maxLineWidth;
+        key.maxLines = _params.maxLines;
+        key.lineSpacing = _params.lineSpacing;
+        for (size_t i = 0; i < 3; i++) {
+            if (alignments[i]) { key.alignments |= 1 << i; }
+        }
+    }
+
+    std::bitset<max_textures> atlases;
+    {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+
+        if (auto layout = m_layoutCache.get(key, m_atlasGeneration.data())) {
+            int start = _quads.size();
+            _quads.insert(_quads.end(), layout->quads.begin(), layout->quads.end());
+
+            for (size_t i = 0; i < 3; i++) {
+                _textRanges[i] = Range(start + layout->textRanges[i].start,
+                                       layout->textRanges[i].length);
+            }
+            _size = layout->size;
+
+            for (const auto& atlas : layout->atlases) {
+                useAtlas(atlas.first, _refs);
+                atlases[atlas.first] = true;
+            }
+        }
+    }
+    if (atlases.any()) {
+        waitForGlyphs(atlases);
+        return true;
+    }
+
+    // Shaping reads glyphs from the shared font faces
+    std::unique_lock<std::mutex> fontLock(m_fontMutex);
+
+    alfons::LineLayout line = _shaper.shaper.shapeICU(_params.font, _text, MIN_LINE_WIDTH,
+                                                      _params.wordWrap ? _params.maxLineWidth : 0);
+    fontLock.unlock();
+
+    if (line.missingGlyphs() || line.shapes().size() == 0) {
+        // Nothing to do!
+        return false;
+    }
+
+    line.setScale(_params.fontScale);
+
+    // batch.drawShapeRange() calls FontContext's TextureCallback for new glyphs
+    // and MeshCallback (drawGlyph) for vertex quads of each glyph in LineLayout.
+
+    _shaper.scratch.quads = &_quads;
+
+    size_t quadsStart = _quads.size();
+    alfons::LineMetrics metrics;
+
     if (_params.wordWrap) {
-        m_textWrapper.clearWraps();
+        auto& wrapper = _shaper.wrapper;
+        wrapper.clearWraps();
 
         if (_params.maxLines != 0) {
             uint32_t numLines = 0;
@@ -192,7 +391,9 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
                         shape.mustBreak = false;
                         line.removeShapes(shape.isSpace ? pos-1 : pos, max);
 
-                        auto ellipsis = m_shaper.shape(_params.font, "…");
+                        fontLock.lock();
+                        auto ellipsis = _shaper.shaper.shape(_params.font, "…");
+                        fontLock.unlock();
                         line.addShapes(ellipsis.shapes());
                         break;
                     }
@@ -200,18 +401,22 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
             }
         }
 
-        float width = m_textWrapper.getShapeRangeWidth(line);
+        float width = wrapper.getShapeRangeWidth(line);
+
+        // Drawing adds missing glyphs to the shared atlas
+        fontLock.lock();
+        evictUnusedAtlases();
 
         for (size_t i = 0; i < 3; i++) {
 
-            int rangeStart = m_scratch.quads->size();
+            int rangeStart = _quads.size();
             if (!alignments[i]) {
                 _textRanges[i] = Range(rangeStart, 0);
                 continue;
             }
-            int numLines = m_textWrapper.draw(m_batch, width, line, TextLabelProperty::Align(i),
-                                              _params.lineSpacing, metrics);
-            int rangeEnd = m_scratch.quads->size();
+            int numLines = wrapper.draw(_shaper.batch, width, line, TextLabelProperty::Align(i),
+                                        _params.lineSpacing, metrics);
+            int rangeEnd = _quads.size();
 
             _textRanges[i] = Range(rangeStart, rangeEnd - rangeStart);
 
@@ -224,9 +429,11 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
         }
     } else {
         glm::vec2 position(0);
-        int rangeStart = m_scratch.quads->size();
-        m_batch.drawShapeRange(line, 0, line.shapes().size(), position, metrics);
-        int rangeEnd = m_scratch.quads->size();
+        int rangeStart = _quads.size();
+        fontLock.lock();
+        evictUnusedAtlases();
+        _shaper.batch.drawShapeRange(line, 0, line.shapes().size(), position, metrics);
+        int rangeEnd = _quads.size();
 
         _textRanges[0] = Range(rangeStart, rangeEnd - rangeStart);
 
@@ -234,9 +441,17 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
         _textRanges[2] = Range(rangeEnd, 0);
     }
 
+    {
+        // Take the glyphs added while drawing, to rasterize them outside of the font lock
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        std::swap(_shaper.glyphs, m_glyphRequests);
+    }
+
     auto it = _quads.begin() + quadsStart;
     if (it == _quads.end()) {
         // No glyphs added
+        fontLock.unlock();
+        rasterizeGlyphs(_shaper);
         return false;
     }
 
@@ -249,14 +464,17 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
     glm::vec2 offset((metrics.aabb.x + width * 0.5) * TextVertex::position_scale,
                      (metrics.aabb.y + height * 0.5) * TextVertex::position_scale);
 
+    auto layout = std::make_shared<TextLayout>();
+
+    // The atlases of the added glyphs must be referenced before another worker
+    // can evict them, see evictUnusedAtlases()
+    assert(fontLock.owns_lock());
     {
         std::lock_guard<std::mutex> lock(m_textureMutex);
         for (; it != _quads.end(); ++it) {
 
-            if (!_refs[it->atlas]) {
-                _refs[it->atlas] = true;
-                m_atlasRefCount[it->atlas] += 1;
-            }
+            useAtlas(it->atlas, _refs);
+            atlases[it->atlas] = true;
 
             it->quad[0].pos -= offset;
             it->quad[1].pos -= offset;
@@ -264,14 +482,22 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
             it->quad[3].pos -= offset;
         }
 
-        // Clear unused textures
-        for (size_t i = 0; i < m_textures.size(); i++) {
-            if (m_atlasRefCount[i] == 0) {
-                m_atlas.clear(i);
-                std::memset(m_textures[i]->buffer(), 0, GlyphTexture::size * GlyphTexture::size);
-            }
+        for (size_t i = 0; i < max_textures; i++) {
+            if (atlases[i]) { layout->atlases.emplace_back(i, m_atlasGeneration[i]); }
         }
     }
+    fontLock.unlock();
+
+    rasterizeGlyphs(_shaper);
+    waitForGlyphs(atlases);
+
+    layout->quads.assign(_quads.begin() + quadsStart, _quads.end());
+    for (size_t i = 0; i < 3; i++) {
+        layout->textRanges[i] = Range(_textRanges[i].start - int(quadsStart), _textRanges[i].length);
+    }
+    layout->size = _size;
+
+    m_layoutCache.put(std::move(key), std::move(layout));
 
     return true;
 }
@@ -281,6 +507,9 @@ void FontContext::addFont(const FontDescription& _ft, alfons::InputSource _sourc
     // NB: Synchronize for calls from download thread
     std::lock_guard<std::mutex> lock(m_fontMutex);
 
+    // Texts may have been laid out with fallback glyphs
+    m_layoutCache.clear();
+
     for (size_t i = 0; i < s_fontRasterSizes.size(); i++) {
         if (auto font = m_alfons.getFont(_ft.alias, s_fontRasterSizes[i])) {
 
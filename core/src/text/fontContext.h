@@ -3,6 +3,8 @@
 #include "gl/glyphTexture.h"
 #include "labels/textLabel.h"
 #include "style/textStyle.h"
+#include "text/glyphBundle.h"
+#include "text/textLayoutCache.h"
 #include "text/textUtil.h"
 
 #include "alfons/alfons.h"
@@ -13,6 +15,8 @@
 #include "alfons/textBatch.h"
 #include "alfons/textShaper.h"
 #include <bitset>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
 
 namespace Tangram {
@@ -47,7 +51,22 @@ public:
 
     static constexpr int max_textures = 64;
 
-    FontContext(Platform& _platform);
+    // Number of text layouts kept for reuse by layoutText()
+    static constexpr size_t max_cached_layouts = 4096;
+
+    // Number of unreferenced atlases whose glyphs are kept for reuse
+    static constexpr size_t max_unused_atlases = 4;
+
+    struct AtlasStats {
+        size_t textures;
+        size_t usedTextures;
+        size_t glyphs;
+        size_t memoryUsage;
+        // Fraction of the texture area covered by glyphs
+        float occupancy;
+    };
+
+    FontContext(Platform& _platform, int _atlasSize = GlyphTexture::defaultSize);
     virtual ~FontContext() {}
 
     void loadFonts();
@@ -65,8 +84,22 @@ public:
     void addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_t gw, uint16_t gh,
                   const unsigned char* src, uint16_t pad) override;
 
+    /* Release references of labels to atlases. Atlases without references keep their
+     * glyphs until they are evicted, least recently released first, by layoutText()
+     */
     void releaseAtlas(std::bitset<max_textures> _refs);
 
+    int atlasSize() const { return m_atlasSize; }
+
+    /* Use distance fields from _bundle for glyphs it contains. When _record is set, the
+     * distance fields of all new glyphs are added to _bundle instead.
+     * Workers read the bundle without synchronization: It must be set up before the
+     * first glyph is added to the atlas.
+     */
+    void setGlyphBundle(std::shared_ptr<GlyphBundle> _bundle, bool _record = false);
+
+    AtlasStats atlasStats();
+
     /* Update all textures batches, uploads the data to the GPU */
     void updateTextures(RenderState& rs);
 
@@ -82,16 +115,54 @@ public:
 
     float maxStrokeWidth() { return m_sdfRadius; }
 
-    bool layoutText(TextStyle::Parameters& _params, const icu::UnicodeString& _text,
-                    std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs,
-                    glm::vec2& _bbox, TextRange& _textRanges);
-
     struct ScratchBuffer : public alfons::MeshCallback {
         void drawGlyph(const alfons::Quad& q, const alfons::AtlasGlyph& altasGlyph) override {}
         void drawGlyph(const alfons::Rect& q, const alfons::AtlasGlyph& atlasGlyph) override;
         std::vector<GlyphQuad>* quads;
     };
 
+    /* Atlas cell of a glyph that was added by addGlyph(): the cell holds the glyph
+     * bitmap until the worker that added it writes back the distance field
+     */
+    struct GlyphRequest {
+        alfons::AtlasID atlas;
+        GlyphTexture* texture;
+        uint16_t x, y, width, height;
+    };
+
+    /* Layout state that is not shared between threads. Each TextStyleBuilder owns
+     * a Shaper, so that tile workers only synchronize on the FontContext while
+     * shaping with the shared fonts and adding glyphs to the shared atlas.
+     */
+    struct Shaper {
+        explicit Shaper(alfons::GlyphAtlas& _atlas) : batch(_atlas, scratch) {}
+
+        // TextShaper to create <LineLayout> for a given text and Font
+        alfons::TextShaper shaper;
+
+        // TextBatch to 'draw' <LineLayout>s, i.e. creating glyph textures and glyph quads.
+        // It is intialized with a TextureCallback implemented by FontContext for adding glyph
+        // textures and the ScratchBuffer MeshCallback for collecting glyph quads.
+        ScratchBuffer scratch;
+        alfons::TextBatch batch;
+
+        TextWrapper wrapper;
+
+        // Glyphs added by the last layout, copies of their atlas cells while their
+        // distance fields are computed and scratch memory for the computation
+        std::vector<GlyphRequest> glyphs;
+        std::vector<unsigned char> glyphBitmaps;
+        std::vector<unsigned char> sdfBuffer;
+    };
+
+    std::unique_ptr<Shaper> createShaper() { return std::make_unique<Shaper>(m_atlas); }
+
+    bool layoutText(Shaper& _shaper, TextStyle::Parameters& _params, const icu::UnicodeString& _text,
+                    std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs,
+                    glm::vec2& _bbox, TextRange& _textRanges);
+
+    TextLayoutCache::Stats layoutCacheStats() const { return m_layoutCache.stats(); }
+
     void addFont(const FontDescription& _ft, alfons::InputSource _source);
 
     void setPixelScale(float _scale);
@@ -100,16 +171,40 @@ public:
 
 private:
 
+    void useAtlas(size_t _id, std::bitset<max_textures>& _refs);
+
+    void evictUnusedAtlases();
+
+    void rasterizeGlyphs(Shaper& _shaper);
+
+    void waitForGlyphs(const std::bitset<max_textures>& _atlases);
+
     static const std::vector<float> s_fontRasterSizes;
 
     float m_sdfRadius;
-    ScratchBuffer m_scratch;
-    std::vector<unsigned char> m_sdfBuffer;
+    int m_atlasSize;
 
+    // Guards the fonts and the glyph atlas
     std::mutex m_fontMutex;
     std::mutex m_textureMutex;
 
     std::array<int, max_textures> m_atlasRefCount = {{0}};
+    // Incremented when an atlas is cleared, invalidating the cached layouts using it
+    std::array<uint32_t, max_textures> m_atlasGeneration = {{0}};
+    std::array<uint32_t, max_textures> m_atlasGlyphs = {{0}};
+    std::array<size_t, max_textures> m_atlasArea = {{0}};
+    std::deque<size_t> m_unusedAtlases;
+
+    // Glyphs added while drawing, not yet taken by the drawing worker
+    std::vector<GlyphRequest> m_glyphRequests;
+    // Number of glyphs per atlas whose distance field is not yet computed
+    std::array<uint32_t, max_textures> m_pendingGlyphs = {{0}};
+    std::condition_variable m_glyphsDone;
+
+    std::shared_ptr<GlyphBundle> m_glyphBundle;
+    bool m_recordGlyphBundle = false;
+    // Guards adding the distance fields of concurrently rasterized glyphs to m_glyphBundle
+    std::mutex m_glyphBundleMutex;
     alfons::GlyphAtlas m_atlas;
 
     alfons::FontManager m_alfons;
@@ -117,14 +212,7 @@ private:
 
     std::vector<std::unique_ptr<GlyphTexture>> m_textures;
 
-    // TextShaper to create <LineLayout> for a given text and Font
-    alfons::TextShaper m_shaper;
-
-    // TextBatch to 'draw' <LineLayout>s, i.e. creating glyph textures and glyph quads.
-    // It is intialized with a TextureCallback implemented by FontContext for adding glyph
-    // textures and a MeshCallback implemented by TextStyleBuilder for adding glyph quads.
-    alfons::TextBatch m_batch;
-    TextWrapper m_textWrapper;
+    TextLayoutCache m_layoutCache;
 
     Platform& m_platform;
 
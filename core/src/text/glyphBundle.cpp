@@ -0,0 +1,162 @@
+#include "text/glyphBundle.h"
+
+#include "log.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace Tangram {
+
+// Bundle layout, in host byte order:
+//   header:  magic, version, number of entries, size of the distance field data
+//   entries: key, data offset, width, height
+//   distance field data
+static const char s_magic[4] = { 'T', 'G', 'G', 'B' };
+static const uint32_t s_version = 1;
+
+struct BundleHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entries;
+    uint32_t dataSize;
+};
+
+struct BundleEntry {
+    uint64_t key;
+    uint32_t offset;
+    uint16_t width;
+    uint16_t height;
+};
+
+uint64_t GlyphBundle::key(const unsigned char* _cell, size_t _stride,
+                          uint16_t _width, uint16_t _height, float _sdfRadius) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&](const unsigned char* _bytes, size_t _length) {
+        for (size_t i = 0; i < _length; i++) {
+            hash = (hash ^ _bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    add(reinterpret_cast<const unsigned char*>(&_width), sizeof(_width));
+    add(reinterpret_cast<const unsigned char*>(&_height), sizeof(_height));
+    add(reinterpret_cast<const unsigned char*>(&_sdfRadius), sizeof(_sdfRadius));
+
+    for (size_t y = 0; y < _height; y++) {
+        add(_cell + y * _stride, _width);
+    }
+    return hash;
+}
+
+bool GlyphBundle::load(const std::string& _path) {
+    std::ifstream file(_path, std::ifstream::ate | std::ifstream::binary);
+    if (!file.is_open()) {
+        LOGW("Failed to read glyph bundle at path: %s", _path.c_str());
+        return false;
+    }
+
+    std::vector<char> data(file.tellg());
+    file.seekg(std::ifstream::beg);
+    file.read(data.data(), data.size());
+
+    if (!parse(data)) {
+        LOGW("Invalid glyph bundle: %s", _path.c_str());
+        return false;
+    }
+    LOGD("Loaded %d glyphs from bundle: %s", int(m_entries.size()), _path.c_str());
+    return true;
+}
+
+bool GlyphBundle::parse(const std::vector<char>& _data) {
+    BundleHeader header;
+    if (_data.size() < sizeof(header)) { return false; }
+
+    std::memcpy(&header, _data.data(), sizeof(header));
+    if (std::memcmp(header.magic, s_magic, sizeof(s_magic)) != 0 ||
+        header.version != s_version) {
+        return false;
+    }
+
+    size_t entriesSize = size_t(header.entries) * sizeof(BundleEntry);
+    if (_data.size() != sizeof(header) + entriesSize + header.dataSize) { return false; }
+
+    const char* entries = _data.data() + sizeof(header);
+    const char* data = entries + entriesSize;
+
+    m_entries.clear();
+    m_entries.reserve(header.entries);
+
+    for (size_t i = 0; i < header.entries; i++) {
+        BundleEntry entry;
+        std::memcpy(&entry, entries + i * sizeof(BundleEntry), sizeof(entry));
+
+        if (size_t(entry.offset) + size_t(entry.width) * entry.height > header.dataSize) {
+            m_entries.clear();
+            return false;
+        }
+        m_entries[entry.key] = { entry.offset, entry.width, entry.height };
+    }
+
+    m_data.assign(data, data + header.dataSize);
+    return true;
+}
+
+const unsigned char* GlyphBundle::find(uint64_t _key, uint16_t _width, uint16_t _height) const {
+    auto it = m_entries.find(_key);
+    if (it == m_entries.end()) { return nullptr; }
+
+    // Guard against hash collisions of cells with different sizes
+    if (it->second.width != _width || it->second.height != _height) { return nullptr; }
+
+    return &m_data[it->second.offset];
+}
+
+void GlyphBundle::add(uint64_t _key, const unsigned char* _cell, size_t _stride,
+                      uint16_t _width, uint16_t _height) {
+    if (m_entries.find(_key) != m_entries.end()) { return; }
+
+    Entry entry{ uint32_t(m_data.size()), _width, _height };
+    for (size_t y = 0; y < _height; y++) {
+        m_data.insert(m_data.end(), _cell + y * _stride, _cell + y * _stride + _width);
+    }
+    m_entries.emplace(_key, entry);
+}
+
+std::vector<char> GlyphBundle::serialize() const {
+    BundleHeader header;
+    std::memcpy(header.magic, s_magic, sizeof(s_magic));
+    header.version = s_version;
+    header.entries = m_entries.size();
+    header.dataSize = m_data.size();
+
+    std::vector<char> out(sizeof(header) + m_entries.size() * sizeof(BundleEntry) + m_data.size());
+    char* pos = out.data();
+
+    std::memcpy(pos, &header, sizeof(header));
+    pos += sizeof(header);
+
+    for (const auto& it : m_entries) {
+        BundleEntry entry{ it.first, it.second.offset, it.second.width, it.second.height };
+        std::memcpy(pos, &entry, sizeof(entry));
+        pos += sizeof(entry);
+    }
+
+    if (!m_data.empty()) {
+        std::memcpy(pos, m_data.data(), m_data.size());
+    }
+    return out;
+}
+
+bool GlyphBundle::save(const std::string& _path) const {
+    std::ofstream file(_path, std::ofstream::binary);
+    if (!file.is_open()) {
+        LOGE("Failed to write glyph bundle at path: %s", _path.c_str());
+        return false;
+    }
+
+    auto data = serialize();
+    file.write(data.data(), data.size());
+    return file.good();
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/* GlyphBundle - Precomputed distance fields of glyph atlas cells
+ *
+ * Entries are keyed by the glyph bitmap as rendered into its atlas cell and by the
+ * SDF radius, so that FontContext can copy the distance field of a glyph instead of
+ * computing it. Bundles are written by the tangram-glyph-bundle tool and loaded
+ * with SceneOptions::glyphBundlePath.
+ */
+class GlyphBundle {
+
+public:
+
+    // Key of the cell of _width * _height bytes at _cell, rows _stride bytes apart
+    static uint64_t key(const unsigned char* _cell, size_t _stride,
+                        uint16_t _width, uint16_t _height, float _sdfRadius);
+
+    bool load(const std::string& _path);
+
+    bool parse(const std::vector<char>& _data);
+
+    // Returns the distance field of the cell or nullptr when it is not in the bundle
+    const unsigned char* find(uint64_t _key, uint16_t _width, uint16_t _height) const;
+
+    // Store the distance field of a cell
+    void add(uint64_t _key, const unsigned char* _cell, size_t _stride,
+             uint16_t _width, uint16_t _height);
+
+    std::vector<char> serialize() const;
+
+    bool save(const std::string& _path) const;
+
+    size_t size() const { return m_entries.size(); }
+
+private:
+
+    struct Entry {
+        uint32_t offset;
+        uint16_t width;
+        uint16_t height;
+    };
+
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::vector<unsigned char> m_data;
+};
+
+}
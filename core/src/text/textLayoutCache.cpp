@@ -0,0 +1,86 @@
+#include "text/textLayoutCache.h"
+
+#include "util/hash.h"
+
+namespace Tangram {
+
+size_t TextLayoutCache::KeyHash::operator()(const Key& _key) const {
+    std::size_t seed = 0;
+    hash_combine(seed, _key.font);
+    hash_combine(seed, _key.fontScale);
+    hash_combine(seed, _key.text.hashCode());
+    hash_combine(seed, _key.maxLineWidth);
+    hash_combine(seed, _key.maxLines);
+    hash_combine(seed, _key.lineSpacing);
+    hash_combine(seed, _key.alignments);
+    return seed;
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::get(const Key& _key,
+                                                       const uint32_t* _atlasGenerations) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_cacheMap.find(_key);
+    if (it == m_cacheMap.end()) {
+        m_misses++;
+        return nullptr;
+    }
+
+    for (const auto& atlas : it->second->layout->atlases) {
+        if (_atlasGenerations[atlas.first] != atlas.second) {
+            erase(it);
+            m_misses++;
+            return nullptr;
+        }
+    }
+
+    // Move to front: most recently used
+    m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+    m_hits++;
+
+    return it->second->layout;
+}
+
+void TextLayoutCache::put(Key _key, std::shared_ptr<const TextLayout> _layout) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_maxEntries == 0 || !_layout) { return; }
+
+    auto it = m_cacheMap.find(_key);
+    if (it != m_cacheMap.end()) { erase(it); }
+
+    size_t memoryUsage = sizeof(CacheEntry) + sizeof(TextLayout) +
+        _key.text.length() * sizeof(char16_t) +
+        _layout->quads.size() * sizeof(GlyphQuad) +
+        _layout->atlases.size() * sizeof(decltype(_layout->atlases)::value_type);
+
+    m_cacheList.push_front({_key, std::move(_layout), memoryUsage});
+    m_cacheMap.emplace(std::move(_key), m_cacheList.begin());
+    m_memoryUsage += memoryUsage;
+
+    while (m_cacheList.size() > m_maxEntries) {
+        erase(m_cacheMap.find(m_cacheList.back().key));
+    }
+}
+
+void TextLayoutCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_cacheMap.clear();
+    m_cacheList.clear();
+    m_memoryUsage = 0;
+}
+
+TextLayoutCache::Stats TextLayoutCache::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return { m_hits, m_misses, m_cacheList.size(), m_memoryUsage };
+}
+
+void TextLayoutCache::erase(CacheMap::iterator _it) {
+    m_memoryUsage -= _it->second->memoryUsage;
+    m_cacheList.erase(_it->second);
+    m_cacheMap.erase(_it);
+}
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "labels/textLabel.h"
+
+#include "glm/vec2.hpp"
+#include "unicode/unistr.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace alfons {
+class Font;
+}
+
+namespace Tangram {
+
+/* Glyph quads of a laid out text, centered around 0/0 */
+struct TextLayout {
+    std::vector<GlyphQuad> quads;
+
+    // Quad ranges of the alignments, relative to the first quad
+    TextRange textRanges;
+
+    glm::vec2 size;
+
+    // Glyph atlases referenced by the quads and their generation when the text
+    // was laid out. The layout is stale once one of these atlases was cleared.
+    std::vector<std::pair<size_t, uint32_t>> atlases;
+};
+
+/* TextLayoutCache - Keeps the layouts of recently shaped texts, so that label
+ * strings repeated across features, tiles and zoom levels are only shaped once.
+ *
+ * The cache is owned by the FontContext and shared by all tile workers.
+ */
+class TextLayoutCache {
+
+public:
+
+    struct Key {
+        const alfons::Font* font;
+        float fontScale;
+        icu::UnicodeString text;
+        // Zero when the text is not wrapped
+        float maxLineWidth;
+        uint32_t maxLines;
+        float lineSpacing;
+        // Bit set of the TextLabelProperty::Align values to lay out
+        uint8_t alignments;
+
+        bool operator==(const Key& _other) const {
+            return font == _other.font &&
+                fontScale == _other.fontScale &&
+                maxLineWidth == _other.maxLineWidth &&
+                maxLines == _other.maxLines &&
+                lineSpacing == _other.lineSpacing &&
+                alignments == _other.alignments &&
+                text == _other.text;
+        }
+    };
+
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t entries;
+        size_t memoryUsage;
+    };
+
+    explicit TextLayoutCache(size_t _maxEntries) : m_maxEntries(_maxEntries) {}
+
+    // Returns the layout stored for _key, or nullptr when there is none or when it refers
+    // to a glyph atlas whose generation in _atlasGenerations changed since it was stored.
+    std::shared_ptr<const TextLayout> get(const Key& _key, const uint32_t* _atlasGenerations);
+
+    // Stores _layout, evicting the least recently used entries when the cache is full.
+    void put(Key _key, std::shared_ptr<const TextLayout> _layout);
+
+    void clear();
+
+    Stats stats() const;
+
+private:
+
+    struct KeyHash {
+        size_t operator()(const Key& _key) const;
+    };
+
+    struct CacheEntry {
+        Key key;
+        std::shared_ptr<const TextLayout> layout;
+        size_t memoryUsage;
+    };
+
+    using CacheList = std::list<CacheEntry>;
+    using CacheMap = std::unordered_map<Key, CacheList::iterator, KeyHash>;
+
+    void erase(CacheMap::iterator _it);
+
+    mutable std::mutex m_mutex;
+
+    CacheMap m_cacheMap;
+    CacheList m_cacheList;
+
+    size_t m_maxEntries;
+    size_t m_memoryUsage = 0;
+
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+};
+
+}
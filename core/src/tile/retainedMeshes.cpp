@@ -0,0 +1,71 @@
+#include "tile/retainedMeshes.h"
+
+#include "data/tileSource.h"
+#include "scene/scene.h"
+#include "style/style.h"
+#include "tile/tile.h"
+#include "tile/tileManager.h"
+
+namespace Tangram {
+
+// Label meshes refer to the glyph atlas and sprites of their Scene, rasters to the tile's
+// raster sources: only plain geometry can be drawn by the styles of another Scene.
+static bool isReusable(Style& _style) {
+    return _style.type() == StyleType::polygon || _style.type() == StyleType::polyline;
+}
+
+void RetainedMeshes::add(const Scene& _scene) {
+
+    auto* tileManager = _scene.tileManager();
+    if (!tileManager) { return; }
+
+    const auto& styleHashes = _scene.styleHashes();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto& tile : tileManager->getVisibleTiles()) {
+
+        auto source = _scene.getTileSource(tile->sourceID());
+        if (!source) { source = tileManager->getClientTileSource(tile->sourceID()); }
+        if (!source || source->cacheKey().empty()) { continue; }
+
+        auto entry = std::make_shared<Entry>();
+        entry->pixelScale = _scene.pixelScale();
+        entry->selectionFeatures = tile->getSelectionFeatures();
+
+        for (const auto& style : _scene.styles()) {
+            if (!isReusable(*style)) { continue; }
+
+            auto hash = styleHashes.find(style->getName());
+            if (hash == styleHashes.end()) { continue; }
+
+            // Empty meshes are retained as well, so that they are not rebuilt either
+            entry->meshes[style->getName()] = { hash->second, tile->getMesh(*style) };
+        }
+
+        m_entries[Key{source->cacheKey(), tile->sourceGeneration(), tile->getID()}] = entry;
+    }
+}
+
+std::shared_ptr<const RetainedMeshes::Entry> RetainedMeshes::get(const std::string& _source,
+                                                                 int64_t _generation,
+                                                                 TileID _tileId) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(Key{_source, _generation, _tileId});
+    if (it == m_entries.end()) { return nullptr; }
+
+    return it->second;
+}
+
+void RetainedMeshes::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+bool RetainedMeshes::empty() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.empty();
+}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "tile/tileID.h"
+#include "util/fastmap.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace Tangram {
+
+class Scene;
+struct Properties;
+struct StyledMesh;
+
+/* RetainedMeshes - Keeps the meshes of the visible tiles of a replaced Scene, so that
+ * the TileBuilder of the next Scene only rebuilds the meshes of styles whose dependencies
+ * (see SceneLoader::applyStyleDependencies) were changed by the scene update.
+ */
+class RetainedMeshes {
+
+public:
+
+    struct Entry {
+        struct Mesh {
+            size_t styleHash;
+            std::shared_ptr<StyledMesh> mesh;
+        };
+        // Meshes by style name
+        fastmap<std::string, Mesh> meshes;
+        fastmap<uint32_t, std::shared_ptr<Properties>> selectionFeatures;
+        float pixelScale = 1.f;
+    };
+
+    // Retain the meshes of reusable styles from the visible tiles of _scene.
+    // Must be called on the main thread.
+    void add(const Scene& _scene);
+
+    // Returns the retained meshes of a tile built from the same TileData or nullptr.
+    std::shared_ptr<const Entry> get(const std::string& _source, int64_t _generation,
+                                     TileID _tileId) const;
+
+    // Release all meshes, e.g. when the tiles of the next Scene are built.
+    void clear();
+
+    bool empty() const;
+
+private:
+
+    using Key = std::tuple<std::string, int64_t, TileID>;
+
+    mutable std::mutex m_mutex;
+
+    std::map<Key, std::shared_ptr<const Entry>> m_entries;
+};
+
+}
@@ -58,7 +58,7 @@ void Tile::resetState() {
     }
 }
 
-void Tile::setMesh(const Style& _style, std::unique_ptr<StyledMesh> _mesh) {
+void Tile::setMesh(const Style& _style, std::shared_ptr<StyledMesh> _mesh) {
     size_t id = _style.getID();
     if (id >= m_geometry.size()) {
         m_geometry.resize(id+1);
@@ -66,8 +66,8 @@ void Tile::setMesh(const Style& _style, std::unique_ptr<StyledMesh> _mesh) {
     m_geometry[_style.getID()] = std::move(_mesh);
 }
 
-const std::unique_ptr<StyledMesh>& Tile::getMesh(const Style& _style) const {
-    static std::unique_ptr<StyledMesh> NONE = nullptr;
+const std::shared_ptr<StyledMesh>& Tile::getMesh(const Style& _style) const {
+    static std::shared_ptr<StyledMesh> NONE = nullptr;
     if (_style.getID() >= m_geometry.size()) { return NONE; }
 
     return m_geometry[_style.getID()];
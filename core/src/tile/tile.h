@@ -63,9 +63,9 @@ public:
 
     void initGeometry(uint32_t _size);
 
-    const std::unique_ptr<StyledMesh>& getMesh(const Style& _style) const;
+    const std::shared_ptr<StyledMesh>& getMesh(const Style& _style) const;
 
-    void setMesh(const Style& _style, std::unique_ptr<StyledMesh> _mesh);
+    void setMesh(const Style& _style, std::shared_ptr<StyledMesh> _mesh);
 
     void setSelectionFeatures(const fastmap<uint32_t, std::shared_ptr<Properties>> _selectionFeatures);
 
@@ -115,8 +115,9 @@ private:
 
     glm::mat4 m_mvp;
 
-    // Map of <Style>s and their associated <Mesh>es
-    std::vector<std::unique_ptr<StyledMesh>> m_geometry;
+    // Map of <Style>s and their associated <Mesh>es. Meshes are shared with the
+    // tiles of a replaced Scene when their style was not affected by the update.
+    std::vector<std::shared_ptr<StyledMesh>> m_geometry;
     std::vector<Raster> m_rasters;
 
     mutable size_t m_memoryUsage = 0;
@@ -8,7 +8,9 @@
 #include "scene/dataLayer.h"
 #include "scene/scene.h"
 #include "selection/featureSelection.h"
+#include "tile/retainedMeshes.h"
 #include "tile/tile.h"
+#include "util/builders.h"
 #include "util/mapProjection.h"
 #include "view/view.h"
 
@@ -42,7 +44,7 @@ StyleBuilder* TileBuilder::getStyleBuilder(const std::string& _name) {
     return it->second.get();
 }
 
-void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer) {
+void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer, int32_t _sourceId) {
 
     // If no rules matched the feature, return immediately
     if (!m_ruleSet.match(_feature, _layer, *m_styleContext)) { return; }
@@ -61,6 +63,8 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
             continue;
         }
 
+        if (isReused(style)) { continue; }
+
         // Apply default draw rules defined for this style
         style->style().applyDefaultDrawRules(rule);
 
@@ -86,7 +90,7 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
             auto* outlineStyle = getStyleBuilder(styleName);
             if (!outlineStyle) {
                 LOGN("Invalid style %s", styleName.c_str());
-            } else {
+            } else if (!isReused(outlineStyle)) {
                 rule.isOutlineOnly = true;
                 outlineStyle->addFeature(_feature, rule);
                 rule.isOutlineOnly = false;
@@ -98,7 +102,48 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
     }
 
     if (added && (selectionColor != 0)) {
-        m_selectionFeatures[selectionColor] = std::make_shared<Properties>(_feature.props);
+        auto props = std::make_shared<Properties>(_feature.props);
+        // TileData may be shared with sources of other ids that parsed it first
+        props->sourceId = _sourceId;
+        m_selectionFeatures[selectionColor] = std::move(props);
+    }
+}
+
+void TileBuilder::reuseMeshes(Tile& _tile, const TileSource& _source) {
+
+    m_reusedStyles.clear();
+
+    auto* retainedMeshes = m_scene.retainedMeshes();
+    if (!retainedMeshes || _source.cacheKey().empty()) { return; }
+
+    auto retained = retainedMeshes->get(_source.cacheKey(), _source.generation(), _tile.getID());
+    if (!retained || retained->pixelScale != m_scene.pixelScale()) { return; }
+
+    const auto& styleHashes = m_scene.styleHashes();
+
+    for (auto& builder : m_styleBuilder) {
+        const auto& name = builder.second->style().getName();
+
+        auto mesh = retained->meshes.find(name);
+        if (mesh == retained->meshes.end()) { continue; }
+
+        auto hash = styleHashes.find(name);
+        if (hash == styleHashes.end() || hash->second != mesh->second.styleHash) { continue; }
+
+        _tile.setMesh(builder.second->style(), mesh->second.mesh);
+        m_reusedStyles.push_back(builder.second.get());
+    }
+
+    if (!m_reusedStyles.empty()) {
+        // Reused meshes keep the selection colors of the previous Scene
+        for (const auto& feature : retained->selectionFeatures) {
+            auto props = feature.second;
+            if (props->sourceId != _source.id()) {
+                props = std::make_shared<Properties>(*props);
+                props->sourceId = _source.id();
+            }
+            m_selectionFeatures[feature.first] = std::move(props);
+        }
     }
 }
 
@@ -110,10 +155,15 @@ std::unique_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
 
     tile->initGeometry(int(m_scene.styles().size()));
 
+    reuseMeshes(*tile, _source);
+
     m_styleContext->setZoom(_tileID.s);
 
     for (auto& builder : m_styleBuilder) {
-        if (builder.second) { builder.second->setup(*tile); }
+        if (builder.second) {
+            builder.second->setup(*tile);
+            builder.second->setTessellationCache(_tileData.tessellations.get());
+        }
     }
 
     for (const auto& datalayer : m_scene.layers()) {
@@ -131,7 +181,7 @@ std::unique_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
             }
 
             for (const auto& feat : collection.features) {
-                applyStyling(feat, datalayer);
+                applyStyling(feat, datalayer, _source.id());
             }
         }
     }
@@ -146,7 +196,10 @@ std::unique_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
     m_labelLayout.process(_tileID, tile->getInverseScale(), tileSize);
 
     for (auto& builder : m_styleBuilder) {
-        tile->setMesh(builder.second->style(), builder.second->build());
+        if (!isReused(builder.second.get())) {
+            tile->setMesh(builder.second->style(), builder.second->build());
+        }
+        builder.second->setTessellationCache(nullptr);
     }
 
     tile->setSelectionFeatures(m_selectionFeatures);
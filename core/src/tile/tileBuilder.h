@@ -6,6 +6,8 @@
 #include "scene/drawRule.h"
 #include "style/style.h"
 
+#include <algorithm>
+
 namespace Tangram {
 
 class DataLayer;
@@ -34,8 +36,8 @@ public:
 
 private:
 
-    // Determine and apply DrawRules for a @_feature
-    void applyStyling(const Feature& _feature, const SceneLayer& _layer);
+    // Determine and apply DrawRules for a @_feature of the source with id @_sourceId
+    void applyStyling(const Feature& _feature, const SceneLayer& _layer, int32_t _sourceId);
 
     const Scene& m_scene;
 
@@ -47,6 +49,16 @@ private:
     fastmap<std::string, std::unique_ptr<StyleBuilder>> m_styleBuilder;
 
     fastmap<uint32_t, std::shared_ptr<Properties>> m_selectionFeatures;
+
+    // StyleBuilders whose mesh for the current tile is reused from the previous Scene
+    std::vector<const StyleBuilder*> m_reusedStyles;
+
+    bool isReused(const StyleBuilder* _style) const {
+        return std::find(m_reusedStyles.begin(), m_reusedStyles.end(), _style) != m_reusedStyles.end();
+    }
+
+    // Set meshes of the previous Scene for styles that are not affected by the scene changes
+    void reuseMeshes(Tile& _tile, const TileSource& _source);
 };
 
 }
@@ -1,5 +1,6 @@
 #include "tile/tileManager.h"
 
+#include "data/rasterSource.h"
 #include "data/tileSource.h"
 #include "map.h"
 #include "platform.h"
@@ -16,7 +17,6 @@
 
 namespace Tangram {
 
-
 enum class TileManager::ProxyID : uint8_t {
     no_proxies = 0,
     child1 = 1 << 0,
@@ -155,7 +155,12 @@ TileManager::TileManager(Platform& platform, TileTaskQueue& _tileWorker) :
     // Callback to pass task from Download-Thread to Worker-Queue
     m_dataCallback = TileTaskCb{[&](std::shared_ptr<TileTask> task) {
 
-        if (task->isReady()) {
+        if (task->dataChanged()) {
+            // Reloaded on the next update
+            if (auto source = task->source()) { source->tileDataChanged(*task); }
+            platform.requestRender();
+
+        } else if (task->isReady()) {
              platform.requestRender();
 
         } else if (task->hasData()) {
@@ -190,6 +195,7 @@ void TileManager::setTileSources(const std::vector<std::shared_ptr<TileSource>>&
         });
 
     m_tileSets.erase(it, m_tileSets.end());
+    m_tileSetsDirty = true;
 
     // add new sources
     for (const auto& source : _sources) {
@@ -225,6 +231,7 @@ void TileManager::addClientTileSource(std::shared_ptr<TileSource> _tileSource) {
 
     if (it == m_tileSets.end()) {
         m_tileSets.emplace_back(_tileSource, true);
+        m_tileSetsDirty = true;
     }
 }
 
@@ -235,6 +242,7 @@ bool TileManager::removeClientTileSource(int32_t _sourceId) {
 
     if (it != m_tileSets.end()) {
         m_tileSets.erase(it);
+        m_tileSetsDirty = true;
         return true;
     }
     return false;
@@ -250,6 +258,7 @@ void TileManager::cancelTileTasks() {
     }
 
     m_tileCache->clear();
+    m_tileSetsDirty = true;
 }
 
 void TileManager::clearTileSets(bool clearSourceCaches) {
@@ -265,6 +274,7 @@ void TileManager::clearTileSets(bool clearSourceCaches) {
     }
 
     m_tileCache->clear();
+    m_tileSetsDirty = true;
 }
 
 void TileManager::clearTileSet(int32_t _sourceId) {
@@ -277,36 +287,121 @@ void TileManager::clearTileSet(int32_t _sourceId) {
 
     m_tileCache->clear();
     m_tileSetChanged = true;
+    m_tileSetsDirty = true;
+}
+
+void TileManager::addSourceTiles(const TileSource& _source, const std::vector<TileID>& _viewTiles,
+                                 std::vector<TileID>& _tiles) {
+    auto zoomBias = _source.zoomBias();
+    auto maxZoom = _source.maxZoom();
+
+    for (const auto& tileID : _viewTiles) {
+        _tiles.push_back(tileID.zoomBiasAdjusted(zoomBias).withMaxSourceZoom(maxZoom));
+    }
+}
+
+void TileManager::sortUnique(std::vector<TileID>& _tiles) {
+    std::sort(_tiles.begin(), _tiles.end());
+    _tiles.erase(std::unique(_tiles.begin(), _tiles.end()), _tiles.end());
+}
+
+bool TileManager::containsTile(const std::vector<TileID>& _tiles, const TileID& _tileID) {
+    return std::binary_search(_tiles.begin(), _tiles.end(), _tileID);
+}
+
+static bool isTileSetActive(const TileSource& _source, float _zoom) {
+    // check if tile set is active for zoom (zoom might be below min_zoom)
+    return _source.isActiveForZoom(_zoom) && _source.isVisible();
+}
+
+bool TileManager::needsUpdate(const View& _view) const {
+
+    if (m_tileSetsDirty || m_tilesInProgress > 0 || !m_prefetchPath.empty()) { return true; }
+
+    const auto& view = _view.state();
+    if (view.changedOnLastUpdate ||
+        view.center != m_viewState.center ||
+        view.zoom != m_viewState.zoom ||
+        view.viewportSize != m_viewState.viewportSize ||
+        view.tileSize != m_viewState.tileSize ||
+        view.roll != m_viewState.roll ||
+        view.pitch != m_viewState.pitch) {
+        return true;
+    }
+
+    for (const auto& tileSet : m_tileSets) {
+        if (tileSet.sourceGeneration != tileSet.source->generation() ||
+            tileSet.active != isTileSetActive(*tileSet.source, view.zoom) ||
+            tileSet.source->hasChangedTiles()) {
+            return true;
+        }
+        for (const auto& raster : tileSet.source->rasterSources()) {
+            if (raster->hasChangedTiles()) { return true; }
+        }
+    }
+    return false;
 }
 
 void TileManager::updateTileSets(const View& _view) {
 
+    m_viewState = _view.state();
+    m_tileSetsDirty = false;
+
     m_tiles.clear();
     m_tilesInProgress = 0;
     m_tileSetChanged = false;
 
     if (!getDebugFlag(DebugFlags::freeze_tiles)) {
 
+        auto viewTilesCb = [&](TileID _tileID){ m_viewTiles.push_back(_tileID); };
+
+        m_viewTiles.clear();
+        _view.getVisibleTiles(viewTilesCb);
+
         for (auto& tileSet : m_tileSets) {
             tileSet.visibleTiles.clear();
+            tileSet.prefetchTiles.clear();
+
+            // Insert scaled and maxZoom mapped tileIDs in the visible set
+            addSourceTiles(*tileSet.source, m_viewTiles, tileSet.visibleTiles);
+            sortUnique(tileSet.visibleTiles);
         }
 
-        auto tileCb = [&, zoom = _view.getZoom()](TileID _tileID){
-            for (auto& tileSet : m_tileSets) {
-                auto zoomBias = tileSet.source->zoomBias();
-                auto maxZoom = tileSet.source->maxZoom();
+        for (const auto& position : m_prefetchPath) {
+            View view = _view;
+            view.setPosition(position.x, position.y);
+            view.setZoom(position.z);
+            view.update();
 
-                // Insert scaled and maxZoom mapped tileID in the visible set
-                tileSet.visibleTiles.insert(_tileID.zoomBiasAdjusted(zoomBias).withMaxSourceZoom(maxZoom));
+            m_viewTiles.clear();
+            view.getVisibleTiles(viewTilesCb);
+
+            for (auto& tileSet : m_tileSets) {
+                if (tileSet.source->isActiveForZoom(view.getZoom())) {
+                    addSourceTiles(*tileSet.source, m_viewTiles, tileSet.prefetchTiles);
+                }
             }
-        };
+        }
 
-        _view.getVisibleTiles(tileCb);
+        if (!m_prefetchPath.empty()) {
+            for (auto& tileSet : m_tileSets) {
+                auto& prefetchTiles = tileSet.prefetchTiles;
+                sortUnique(prefetchTiles);
+
+                prefetchTiles.erase(std::remove_if(prefetchTiles.begin(), prefetchTiles.end(),
+                                                   [&](const TileID& _tileID) {
+                                                       return containsTile(tileSet.visibleTiles, _tileID);
+                                                   }),
+                                    prefetchTiles.end());
+            }
+        }
     }
 
     for (auto& tileSet : m_tileSets) {
-        // check if tile set is active for zoom (zoom might be below min_zoom)
-        if (tileSet.source->isActiveForZoom(_view.getZoom()) && tileSet.source->isVisible()) {
+        tileSet.active = isTileSetActive(*tileSet.source, _view.getZoom());
+        tileSet.sourceGeneration = tileSet.source->generation();
+
+        if (tileSet.active) {
             updateTileSet(tileSet, _view.state());
         }
     }
@@ -329,10 +424,6 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
 
     bool newTiles = false;
 
-    if (_tileSet.sourceGeneration != _tileSet.source->generation()) {
-        _tileSet.sourceGeneration = _tileSet.source->generation();
-    }
-
     // Tile load request above this zoom-level will be canceled in order to
     // not wait for tiles that are too small to contribute significantly to
     // the current view.
@@ -349,7 +440,10 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
             clearProxyTiles(_tileSet, it.first, entry, removeTiles);
 
             newTiles = true;
-            m_tileSetChanged = true;
+            // Prefetched tiles do not change the rendered tile set
+            if (entry.isVisible() || entry.getProxyCounter() > 0) {
+                m_tileSetChanged = true;
+            }
         }
     }
 
@@ -375,6 +469,7 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
                    curTilesIt != tiles.end());
 
             auto& entry = curTilesIt->second;
+            bool prefetched = !entry.isVisible() && entry.getProxyCounter() <= 0;
             entry.setVisible(true);
 
             if (entry.tile) {
@@ -409,8 +504,8 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
                 m_tilesInProgress++;
             }
 
-            if (newTiles && entry.isInProgress()) {
-                // check again for proxies
+            if ((newTiles || prefetched) && entry.isInProgress()) {
+                // check again for proxies, a prefetched tile has none yet
                 updateProxyTiles(_tileSet, visTileId, entry);
             }
 
@@ -437,6 +532,7 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
             assert(curTilesIt != tiles.end());
 
             auto& entry = curTilesIt->second;
+            bool prefetch = containsTile(_tileSet.prefetchTiles, curTileId);
 
             if (entry.getProxyCounter() > 0) {
                 if (entry.tile) {
@@ -449,6 +545,13 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
                         entry.clearTask();
                     }
                 }
+            } else if (prefetch) {
+                if (entry.needsLoading()) {
+                    if (!entry.task) {
+                        entry.task = _tileSet.source->createTask(curTileId);
+                    }
+                    enqueueTask(_tileSet, curTileId, _view, true);
+                }
             } else {
                 removeTiles.push_back(curTileId);
             }
@@ -462,12 +565,17 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
         removeTiles.pop_back();
 
         if ((it != tiles.end()) && (!it->second.isVisible()) &&
-            (it->second.getProxyCounter() <= 0)) {
+            (it->second.getProxyCounter() <= 0) &&
+            !containsTile(_tileSet.prefetchTiles, it->first)) {
             clearProxyTiles(_tileSet, it->first, it->second, removeTiles);
             removeTile(_tileSet, it);
         }
     }
 
+    reloadChangedTiles(_tileSet, _view);
+
+    addPrefetchTiles(_tileSet, _view);
+
     for (auto& it : tiles) {
         auto& entry = it.second;
 
@@ -497,9 +605,20 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
 
             // Update tile distance to map center for load priority.
             auto tileCenter = MapProjection::tileCenter(id);
-            double scaleDiv = exp2(id.z - _view.zoom);
-            if (scaleDiv < 1) { scaleDiv = 0.1/scaleDiv; } // prefer parent tiles
-            task->setPriority(glm::length2(tileCenter - _view.center) * scaleDiv);
+            double priority = glm::length2(tileCenter - _view.center);
+            bool prefetch = !entry.isVisible() && entry.getProxyCounter() <= 0;
+            if (!prefetch) {
+                double scaleDiv = exp2(id.z - _view.zoom);
+                if (scaleDiv < 1) { scaleDiv = 0.1/scaleDiv; } // prefer parent tiles
+                priority *= std::min(scaleDiv, TileTask::max_priority_scale);
+            }
+            // Reorder pending requests when the view changed
+            bool changed = float(priority) != float(task->getPriority()) ||
+                prefetch != task->isPrefetch();
+            task->setPriority(priority, prefetch);
+            if (changed && !task->needsLoading()) {
+                _tileSet.source->updateTaskPriority(*task);
+            }
             task->setProxyState(entry.getProxyCounter() > 0);
         }
 
@@ -510,19 +629,72 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
     }
 }
 
+void TileManager::reloadChangedTiles(TileSet& _tileSet, const ViewState& _view) {
+
+    auto& source = *_tileSet.source;
+
+    auto changedTiles = source.takeChangedTiles();
+    for (auto& raster : source.rasterSources()) {
+        auto rasterTiles = raster->takeChangedTiles();
+        changedTiles.insert(changedTiles.end(), rasterTiles.begin(), rasterTiles.end());
+    }
+    if (changedTiles.empty()) { return; }
+
+    for (const auto& changed : changedTiles) {
+        // Not reused from the cache
+        m_tileCache->get(source.id(), changed);
+    }
+
+    for (auto& it : _tileSet.tiles) {
+        auto& id = it.first;
+        auto& entry = it.second;
+        if (!entry.tile || entry.isInProgress()) { continue; }
+
+        // Rasters of a tile may be of a lower zoom
+        bool changed = std::any_of(changedTiles.begin(), changedTiles.end(), [&](const TileID& _changed) {
+            int dz = id.z - _changed.z;
+            return dz >= 0 && (id.x >> dz) == _changed.x && (id.y >> dz) == _changed.y;
+        });
+        if (!changed) { continue; }
+
+        bool prefetch = !entry.isVisible() && entry.getProxyCounter() <= 0;
+        entry.task = source.createTask(id);
+        enqueueTask(_tileSet, id, _view, prefetch);
+        if (!prefetch) { m_tilesInProgress++; }
+    }
+}
+
 void TileManager::enqueueTask(TileSet& _tileSet, const TileID& _tileID,
-                              const ViewState& _view) {
+                              const ViewState& _view, bool _prefetch) {
 
-    // Keep the items sorted by distance
+    // Keep the items sorted by distance, prefetched tiles last
     auto tileCenter = MapProjection::tileCenter(_tileID);
     double distance = glm::length2(tileCenter - _view.center);
 
-    auto it = std::upper_bound(m_loadTasks.begin(), m_loadTasks.end(), distance,
-                               [](auto& distance, auto& other){
-                                   return distance < std::get<0>(other);
+    auto it = std::upper_bound(m_loadTasks.begin(), m_loadTasks.end(),
+                               std::make_tuple(_prefetch, distance),
+                               [](auto& order, auto& other){
+                                   return order < std::make_tuple(std::get<0>(other),
+                                                                  std::get<1>(other));
                                });
 
-    m_loadTasks.insert(it, std::make_tuple(distance, &_tileSet, _tileID));
+    m_loadTasks.insert(it, std::make_tuple(_prefetch, distance, &_tileSet, _tileID));
+}
+
+void TileManager::addPrefetchTiles(TileSet& _tileSet, const ViewState& _view) {
+
+    for (const auto& tileID : _tileSet.prefetchTiles) {
+        if (_tileSet.tiles.find(tileID) != _tileSet.tiles.end()) { continue; }
+
+        auto cached = m_tileCache->contains(_tileSet.source->id(), tileID);
+        if (cached && cached->sourceGeneration() == _tileSet.source->generation()) { continue; }
+
+        std::shared_ptr<Tile> tile;
+        auto entry = _tileSet.tiles.emplace(tileID, tile);
+        entry.first->second.task = _tileSet.source->createTask(tileID);
+
+        enqueueTask(_tileSet, tileID, _view, true);
+    }
 }
 
 void TileManager::loadTiles() {
@@ -531,8 +703,8 @@ void TileManager::loadTiles() {
 
     for (auto& loadTask : m_loadTasks) {
 
-        auto tileId = std::get<2>(loadTask);
-        auto& tileSet = *std::get<1>(loadTask);
+        auto tileId = std::get<3>(loadTask);
+        auto& tileSet = *std::get<2>(loadTask);
         auto tileIt = tileSet.tiles.find(tileId);
         auto& entry = tileIt->second;
 
@@ -6,12 +6,14 @@
 #include "tile/tileID.h"
 #include "tile/tileTask.h"
 #include "tile/tileWorker.h"
+#include "view/view.h"
+
+#include "glm/vec3.hpp"
 
 #include <map>
 #include <memory>
 #include <mutex>
 #include <tuple>
-#include <set>
 #include <vector>
 
 class Platform;
@@ -20,8 +22,6 @@ namespace Tangram {
 
 class TileSource;
 class TileCache;
-class View;
-struct ViewState;
 
 /* Singleton container of <TileSet>s
  *
@@ -44,6 +44,24 @@ public:
     /* Updates visible tile set and load missing tiles */
     void updateTileSets(const View& _view);
 
+    /* Returns false when updateTileSets would not change the visible tiles: the
+     * view and the sources are unchanged since the last update and no tile is loading
+     */
+    bool needsUpdate(const View& _view) const;
+
+    /* Makes the next update a full one, e.g. to refill the label meshes after the
+     * GL context was recreated */
+    void setNeedsUpdate() { m_tileSetsDirty = true; }
+
+    /* Sets the camera positions (x and y in projected meters, zoom) the view is predicted
+     * to pass through. Tiles visible from these positions are loaded with low priority
+     * and their loading is canceled once they are no longer on the predicted path.
+     */
+    void setPrefetchPath(std::vector<glm::dvec3> _path) {
+        if (!_path.empty() || !m_prefetchPath.empty()) { m_tileSetsDirty = true; }
+        m_prefetchPath = std::move(_path);
+    }
+
     void clearTileSets(bool clearSourceCaches = false);
 
     void clearTileSet(int32_t _sourceId);
@@ -84,12 +102,19 @@ protected:
 
         std::shared_ptr<TileSource> source;
 
-        std::set<TileID> visibleTiles;
+        // Sorted unique IDs of the tiles in view and on the prefetch path;
+        // refilled every frame, keeping their capacity
+        std::vector<TileID> visibleTiles;
+        std::vector<TileID> prefetchTiles;
         std::map<TileID, TileEntry> tiles;
 
-        int64_t sourceGeneration = 0;
         bool clientTileSource;
 
+        // Generation of the source at the last update, and whether the source was
+        // visible and active for the zoom of the last update
+        int64_t sourceGeneration = 0;
+        bool active = false;
+
         TileSet(const TileSet&) = delete;
         TileSet(TileSet&&) = default;
         TileSet& operator=(const TileSet&) = delete;
@@ -98,7 +123,24 @@ protected:
 
     void updateTileSet(TileSet& tileSet, const ViewState& _view);
 
-    void enqueueTask(TileSet& _tileSet, const TileID& _tileID, const ViewState& _view);
+    /* Appends the IDs of _viewTiles mapped to the zoom bias and max zoom of _source */
+    static void addSourceTiles(const TileSource& _source, const std::vector<TileID>& _viewTiles,
+                               std::vector<TileID>& _tiles);
+
+    static void sortUnique(std::vector<TileID>& _tiles);
+
+    static bool containsTile(const std::vector<TileID>& _tiles, const TileID& _tileID);
+
+    void enqueueTask(TileSet& _tileSet, const TileID& _tileID, const ViewState& _view,
+                     bool _prefetch = false);
+
+    /* Reloads the loaded tiles of _tileSet whose data, or the data of their rasters,
+     * changed on revalidation. Their current tiles are shown until the reload is ready.
+     */
+    void reloadChangedTiles(TileSet& _tileSet, const ViewState& _view);
+
+    /* Adds the tiles on the prefetch path that are neither loaded nor cached */
+    void addPrefetchTiles(TileSet& _tileSet, const ViewState& _view);
 
     void loadTiles();
 
@@ -131,6 +173,11 @@ protected:
 
     std::vector<TileSet> m_tileSets;
 
+    std::vector<glm::dvec3> m_prefetchPath;
+
+    /* Tiles of the view, before mapping them to the zoom levels of each source */
+    std::vector<TileID> m_viewTiles;
+
     /* Current tiles ready for rendering */
     std::vector<std::shared_ptr<Tile>> m_tiles;
 
@@ -140,13 +187,19 @@ protected:
 
     bool m_tileSetChanged = false;
 
+    /* Set when tile sets or the prefetch path changed since the last update */
+    bool m_tileSetsDirty = true;
+
+    /* View state of the last update */
+    ViewState m_viewState{};
+
     /* Callback for TileSource:
      * Passes TileTask back with data for further processing by <TileWorker>s
      */
     TileTaskCb m_dataCallback;
 
     /* Temporary list of tiles that need to be loaded */
-    std::vector<std::tuple<double, TileSet*, TileID>> m_loadTasks;
+    std::vector<std::tuple<bool, double, TileSet*, TileID>> m_loadTasks;
 
 };
 
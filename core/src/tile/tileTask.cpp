@@ -17,10 +17,24 @@ TileTask::TileTask(TileID& _tileId, std::shared_ptr<TileSource> _source) :
     m_canceled(false),
     m_needsLoading(true),
     m_priority(0),
+    m_prefetch(false),
     m_proxyState(false) {}
 
 TileTask::~TileTask() {}
 
+double TileTask::requestPriority() const {
+    double priority = getPriority();
+    if (!isPrefetch()) { return priority; }
+
+    // Scale prefetched priorities above the largest one of other tiles: the squared
+    // diagonal of the world in projected meters times the largest scale factor.
+    // Unlike adding an offset, scaling keeps the precision of their order.
+    static const double max_priority = 2 * MapProjection::EARTH_CIRCUMFERENCE_METERS *
+        MapProjection::EARTH_CIRCUMFERENCE_METERS * max_priority_scale;
+
+    return (priority + 2) * max_priority;
+}
+
 std::unique_ptr<Tile> TileTask::getTile() {
     return std::move(m_tile);
 }
@@ -35,7 +49,11 @@ void TileTask::process(TileBuilder& _tileBuilder) {
     auto source = m_source.lock();
     if (!source) { return; }
 
-    auto tileData = source->parse(*this);
+    // Parsed data is retained, and shared with tasks of sources loading the same data
+    auto tileData = m_tileData;
+    if (!tileData) {
+        tileData = source->parseTileData(*this);
+    }
 
     if (tileData) {
         m_tile = _tileBuilder.build(m_tileId, *tileData, *source);
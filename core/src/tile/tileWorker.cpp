@@ -83,7 +83,7 @@ void TileWorker::run(Worker* instance) {
                         a->sourceGeneration() != b->sourceGeneration()) {
                         return a->sourceGeneration() < b->sourceGeneration();
                     }
-                    return a->getPriority() < b->getPriority();
+                    return a->loadsBefore(*b);
                 });
 
             task = std::move(*it);
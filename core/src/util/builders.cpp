@@ -51,6 +51,104 @@ JoinTypes JoinTypeFromString(const std::string& str) {
     return JoinTypes::miter;
 }
 
+// 64-bit FNV-1a, independent of the width of size_t
+static void fnv1a(uint64_t& _hash, const void* _data, size_t _size) {
+    auto bytes = static_cast<const uint8_t*>(_data);
+    for (size_t i = 0; i < _size; i++) {
+        _hash ^= bytes[i];
+        _hash *= 0x100000001b3;
+    }
+}
+
+uint64_t TessellationCache::hash(const Polygon& _polygon) {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (auto& line : _polygon) {
+        uint32_t size = line.size();
+        fnv1a(hash, &size, sizeof(size));
+        for (auto& p : line) {
+            float xy[2] = { p.x, p.y };
+            fnv1a(hash, xy, sizeof(xy));
+        }
+    }
+    return hash;
+}
+
+static bool sameRings(const std::vector<uint32_t>& _sizes, const Polygon& _polygon) {
+    if (_sizes.size() != _polygon.size()) { return false; }
+    for (size_t i = 0; i < _sizes.size(); i++) {
+        if (_sizes[i] != _polygon[i].size()) { return false; }
+    }
+    return true;
+}
+
+static bool matches(const std::vector<uint32_t>& _sizes, const Polygon* _source, const Polygon& _polygon) {
+    return sameRings(_sizes, _polygon) && (_source == &_polygon || *_source == _polygon);
+}
+
+const std::vector<uint16_t>& TessellationCache::triangulate(const Polygon& _polygon, Earcut& _earcut) {
+
+    uint64_t key = hash(_polygon);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            if (matches(it->second.ringSizes, it->second.polygon, _polygon)) {
+                m_hits++;
+                return it->second.indices;
+            }
+            // Hash collision: triangulate without caching
+            _earcut(_polygon);
+            return _earcut.indices;
+        }
+    }
+
+    m_misses++;
+    _earcut(_polygon);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_entries.size() >= max_entries) { return _earcut.indices; }
+
+    std::vector<uint32_t> ringSizes;
+    ringSizes.reserve(_polygon.size());
+    for (auto& line : _polygon) { ringSizes.push_back(line.size()); }
+
+    // Another thread may have inserted an entry for the key meanwhile: keep it
+    auto result = m_entries.emplace(key, Entry{ std::move(ringSizes), &_polygon, _earcut.indices });
+    auto& entry = result.first->second;
+    if (!result.second && !matches(entry.ringSizes, entry.polygon, _polygon)) {
+        return _earcut.indices;
+    }
+
+    return entry.indices;
+}
+
+size_t TessellationCache::memoryUsage(const Polygon& _polygon) {
+    size_t points = 0;
+    for (auto& line : _polygon) { points += line.size(); }
+
+    // Earcut emits n - 2 + 2 * holes triangles for n points, bounded by n + 2 * rings
+    size_t triangles = points + 2 * _polygon.size();
+
+    // Map node with key and bucket pointer
+    return sizeof(Entry) + sizeof(uint64_t) + 2 * sizeof(void*) +
+        _polygon.size() * sizeof(uint32_t) + 3 * triangles * sizeof(uint16_t);
+}
+
+size_t TessellationCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+void TessellationCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
 void Builders::buildPolygon(const Polygon& _polygon, float _height, PolygonBuilder& _ctx) {
 
     glm::vec2 min, max;
@@ -66,8 +164,14 @@ void Builders::buildPolygon(const Polygon& _polygon, float _height, PolygonBuild
         }
     }
 
-    // Run earcut, triangles are stored in _ctx.earcut.indices
-    _ctx.earcut(_polygon);
+    // Run earcut or get the cached triangulation
+    const std::vector<uint16_t>* triangles;
+    if (_ctx.tessellationCache) {
+        triangles = &_ctx.tessellationCache->triangulate(_polygon, _ctx.earcut);
+    } else {
+        _ctx.earcut(_polygon);
+        triangles = &_ctx.earcut.indices;
+    }
 
     size_t sumPoints = 0;
     for (auto& line : _polygon) {
@@ -77,7 +181,7 @@ void Builders::buildPolygon(const Polygon& _polygon, float _height, PolygonBuild
     // Mark the points that are referenced by indices as used.
     size_t sumVertices = 0;
     _ctx.used.assign(sumPoints, 0);
-    for (auto i : _ctx.earcut.indices) {
+    for (auto i : *triangles) {
         if (_ctx.used[i] == 0) {
             _ctx.used[i] = 1;
             sumVertices++;
@@ -117,7 +221,7 @@ void Builders::buildPolygon(const Polygon& _polygon, float _height, PolygonBuild
         }
     }
 
-    for (auto i : _ctx.earcut.indices) {
+    for (auto i : *triangles) {
         _ctx.indices.push_back(vertexDataOffset + _ctx.used[i]);
     }
 }
@@ -4,7 +4,10 @@
 
 #include "glm/vec3.hpp"
 #include "earcut.hpp"
+#include <atomic>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 
@@ -34,6 +37,57 @@ JoinTypes JoinTypeFromString(const std::string& str);
  */
 typedef std::function<void(const glm::vec3& coord, const glm::vec3& normal, const glm::vec2& uv)> PolygonVertexFn;
 
+/* TessellationCache - Stores the earcut triangulation of polygons keyed by their geometry,
+ * so that styles drawing the same polygon and rebuilds of the same <TileData> only run
+ * earcut once per distinct polygon. TileData retained across Scene updates may be built by
+ * workers of two Scenes at once, so lookups are synchronized; earcut runs unlocked.
+ *
+ * Entries refer to the polygon they were created for, to verify hits without a copy of
+ * it: Polygons must outlive the cache, i.e. belong to the <TileData> that owns it.
+ */
+class TessellationCache {
+
+public:
+
+    using Earcut = mapbox::detail::Earcut<uint16_t>;
+
+    // Polygons beyond this number of entries are triangulated without caching
+    static constexpr size_t max_entries = 4096;
+
+    /* Return the triangle indices of _polygon, running _earcut when they are not cached yet.
+     * The returned reference is valid until clear() is called.
+     */
+    const std::vector<uint16_t>& triangulate(const Polygon& _polygon, Earcut& _earcut);
+
+    void clear();
+
+    size_t size() const;
+    size_t hits() const { return m_hits; }
+    size_t misses() const { return m_misses; }
+
+    static uint64_t hash(const Polygon& _polygon);
+
+    // Estimated bytes of the entry of _polygon once it is triangulated
+    static size_t memoryUsage(const Polygon& _polygon);
+
+private:
+
+    struct Entry {
+        // Compared on lookup to guard against hash collisions
+        std::vector<uint32_t> ringSizes;
+        const Polygon* polygon;
+        std::vector<uint16_t> indices;
+    };
+
+    // Entries are never replaced: returned references stay valid while other threads insert
+    std::unordered_map<uint64_t, Entry> m_entries;
+
+    mutable std::mutex m_mutex;
+
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+};
+
 /* PolygonBuilder context,
  * see Builders::buildPolygon() and Builders::buildPolygonExtrusion()
  */
@@ -48,6 +102,9 @@ struct PolygonBuilder {
 
     mapbox::detail::Earcut<uint16_t> earcut;
 
+    // Optional cache for triangulations, see Builders::buildPolygon()
+    TessellationCache* tessellationCache = nullptr;
+
     PolygonBuilder(PolygonVertexFn _addVertex = [](auto&,auto&,auto&){},
                    bool _kte = true, bool _useTexCoords = true)
         : addVertex(_addVertex), keepTileEdges(_kte), useTexCoords(_useTexCoords){}
@@ -114,7 +171,7 @@ class Builders {
 
 public:
 
-    /* Build a tesselated polygon
+    /* Build a tesselated polygon, reusing the triangulation from _ctx.tessellationCache if set
      * @_polygon input coordinates describing the polygon
      * @_ctx output vectors, see <PolygonBuilder>
      */
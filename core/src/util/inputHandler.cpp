@@ -26,14 +26,19 @@ namespace Tangram {
 
 InputHandler::InputHandler(View& _view) : m_view(_view) {}
 
-bool InputHandler::update(float _dt) {
+bool InputHandler::isFlinging() const {
 
     auto velocityPanPixels = m_view.pixelsPerMeter() / m_view.pixelScale() * m_velocityPan;
 
-    bool isFlinging = glm::length(velocityPanPixels) > THRESHOLD_STOP_PAN ||
-                      std::abs(m_velocityZoom) > THRESHOLD_STOP_ZOOM;
+    return glm::length(velocityPanPixels) > THRESHOLD_STOP_PAN ||
+           std::abs(m_velocityZoom) > THRESHOLD_STOP_ZOOM;
+}
+
+bool InputHandler::update(float _dt) {
+
+    bool flinging = isFlinging();
 
-    if (isFlinging) {
+    if (flinging) {
 
         m_velocityPan -= min(_dt * DAMPING_PAN, 1.f) * m_velocityPan;
         m_view.translate(_dt * m_velocityPan.x, _dt * m_velocityPan.y);
@@ -42,7 +47,21 @@ bool InputHandler::update(float _dt) {
         m_view.zoom(m_velocityZoom * _dt);
     }
 
-    return isFlinging;
+    return flinging;
+}
+
+bool InputHandler::getFlingTarget(glm::dvec3& _target) const {
+
+    if (!isFlinging()) { return false; }
+
+    // The velocities decay exponentially, so the remaining distance is the
+    // current velocity times the decay period.
+    const auto& position = m_view.getPosition();
+    _target.x = position.x + m_velocityPan.x / DAMPING_PAN;
+    _target.y = position.y + m_velocityPan.y / DAMPING_PAN;
+    _target.z = m_view.getZoom() + m_velocityZoom / DAMPING_ZOOM;
+
+    return true;
 }
 
 void InputHandler::handleTapGesture(float _posX, float _posY) {
@@ -27,16 +27,24 @@ public:
 
     void cancelFling();
 
+    /*
+     * Returns true if the view is flinging and sets _target to the position (x and y
+     * in projected meters, zoom) at which the fling is predicted to come to rest
+     */
+    bool getFlingTarget(glm::dvec3& _target) const;
+
     void setView(View& _view) { m_view = _view; }
 
 private:
 
     void setVelocity(float _zoom, glm::vec2 _pan);
 
+    bool isFlinging() const;
+
     View& m_view;
 
     // fling deltas on zoom and translation
-    glm::vec2 m_velocityPan;
+    glm::vec2 m_velocityPan = { 0.f, 0.f };
     float m_velocityZoom = 0.f;
 
 };
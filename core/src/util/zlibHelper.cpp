@@ -11,23 +11,41 @@ namespace zlib {
 
 int inflate(const char* _data, size_t _size, std::vector<char>& dst) {
 
-    int ret;
-    unsigned char out[CHUNK];
+    Inflater inflater;
+    int ret = inflater.add(_data, _size, dst);
+
+    if (ret == Z_OK) { return Z_DATA_ERROR; }
+
+    return ret == Z_STREAM_END ? Z_OK : ret;
+}
+
+Inflater::Inflater() : m_strm(std::make_unique<z_stream>()) {
+
+    memset(m_strm.get(), 0, sizeof(z_stream));
 
-    z_stream strm;
-    memset(&strm, 0, sizeof(z_stream));
+    m_status = inflateInit2(m_strm.get(), 16+MAX_WBITS);
+}
+
+Inflater::~Inflater() {
+    inflateEnd(m_strm.get());
+}
+
+int Inflater::add(const char* _data, size_t _size, std::vector<char>& _dst) {
 
-    ret = inflateInit2(&strm, 16+MAX_WBITS);
-    if (ret != Z_OK) { return ret; }
+    if (m_status != Z_OK) { return m_status; }
 
+    unsigned char out[CHUNK];
+
+    auto& strm = *m_strm;
     strm.avail_in = _size;
     strm.next_in = (Bytef*)_data;
 
+    int ret;
     do {
         strm.avail_out = CHUNK;
         strm.next_out = out;
 
-        ret = inflate(&strm, Z_NO_FLUSH);
+        ret = ::inflate(&strm, Z_NO_FLUSH);
 
          /* state not clobbered */
         assert(ret != Z_STREAM_ERROR);
@@ -38,18 +56,21 @@ int inflate(const char* _data, size_t _size, std::vector<char>& dst) {
             /* fall through */
         case Z_DATA_ERROR:
         case Z_MEM_ERROR:
-            inflateEnd(&strm);
+            m_status = ret;
             return ret;
         }
 
         size_t have = CHUNK - strm.avail_out;
-        dst.insert(dst.end(), out, out+have);
+        _dst.insert(_dst.end(), out, out+have);
 
-    } while (ret == Z_OK);
+    // Input is consumed when output space is left
+    } while (ret == Z_OK && strm.avail_out == 0);
 
-    inflateEnd(&strm);
+    // Z_BUF_ERROR: No progress possible until more data arrives
+    if (ret == Z_BUF_ERROR) { ret = Z_OK; }
 
-    return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
+    m_status = ret;
+    return ret;
 }
 
 }
@@ -1,12 +1,30 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <string.h>
 
+struct z_stream_s;
+
 namespace Tangram {
 namespace zlib {
 
 int inflate(const char* _data, size_t _size, std::vector<char>& dst);
 
+// Inflates gzip data that arrives in chunks
+class Inflater {
+public:
+    Inflater();
+    ~Inflater();
+
+    // Inflate the next chunk of data and append the output to _dst. Returns Z_OK
+    // while more data is expected, Z_STREAM_END when the data is complete or an error.
+    int add(const char* _data, size_t _size, std::vector<char>& _dst);
+
+private:
+    std::unique_ptr<z_stream_s> m_strm;
+    int m_status;
+};
+
 }
 }
@@ -18,6 +18,7 @@ double invLodFunc(double d) {
 
 View::View(int _width, int _height) :
     m_obliqueAxis(0, 1),
+    m_vanishingPoint(0, 0),
     m_width(0),
     m_height(0),
     m_type(CameraType::perspective),
@@ -85,7 +86,9 @@ ViewState View::state() const {
         powf(2.f, m_zoom),
         m_zoom - std::floor(m_zoom),
         glm::vec2(m_vpWidth, m_vpHeight),
-        (float)MapProjection::tileSize() * m_pixelScale
+        (float)MapProjection::tileSize() * m_pixelScale,
+        m_roll,
+        m_pitch
     };
 }
 
@@ -191,6 +194,13 @@ float View::getMaxPitch() const {
 
 }
 
+void View::setMaxTileScreenSize(float _pixels) {
+
+    m_maxTileScreenSize = std::max(_pixels, 0.f);
+    m_dirtyTiles = true;
+
+}
+
 void View::setConstrainToWorldBounds(bool constrainToWorldBounds) {
 
     m_worldBoundsMinZoom = 0.f;
@@ -606,12 +616,46 @@ void View::getVisibleTiles(const std::function<void(TileID)>& _tileCb) const {
         int y_limit_pos[MAX_LOD] = { imax };
         int y_limit_neg[MAX_LOD] = { imin };
 
+        // Screen space error: a tile is refined while its size, projected from its point
+        // nearest to the eye, exceeds maxScreenSize. The eye is in tile space with its
+        // height in tiles, screenSizeScale is the projected size in logical pixels of a
+        // tile at distance 1.
+        double maxScreenSize = 0;
+        double screenSizeScale = 0;
+        glm::dvec3 eye;
+
+        // Refinement of the last checked tile at each level of detail
+        glm::ivec2 refineTile[MAX_LOD + 1];
+        bool refine[MAX_LOD + 1];
+
         glm::ivec4 last = glm::ivec4{-1};
+
+        bool refineAncestor(int x, int y, int lod) {
+            glm::ivec2 tile = { x >> lod, y >> lod };
+            if (tile != refineTile[lod]) {
+                double size = 1 << lod;
+                glm::dvec2 min = glm::dvec2(tile) * size;
+                glm::dvec2 nearest = glm::clamp(glm::dvec2(eye), min, min + size);
+                double distance = glm::length(glm::dvec3(nearest, 0.) - eye);
+
+                refineTile[lod] = tile;
+                refine[lod] = size * screenSizeScale > maxScreenSize * distance;
+            }
+            return refine[lod];
+        }
     };
 
     ScanParams opt{ zoom, static_cast<int>(m_maxZoom) };
 
-    if (m_type == CameraType::perspective) {
+    if (m_type == CameraType::perspective && m_maxTileScreenSize > 0.f) {
+
+        opt.maxScreenSize = m_maxTileScreenSize;
+        opt.screenSizeScale = pixelsPerMeter() * m_pos.z;
+        opt.eye = glm::dvec3(e, m_eye.z * invTileSize);
+
+        for (auto& tile : opt.refineTile) { tile = glm::ivec2{imin}; }
+
+    } else if (m_type == CameraType::perspective) {
 
         // Determine zoom reduction for tiles far from the center of view
         double tilesAtFullZoom = std::max(m_width, m_height) * invTileSize * 0.5;
@@ -631,10 +675,16 @@ void View::getVisibleTiles(const std::function<void(TileID)>& _tileCb) const {
     Rasterize::ScanCallback s = [&opt, &_tileCb](int x, int y) {
 
         int lod = 0;
-        while (lod < MAX_LOD && x >= opt.x_limit_pos[lod]) { lod++; }
-        while (lod < MAX_LOD && x <  opt.x_limit_neg[lod]) { lod++; }
-        while (lod < MAX_LOD && y >= opt.y_limit_pos[lod]) { lod++; }
-        while (lod < MAX_LOD && y <  opt.y_limit_neg[lod]) { lod++; }
+        if (opt.maxScreenSize > 0) {
+            // Use the coarsest ancestor that is not refined
+            lod = std::min(MAX_LOD, opt.zoom);
+            while (lod > 0 && opt.refineAncestor(x, y, lod)) { lod--; }
+        } else {
+            while (lod < MAX_LOD && x >= opt.x_limit_pos[lod]) { lod++; }
+            while (lod < MAX_LOD && x <  opt.x_limit_neg[lod]) { lod++; }
+            while (lod < MAX_LOD && y >= opt.y_limit_pos[lod]) { lod++; }
+            while (lod < MAX_LOD && y <  opt.y_limit_neg[lod]) { lod++; }
+        }
 
         x >>= lod;
         y >>= lod;
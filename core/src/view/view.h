@@ -45,6 +45,8 @@ struct ViewState {
     float fractZoom;
     glm::vec2 viewportSize;
     float tileSize;
+    float roll;
+    float pitch;
 };
 
 // View
@@ -111,6 +113,15 @@ public:
     // Get the maximum pitch angle for the current zoom, in degrees.
     float getMaxPitch() const;
 
+    // Set the size in logical pixels up to which tiles of a lower zoom level are
+    // displayed in perspective views: a tile is replaced by its four children only
+    // while its projected size exceeds this size. 0 selects lower zoom levels by
+    // fixed distance bands from the view center instead.
+    void setMaxTileScreenSize(float _pixels);
+
+    // Get the size in logical pixels up to which tiles of a lower zoom level are displayed.
+    float getMaxTileScreenSize() const { return m_maxTileScreenSize; }
+
     // Whether to constrain visible area to the projected bounds of the world.
     void setConstrainToWorldBounds(bool constrainToWorldBounds);
 
@@ -275,6 +286,7 @@ protected:
     float m_maxPitch = 90.f;
     float m_minZoom = 0.f;
     float m_maxZoom = 20.5f;
+    float m_maxTileScreenSize = 0.f;
 
     CameraType m_type;
 
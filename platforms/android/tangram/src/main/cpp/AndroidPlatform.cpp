@@ -3,6 +3,7 @@
 #include "JniHelpers.h"
 #include "JniThreadBinding.h"
 
+#include "gl/hardware.h"
 #include "log.h"
 #include "util/url.h"
 
@@ -28,6 +29,8 @@
 PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOESEXT = 0;
 PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT = 0;
 PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT = 0;
+PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOESEXT = 0;
+PFNGLPROGRAMBINARYOESPROC glProgramBinaryOESEXT = 0;
 
 namespace Tangram {
 
@@ -283,17 +286,21 @@ void setCurrentThreadPriority(int priority) {
 }
 
 void initGLExtensions() {
-    if (glExtensionsLoaded) {
-        return;
-    }
+    if (!glExtensionsLoaded) {
+        void* libhandle = dlopen("libGLESv2.so", RTLD_LAZY);
 
-    void* libhandle = dlopen("libGLESv2.so", RTLD_LAZY);
+        glBindVertexArrayOESEXT = (PFNGLBINDVERTEXARRAYOESPROC) dlsym(libhandle, "glBindVertexArrayOES");
+        glDeleteVertexArraysOESEXT = (PFNGLDELETEVERTEXARRAYSOESPROC) dlsym(libhandle, "glDeleteVertexArraysOES");
+        glGenVertexArraysOESEXT = (PFNGLGENVERTEXARRAYSOESPROC) dlsym(libhandle, "glGenVertexArraysOES");
+        glGetProgramBinaryOESEXT = (PFNGLGETPROGRAMBINARYOESPROC) dlsym(libhandle, "glGetProgramBinaryOES");
+        glProgramBinaryOESEXT = (PFNGLPROGRAMBINARYOESPROC) dlsym(libhandle, "glProgramBinaryOES");
 
-    glBindVertexArrayOESEXT = (PFNGLBINDVERTEXARRAYOESPROC) dlsym(libhandle, "glBindVertexArrayOES");
-    glDeleteVertexArraysOESEXT = (PFNGLDELETEVERTEXARRAYSOESPROC) dlsym(libhandle, "glDeleteVertexArraysOES");
-    glGenVertexArraysOESEXT = (PFNGLGENVERTEXARRAYSOESPROC) dlsym(libhandle, "glGenVertexArraysOES");
+        glExtensionsLoaded = true;
+    }
 
-    glExtensionsLoaded = true;
+    if (!glGetProgramBinaryOESEXT || !glProgramBinaryOESEXT) {
+        Hardware::supportsProgramBinary = false;
+    }
 }
 
 } // namespace Tangram
@@ -13,10 +13,14 @@
 extern PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOESEXT;
 extern PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT;
 extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT;
+extern PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOESEXT;
+extern PFNGLPROGRAMBINARYOESPROC glProgramBinaryOESEXT;
 
 #define glDeleteVertexArrays glDeleteVertexArraysOESEXT
 #define glGenVertexArrays glGenVertexArraysOESEXT
 #define glBindVertexArray glBindVertexArrayOESEXT
+#define glGetProgramBinary glGetProgramBinaryOESEXT
+#define glProgramBinary glProgramBinaryOESEXT
 #endif // TANGRAM_ANDROID
 
 #ifdef TANGRAM_IOS
@@ -26,6 +30,9 @@ extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT;
 #define glDeleteVertexArrays glDeleteVertexArraysOES
 #define glGenVertexArrays glGenVertexArraysOES
 #define glBindVertexArray glBindVertexArrayOES
+// OES_get_program_binary is not available on iOS
+static void glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary) {}
+static void glProgramBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {}
 #endif // TANGRAM_IOS
 
 #ifdef TANGRAM_OSX
@@ -38,6 +45,9 @@ extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT;
 #define glDeleteVertexArrays glDeleteVertexArraysAPPLE
 #define glGenVertexArrays glGenVertexArraysAPPLE
 #define glBindVertexArray glBindVertexArrayAPPLE
+// Program binaries are not exposed by the legacy OS X context
+static void glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary) {}
+static void glProgramBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {}
 #endif // TANGRAM_OSX
 
 #ifdef TANGRAM_LINUX
@@ -68,6 +78,10 @@ static void glBindVertexArray(GLuint array) {}
 static void glDeleteVertexArrays(GLsizei n, const GLuint *arrays) {}
 static void glGenVertexArrays(GLsizei n, GLuint *arrays) {}
 
+// Dummy program binary functions
+static void glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary) {}
+static void glProgramBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {}
+
 #endif // TANGRAM_RPI
 
 #if defined(TANGRAM_ANDROID) || defined(TANGRAM_IOS) || defined(TANGRAM_RPI)
@@ -1,7 +1,9 @@
 #include "urlClient.h"
 #include "log.h"
+#include "util/url.h"
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
 #include <curl/curl.h>
 #ifndef _MSC_VER
@@ -116,11 +118,22 @@ struct UrlClient::Task {
     static constexpr size_t limit_capacity = 128 * 1024;
 
     Request request;
-    std::vector<char> content;
+    // Shared with stream callbacks, which read the part of it that was written
+    std::shared_ptr<std::vector<char>> content = std::make_shared<std::vector<char>>();
     CURL *handle = nullptr;
     char curlErrorString[CURL_ERROR_SIZE] = {0};
     bool active = false;
     bool canceled = false;
+    // Whether the request was started on a multiplexed connection
+    bool multiplexed = false;
+    // Conditional request headers
+    curl_slist* headers = nullptr;
+    // Cache headers of the response
+    UrlCacheInfo cacheInfo;
+    long maxAge = -1;
+    long age = 0;
+    // Bytes of content passed to the stream callback
+    size_t streamed = 0;
 
     static size_t curlWriteCallback(char* ptr, size_t size, size_t n, void* user) {
         // Writes data received by libCURL.
@@ -129,17 +142,89 @@ struct UrlClient::Task {
 
         auto& buffer = task->content;
         auto addedSize = size * n;
-        auto oldSize = buffer.size();
-        buffer.resize(oldSize + addedSize);
-        std::memcpy(buffer.data() + oldSize, ptr, addedSize);
+        auto oldSize = buffer->size();
+        if (oldSize + addedSize > buffer->capacity() && task->streamed > 0) {
+            // Stream callbacks may still read the content: Grow into a new buffer
+            auto grown = std::make_shared<std::vector<char>>();
+            grown->reserve(std::max(2 * buffer->capacity(), oldSize + addedSize));
+            grown->assign(buffer->begin(), buffer->end());
+            buffer = std::move(grown);
+        }
+        buffer->resize(oldSize + addedSize);
+        std::memcpy(buffer->data() + oldSize, ptr, addedSize);
         return addedSize;
     }
 
-    Task(const Options& _options) {
+    static size_t curlHeaderCallback(char* ptr, size_t size, size_t n, void* user) {
+        // Reads the cache headers of the response
+        auto* task = reinterpret_cast<Task*>(user);
+        auto length = size * n;
+        std::string line(ptr, length);
+
+        // Headers of a previous response that redirected
+        if (line.compare(0, 5, "HTTP/") == 0) {
+            task->cacheInfo = {};
+            task->maxAge = -1;
+            task->age = 0;
+            return length;
+        }
+
+        auto colon = line.find(':');
+        if (colon == std::string::npos) { return length; }
+
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+        auto begin = line.find_first_not_of(" \t", colon + 1);
+        auto end = line.find_last_not_of(" \t\r\n");
+        if (begin == std::string::npos || end < begin) { return length; }
+        std::string value = line.substr(begin, end - begin + 1);
+
+        if (name == "etag") {
+            task->cacheInfo.etag = value;
+        } else if (name == "last-modified") {
+            task->cacheInfo.lastModified = value;
+        } else if (name == "expires") {
+            time_t expires = curl_getdate(value.c_str(), nullptr);
+            // Invalid dates like '0' mean that the content is already expired
+            task->cacheInfo.expires = expires > 0 ? expires : 1;
+        } else if (name == "age") {
+            task->age = std::max(0l, std::atol(value.c_str()));
+        } else if (name == "cache-control") {
+            std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+            if (value.find("no-cache") != std::string::npos ||
+                value.find("no-store") != std::string::npos) {
+                task->maxAge = 0;
+            } else {
+                // Not 's-maxage'
+                for (auto pos = value.find("max-age="); pos != std::string::npos;
+                     pos = value.find("max-age=", pos + 1)) {
+                    if (pos == 0 || value[pos - 1] == ' ' || value[pos - 1] == ',') {
+                        task->maxAge = std::max(0l, std::atol(value.c_str() + pos + 8));
+                        break;
+                    }
+                }
+            }
+        }
+        return length;
+    }
+
+    // Cache info of the response, max-age takes precedence over Expires
+    UrlCacheInfo responseCacheInfo() const {
+        UrlCacheInfo info = cacheInfo;
+        if (maxAge >= 0) {
+            info.expires = int64_t(time(nullptr)) + std::max(0l, maxAge - age);
+        }
+        return info;
+    }
+
+    Task(const Options& _options, CURLSH* _share) {
         // Set up an easy handle for reuse.
         handle = curl_easy_init();
         curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, &curlWriteCallback);
         curl_easy_setopt(handle, CURLOPT_WRITEDATA, this);
+        curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, &curlHeaderCallback);
+        curl_easy_setopt(handle, CURLOPT_HEADERDATA, this);
         curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 1L);
         curl_easy_setopt(handle, CURLOPT_HEADER, 0L);
         curl_easy_setopt(handle, CURLOPT_VERBOSE, 0L);
@@ -151,30 +236,65 @@ struct UrlClient::Task {
         curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1);
         curl_easy_setopt(handle, CURLOPT_MAXREDIRS, 20);
         curl_easy_setopt(handle, CURLOPT_TCP_NODELAY, 1);
+#if LIBCURL_VERSION_NUM >= 0x071900
+        curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+#endif
         curl_easy_setopt(handle, CURLOPT_USERAGENT, _options.userAgentString);
+        curl_easy_setopt(handle, CURLOPT_SHARE, _share);
+#if LIBCURL_VERSION_NUM >= 0x072F00
+        if (_options.http2) {
+            curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+            // Wait for a connection to the host to be able to multiplex, rather than opening another one
+            curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        }
+#endif
     }
 
     void setup() {
         canceled = false;
         active = true;
+        cacheInfo = {};
+        maxAge = -1;
+        age = 0;
+        streamed = 0;
+
+        // Conditional request
+        auto& validators = request.cacheInfo;
+        if (!validators.etag.empty()) {
+            headers = curl_slist_append(headers, ("If-None-Match: " + validators.etag).c_str());
+        }
+        if (!validators.lastModified.empty()) {
+            headers = curl_slist_append(headers, ("If-Modified-Since: " + validators.lastModified).c_str());
+        }
+        curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers);
     }
 
     void clear() {
-        bool shrink = content.capacity() > limit_capacity &&
-            !content.empty() && content.size() < limit_capacity / 2;
+        if (streamed > 0) {
+            // Stream callbacks may still read the content
+            content = std::make_shared<std::vector<char>>();
+        }
+
+        bool shrink = content->capacity() > limit_capacity &&
+            !content->empty() && content->size() < limit_capacity / 2;
 
         if (shrink) {
-            LOGD("Release content buffer %u / %u", content.size(), content.capacity());
-            content.resize(limit_capacity / 2);
-            content.shrink_to_fit();
+            LOGD("Release content buffer %u / %u", content->size(), content->capacity());
+            content->resize(limit_capacity / 2);
+            content->shrink_to_fit();
         }
-        content.clear();
+        content->clear();
+
+        curl_easy_setopt(handle, CURLOPT_HTTPHEADER, nullptr);
+        curl_slist_free_all(headers);
+        headers = nullptr;
 
         active = false;
     }
 
     ~Task() {
         curl_easy_cleanup(handle);
+        curl_slist_free_all(headers);
     }
 
     Task(const Task&) = delete;
@@ -183,21 +303,47 @@ struct UrlClient::Task {
 };
 
 
-UrlClient::UrlClient(Options options) : m_options(options) {
+UrlClient::UrlClient(Options options)
+    : m_options(options),
+      m_hostLimits(options.maxActiveTasks, options.maxActiveTasksPerHost,
+                   options.maxMultiplexedTasksPerHost) {
     // Using a pipe to notify select() in curl-thread of new requests..
     // https://www.linuxquestions.org/questions/programming-9/exit-from-blocked-pselect-661200/
     if (!m_requestNotify.initialize()) {
         LOGE("Could not initialize select breaker!");
     }
 
-    // Start the curl thread
+    // Share DNS lookups and TLS sessions between the easy handles. All handles are
+    // used by the curl thread, so the share needs no lock functions.
+    m_curlShare = curl_share_init();
+    curl_share_setopt(m_curlShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+#if LIBCURL_VERSION_NUM >= 0x071700
+    curl_share_setopt(m_curlShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#endif
+
+    for (uint32_t i = 0; i < m_options.streamWorkers; i++) {
+        m_streamWorkers.push_back(std::make_unique<AsyncWorker>());
+    }
+
     m_curlHandle = curl_multi_init();
-    m_curlRunning = true;
-    m_curlWorker = std::make_unique<std::thread>(&UrlClient::curlLoop, this);
+#if LIBCURL_VERSION_NUM >= 0x072B00
+    curl_multi_setopt(m_curlHandle, CURLMOPT_PIPELINING,
+                      m_options.http2 ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x071E00
+    curl_multi_setopt(m_curlHandle, CURLMOPT_MAX_HOST_CONNECTIONS, long(m_options.maxActiveTasksPerHost));
+#endif
+#if LIBCURL_VERSION_NUM >= 0x074300
+    curl_multi_setopt(m_curlHandle, CURLMOPT_MAX_CONCURRENT_STREAMS, long(m_options.maxMultiplexedTasksPerHost));
+#endif
 
     // Init at least one task to avoid checking whether m_tasks is empty in
     // startPendingRequests()
-    m_tasks.emplace_back(m_options);
+    m_tasks.emplace_back(m_options, m_curlShare);
+
+    // Start the curl thread
+    m_curlRunning = true;
+    m_curlWorker = std::make_unique<std::thread>(&UrlClient::curlLoop, this);
 }
 
 UrlClient::~UrlClient() {
@@ -237,6 +383,10 @@ UrlClient::~UrlClient() {
         }
     }
     curl_multi_cleanup(m_curlHandle);
+
+    // Easy handles must be cleaned up before the share they use
+    m_tasks.clear();
+    curl_share_cleanup(m_curlShare);
 }
 
 void UrlClient::curlWakeUp() {
@@ -251,16 +401,26 @@ void UrlClient::curlWakeUp() {
     }
 }
 
-UrlClient::RequestId UrlClient::addRequest(const std::string& _url, UrlCallback _onComplete) {
+UrlClient::RequestId UrlClient::addRequest(const std::string& _url, UrlCallback _onComplete,
+                                           const UrlCacheInfo& _cacheInfo, UrlStreamCallback _stream) {
 
     auto id = ++m_requestCount;
-    Request request = {_url, _onComplete, id};
+    Url url(_url);
+    // Without stream workers the content is only passed to _onComplete
+    if (m_streamWorkers.empty()) { _stream = {}; }
+
+    Request request = {_url, _onComplete, id, url.scheme() + "://" + url.netLocation(), 0, _cacheInfo,
+                       std::move(_stream)};
 
     // Add the request to our list.
     {
         // Lock the mutex to prevent concurrent modification of the
         // list by the curl thread.
         std::lock_guard<std::mutex> lock(m_requestMutex);
+        // Other requests of default priority are started first
+        if (!m_requests.empty() && m_requests.back().priority > request.priority) {
+            m_requestsUnsorted = true;
+        }
         m_requests.push_back(request);
     }
     curlWakeUp();
@@ -304,28 +464,100 @@ void UrlClient::cancelRequest(UrlClient::RequestId _id) {
     }
 }
 
+void UrlClient::setRequestPriority(UrlClient::RequestId _id, double _priority) {
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+
+        auto it = std::find_if(m_requests.begin(), m_requests.end(),
+                               [&](auto& r) { return r.id == _id; });
+        if (it != m_requests.end()) {
+            if (it->priority != _priority) {
+                it->priority = _priority;
+                m_requestsUnsorted = true;
+            }
+        } else {
+            // Used to choose the request to preempt
+            auto task = std::find_if(m_tasks.begin(), m_tasks.end(),
+                                     [&](auto& t) { return t.active && t.request.id == _id; });
+            if (task != m_tasks.end()) { task->request.priority = _priority; }
+            return;
+        }
+    }
+    curlWakeUp();
+}
+
+bool UrlClient::preemptTask(const Request& _request, const std::string* _host,
+                            std::vector<Request>& _preempted) {
+
+    // Multiplexed requests do not occupy a connection
+    auto preempt = m_tasks.end();
+    for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
+        if (!it->active || it->canceled || it->multiplexed) { continue; }
+        if (_host && it->request.host != *_host) { continue; }
+        if (it->request.priority <= _request.priority) { continue; }
+        if (preempt == m_tasks.end() || it->request.priority > preempt->request.priority) {
+            preempt = it;
+        }
+    }
+    if (preempt == m_tasks.end()) { return false; }
+
+    LOGD("Preempt request for url: %s", preempt->request.url.c_str());
+
+    curl_multi_remove_handle(m_curlHandle, preempt->handle);
+
+    m_activeTasks--;
+    m_hostLimits.finish(preempt->request.host, false);
+
+    _preempted.push_back(std::move(preempt->request));
+    preempt->clear();
+
+    // Move task to front - for quick reuse
+    m_tasks.splice(m_tasks.begin(), m_tasks, preempt);
+
+    return true;
+}
+
 void UrlClient::startPendingRequests() {
     std::unique_lock<std::mutex> lock(m_requestMutex);
 
-    while (m_activeTasks < m_options.maxActiveTasks) {
+    if (m_requestsUnsorted) {
+        std::stable_sort(m_requests.begin(), m_requests.end(),
+                         [](auto& a, auto& b) { return a.priority < b.priority; });
+        m_requestsUnsorted = false;
+    }
+
+    std::vector<Request> preempted;
+
+    // Requests to hosts at their limit wait, while later requests to other hosts can start
+    for (auto it = m_requests.begin(); it != m_requests.end(); ) {
 
-        if (m_requests.empty()) { break; }
+        if (!m_hostLimits.canStart(it->host)) {
+            bool hostFull = m_hostLimits.hostFull(it->host);
+            bool canPreempt = m_options.preemptRequests && !m_hostLimits.multiplexed(it->host) &&
+                preemptTask(*it, hostFull ? &it->host : nullptr, preempted);
+            if (!canPreempt) {
+                ++it;
+                continue;
+            }
+        }
 
         if (m_tasks.front().active) {
-            m_tasks.emplace_front(m_options);
+            m_tasks.emplace_front(m_options, m_curlShare);
         }
 
         m_activeTasks++;
+        bool multiplexed = m_hostLimits.start(it->host);
 
         Task& task = m_tasks.front();
 
         // Swap front with back
         m_tasks.splice(m_tasks.end(), m_tasks, m_tasks.begin());
 
-        task.setup();
+        task.request = std::move(*it);
+        it = m_requests.erase(it);
 
-        task.request = std::move(m_requests.front());
-        m_requests.erase(m_requests.begin());
+        task.setup();
+        task.multiplexed = multiplexed;
 
         // Configure the easy handle.
         const char* url = task.request.url.c_str();
@@ -335,6 +567,41 @@ void UrlClient::startPendingRequests() {
 
         curl_multi_add_handle(m_curlHandle, task.handle);
     }
+
+    // Restarted when a slot becomes free
+    if (!preempted.empty()) {
+        for (auto& request : preempted) { m_requests.push_back(std::move(request)); }
+        m_requestsUnsorted = true;
+    }
+}
+
+AsyncWorker& UrlClient::streamWorker(RequestId _id) {
+    return *m_streamWorkers[_id % m_streamWorkers.size()];
+}
+
+void UrlClient::dispatchStreamData() {
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+
+    for (auto& task : m_tasks) {
+        if (!task.active || task.canceled || !task.request.stream) { continue; }
+        if (task.content->size() <= task.streamed) { continue; }
+
+        // Skip bodies of redirects and errors
+        long status = 0;
+        curl_easy_getinfo(task.handle, CURLINFO_RESPONSE_CODE, &status);
+        if (status != 200) { continue; }
+
+        // The written content is not modified, so the callback reads it in place
+        size_t offset = task.streamed;
+        const char* data = task.content->data() + offset;
+        size_t size = task.content->size() - offset;
+        task.streamed = task.content->size();
+
+        streamWorker(task.request.id).enqueue([stream = task.request.stream, content = task.content,
+                                               offset, data, size]() {
+                                                  stream(offset, data, size);
+                                              });
+    }
 }
 
 void UrlClient::curlLoop() {
@@ -380,14 +647,15 @@ void UrlClient::curlLoop() {
         }
 
         // Listen on requestNotify to break select when new requests are added.
-        FD_SET(m_requestNotify.getReadFd(), &fdread);
+        // NB: The notify fd is not necessarily above the fds of curl, and without
+        // transfers maxfd is -1: Include it in maxfd so that new requests wake
+        // up select instead of waiting for its timeout.
+        auto notifyFd = m_requestNotify.getReadFd();
+        FD_SET(notifyFd, &fdread);
+        maxfd = std::max(maxfd, int(notifyFd));
 
         // Wait for transfers
-        // On success the value of maxfd is guaranteed to be >= -1. We call
-        // select(maxfd + 1, ...); specially in case of (maxfd == -1) there are
-        // no fds ready yet so we call select(0, ...) to sleep 100ms, which is
-        // the minimum suggested value in the curl_multi_fdset() doc.
-        int ready = select(maxfd + 2, &fdread, &fdwrite, &fdexcep, &timeout);
+        int ready = select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &timeout);
 
         if (ready == -1) {
             LOGE("select() error!");
@@ -410,6 +678,9 @@ void UrlClient::curlLoop() {
             //
             int activeRequests = 0;
             curl_multi_perform(m_curlHandle, &activeRequests);
+
+            // Before the callbacks of finished requests
+            dispatchStreamData();
         }
 
         while (true) {
@@ -434,6 +705,7 @@ void UrlClient::curlLoop() {
 
             UrlCallback callback;
             UrlResponse response;
+            AsyncWorker* worker = &m_dispatcher;
             {
                 std::lock_guard<std::mutex> lock(m_requestMutex);
                 // Find Task for this message
@@ -447,15 +719,36 @@ void UrlClient::curlLoop() {
                 // Move task to front - for quick reuse
                 m_tasks.splice(m_tasks.begin(), m_tasks, it);
 
-                // Get Response content and Request callback
+                m_hostLimits.finish(task.request.host, task.multiplexed);
+
+#if LIBCURL_VERSION_NUM >= 0x073200
+                // Later requests to a host that answered with HTTP/2 share its connection
+                long httpVersion = CURL_HTTP_VERSION_NONE;
+                curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &httpVersion);
+                if (resultCode == CURLE_OK && httpVersion >= CURL_HTTP_VERSION_2_0) {
+                    m_hostLimits.setMultiplexed(task.request.host);
+                }
+#endif
+
+                // Get Response content and Request callback. Pending stream callbacks may
+                // still read the content: They run on the worker of the callback before it,
+                // which keeps the content alive in the response.
                 callback = std::move(task.request.callback);
-                response.content = task.content;
+                if (callback) { response.content = std::move(*task.content); }
+
+                // After the content passed to the stream callback
+                if (task.request.stream) { worker = &streamWorker(task.request.id); }
 
                 const char* url = task.request.url.c_str();
                 if (resultCode == CURLE_OK) {
                     LOGD("Succeeded for url: %s", url);
                     response.error = nullptr;
 
+                    long status = 0;
+                    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &status);
+                    response.notModified = (status == 304);
+                    response.cacheInfo = task.responseCacheInfo();
+
                 } else if (task.canceled) {
                     LOGD("Aborted request for url: %s", url);
                     response.error = requestCancelledError;
@@ -471,10 +764,10 @@ void UrlClient::curlLoop() {
 
             // Always run callback regardless of request result.
             if (callback) {
-                m_dispatcher.enqueue([callback = std::move(callback),
-                                      response = std::move(response)]() mutable {
-                                         callback(std::move(response));
-                                     });
+                worker->enqueue([callback = std::move(callback),
+                                 response = std::move(response)]() mutable {
+                                    callback(std::move(response));
+                                });
 
                 //callback(std::move(response));
             }
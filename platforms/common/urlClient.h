@@ -1,12 +1,14 @@
 #pragma once
 
 #include "platform.h" // UrlResponse
+#include "urlHostLimits.h"
 #include "util/asyncWorker.h"
 
 #include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <deque>
 #include <string>
@@ -24,9 +26,23 @@ class UrlClient {
 public:
 
     struct Options {
+        // Maximum number of requests over separate connections
         uint32_t maxActiveTasks = 20;
+        // Maximum number of requests to a host that does not multiplex them
+        uint32_t maxActiveTasksPerHost = 6;
+        // Maximum number of requests to a host that multiplexes them over one HTTP/2 connection.
+        // These requests are not limited by maxActiveTasks.
+        uint32_t maxMultiplexedTasksPerHost = 64;
         uint32_t connectionTimeoutMs = 3000;
         uint32_t requestTimeoutMs = 30000;
+        // Negotiate HTTP/2 for https requests
+        bool http2 = true;
+        // Cancel and requeue the active request of lowest priority when a request of
+        // higher priority cannot start otherwise
+        bool preemptRequests = false;
+        // Threads that pass the content of requests to their stream callbacks while
+        // it arrives. Without them streaming requests are normal requests.
+        uint32_t streamWorkers = 1;
         const char* userAgentString = "tangram";
     };
 
@@ -35,16 +51,32 @@ public:
 
     using RequestId = uint64_t;
 
-    RequestId addRequest(const std::string& url, UrlCallback cb);
+    // When _cacheInfo has validators the request is conditional: A response with
+    // 'notModified' set and no content means that the cached content is still valid.
+    // When stream is set and Options::streamWorkers is not zero, it receives the content
+    // of a successful response while it arrives. It runs on a stream worker, in order and
+    // before cb, which then runs on the same worker.
+    RequestId addRequest(const std::string& url, UrlCallback cb, const UrlCacheInfo& cacheInfo = {},
+                         UrlStreamCallback stream = {});
 
     void cancelRequest(RequestId request);
 
+    // Requests of lower priority values are started first. Requests start with priority zero.
+    void setRequestPriority(RequestId request, double priority);
+
 private:
 
     struct Request {
         std::string url;
         UrlCallback callback;
         RequestId id;
+        // Scheme and network location of the url
+        std::string host;
+        double priority = 0;
+        // Validators for a conditional request
+        UrlCacheInfo cacheInfo;
+        // Receives the content while it arrives
+        UrlStreamCallback stream;
     };
 
     class SelfPipe {
@@ -72,22 +104,45 @@ private:
 
     void startPendingRequests();
 
+    // Pass the content that arrived for streaming requests to their stream callbacks
+    void dispatchStreamData();
+
+    // The worker that runs the callbacks of a streaming request
+    AsyncWorker& streamWorker(RequestId _id);
+
+    // Cancel the active request of lowest priority below _request and requeue it in _preempted.
+    // When _host is set only requests to this host are considered.
+    bool preemptTask(const Request& _request, const std::string* _host, std::vector<Request>& _preempted);
+
     Options m_options;
 
     // Curl multi handle
     void *m_curlHandle = nullptr;
 
+    // Curl share handle for DNS and TLS session caches
+    void *m_curlShare = nullptr;
+
     bool m_curlRunning = false;
     bool m_curlNotified = false;
 
     std::unique_ptr<std::thread> m_curlWorker;
     AsyncWorker m_dispatcher;
 
+    // Run stream callbacks, so that parsing streamed content does not delay the
+    // callbacks of other requests
+    std::vector<std::unique_ptr<AsyncWorker>> m_streamWorkers;
+
     std::list<Task> m_tasks;
     uint32_t m_activeTasks = 0;
 
+    // Only accessed by the curl thread
+    UrlHostLimits m_hostLimits;
+
     std::deque<Request> m_requests;
 
+    // Whether m_requests needs to be sorted by priority
+    bool m_requestsUnsorted = false;
+
     // Synchronize m_tasks and m_requests
     std::mutex m_requestMutex;
 
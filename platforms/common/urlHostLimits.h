@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace Tangram {
+
+/* Counts the active requests of UrlClient per host and over separate connections
+ * to decide whether another request can start.
+ *
+ * Requests to a host that answered with HTTP/2 are multiplexed over one connection:
+ * They are limited by maxMultiplexedTasksPerHost instead of maxActiveTasksPerHost
+ * and do not count against maxActiveTasks.
+ */
+class UrlHostLimits {
+
+public:
+
+    UrlHostLimits(uint32_t _maxActiveTasks, uint32_t _maxActiveTasksPerHost,
+                  uint32_t _maxMultiplexedTasksPerHost)
+        : m_maxActiveTasks(_maxActiveTasks),
+          m_maxActiveTasksPerHost(_maxActiveTasksPerHost),
+          m_maxMultiplexedTasksPerHost(_maxMultiplexedTasksPerHost) {}
+
+    bool multiplexed(const std::string& _host) const {
+        auto it = m_hosts.find(_host);
+        return it != m_hosts.end() && it->second.multiplexed;
+    }
+
+    uint32_t activeTasks(const std::string& _host) const {
+        auto it = m_hosts.find(_host);
+        return it != m_hosts.end() ? it->second.activeTasks : 0;
+    }
+
+    uint32_t connectionTasks() const { return m_connectionTasks; }
+
+    // Whether _host has as many active requests as it may have
+    bool hostFull(const std::string& _host) const {
+        uint32_t limit = multiplexed(_host) ? m_maxMultiplexedTasksPerHost : m_maxActiveTasksPerHost;
+        return activeTasks(_host) >= limit;
+    }
+
+    // Whether a request to _host would need a connection while all are in use
+    bool connectionsFull(const std::string& _host) const {
+        return !multiplexed(_host) && m_connectionTasks >= m_maxActiveTasks;
+    }
+
+    bool canStart(const std::string& _host) const {
+        return !hostFull(_host) && !connectionsFull(_host);
+    }
+
+    // Count a started request to _host. Returns whether it is multiplexed,
+    // which must be passed to finish().
+    bool start(const std::string& _host) {
+        auto& host = m_hosts[_host];
+        host.activeTasks++;
+        if (!host.multiplexed) { m_connectionTasks++; }
+        return host.multiplexed;
+    }
+
+    void finish(const std::string& _host, bool _multiplexed) {
+        auto& host = m_hosts[_host];
+        if (host.activeTasks > 0) { host.activeTasks--; }
+        if (!_multiplexed && m_connectionTasks > 0) { m_connectionTasks--; }
+    }
+
+    // Later requests to _host share its connection
+    void setMultiplexed(const std::string& _host) {
+        m_hosts[_host].multiplexed = true;
+    }
+
+private:
+
+    struct Host {
+        uint32_t activeTasks = 0;
+        // Whether the host answered with HTTP/2, so that requests share one connection
+        bool multiplexed = false;
+    };
+
+    uint32_t m_maxActiveTasks;
+    uint32_t m_maxActiveTasksPerHost;
+    uint32_t m_maxMultiplexedTasksPerHost;
+
+    // Active tasks that do not share a connection, limited by maxActiveTasks
+    uint32_t m_connectionTasks = 0;
+
+    std::unordered_map<std::string, Host> m_hosts;
+};
+
+} // namespace Tangram
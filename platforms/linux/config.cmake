@@ -82,3 +82,38 @@ target_compile_definitions(tangram
 
 
 add_resources(tangram "${PROJECT_SOURCE_DIR}/scenes" "res")
+
+# Command-line tool to precompute glyph bundles, see SceneOptions::glyphBundlePath
+add_executable(tangram-glyph-bundle
+  platforms/linux/src/linuxPlatform.cpp
+  platforms/linux/src/glyphBundle.cpp
+  platforms/common/platform_gl.cpp
+  platforms/common/urlClient.cpp
+  platforms/common/linuxSystemFontHelper.cpp
+)
+
+target_include_directories(tangram-glyph-bundle
+  PRIVATE
+  platforms/common
+  ${FONTCONFIG_INCLUDE_DIRS}
+  $<TARGET_PROPERTY:tangram-core,INCLUDE_DIRECTORIES>
+)
+
+# LinuxPlatform wakes up the GLFW event loop on URL responses
+target_link_libraries(tangram-glyph-bundle
+  PRIVATE
+  tangram-core
+  glfw
+  ${GLFW_LIBRARIES}
+  ${OPENGL_LIBRARIES}
+  ${FONTCONFIG_LDFLAGS}
+  ${CURL_LIBRARIES}
+  -pthread
+  -ldl
+)
+
+target_compile_options(tangram-glyph-bundle
+  PRIVATE
+  -std=c++1y
+  -Wall
+)
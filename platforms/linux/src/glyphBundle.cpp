@@ -0,0 +1,135 @@
+#include "linuxPlatform.h"
+#include "log.h"
+#include "scene/scene.h"
+#include "text/fontContext.h"
+#include "text/glyphBundle.h"
+#include "yaml-cpp/yaml.h"
+
+#include <fstream>
+#include <limits.h>
+#include <memory>
+#include <unistd.h>
+
+using namespace Tangram;
+
+// Writes a glyph bundle with the distance fields of all characters in a charset
+// file, rendered with each font of a scene at each glyph raster size.
+//
+// Usage: tangram-glyph-bundle <scene> <charset> <bundle> [pixel scale]
+//
+// Each line of the charset file is laid out as one text. Lines that a font can
+// not render completely are laid out character by character.
+
+struct FontStyle {
+    std::string family, style, weight;
+};
+
+static std::vector<FontStyle> sceneFonts(const YAML::Node& _fonts) {
+    std::vector<FontStyle> fonts = {{ "default", "regular", "400" }};
+
+    if (!_fonts.IsMap()) { return fonts; }
+
+    auto addFont = [&](const std::string& _family, const YAML::Node& _node) {
+        if (!_node.IsMap()) { return; }
+        FontStyle font{ _family, "regular", "400" };
+        if (const YAML::Node& style = _node["style"]) { font.style = style.Scalar(); }
+        if (const YAML::Node& weight = _node["weight"]) { font.weight = weight.Scalar(); }
+        fonts.push_back(font);
+    };
+
+    for (const auto& font : _fonts) {
+        const std::string& family = font.first.Scalar();
+        if (font.second.IsSequence()) {
+            for (const auto& node : font.second) { addFont(family, node); }
+        } else {
+            addFont(family, font.second);
+        }
+    }
+    return fonts;
+}
+
+static bool layout(FontContext& _context, FontContext::Shaper& _shaper,
+                   TextStyle::Parameters& _params, const icu::UnicodeString& _text) {
+
+    std::vector<GlyphQuad> quads;
+    std::bitset<FontContext::max_textures> refs;
+    glm::vec2 size;
+    TextRange ranges;
+
+    bool added = _context.layoutText(_shaper, _params, _text, quads, refs, size, ranges);
+    _context.releaseAtlas(refs);
+    return added;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 4) {
+        LOG("Usage: %s <scene> <charset> <bundle> [pixel scale]", argv[0]);
+        return 1;
+    }
+
+    std::ifstream charsetFile(argv[2]);
+    if (!charsetFile.is_open()) {
+        LOGE("Cannot read charset file: %s", argv[2]);
+        return 1;
+    }
+    std::vector<icu::UnicodeString> charset;
+    for (std::string line; std::getline(charsetFile, line);) {
+        if (!line.empty()) { charset.push_back(icu::UnicodeString::fromUTF8(line)); }
+    }
+
+    float pixelScale = argc > 4 ? std::stof(argv[4]) : 1.f;
+
+    // Resolve the scene path against the current directory.
+    Url baseUrl("file:///");
+    char pathBuffer[PATH_MAX] = {0};
+    if (getcwd(pathBuffer, PATH_MAX) != nullptr) {
+        baseUrl = baseUrl.resolve(Url(std::string(pathBuffer) + "/"));
+    }
+
+    LinuxPlatform platform;
+
+    SceneOptions options{baseUrl.resolve(Url(argv[1]))};
+    options.numTileWorkers = 0;
+    options.prefetchTiles = false;
+
+    Scene scene(platform, std::move(options));
+
+    if (!scene.load()) {
+        LOGE("Cannot load scene: %s", argv[1]);
+        return 1;
+    }
+
+    auto& context = *scene.fontContext();
+    context.setPixelScale(pixelScale);
+    auto bundle = std::make_shared<GlyphBundle>();
+    context.setGlyphBundle(bundle, true);
+
+    auto shaper = context.createShaper();
+
+    for (const auto& font : sceneFonts(scene.config()["fonts"])) {
+        for (float fontSize : { 16.f, 28.f, 40.f }) {
+            TextStyle::Parameters params;
+            params.font = context.getFont(font.family, font.style, font.weight, fontSize);
+            if (!params.font) { continue; }
+
+            params.fontSize = fontSize;
+            params.wordWrap = false;
+
+            for (const auto& line : charset) {
+                if (layout(context, *shaper, params, line)) { continue; }
+
+                for (int32_t i = 0; i < line.length(); i = line.moveIndex32(i, 1)) {
+                    layout(context, *shaper, params, line.tempSubString(i, line.moveIndex32(i, 1) - i));
+                }
+            }
+        }
+    }
+
+    if (!bundle->save(argv[3])) { return 1; }
+
+    LOG("Wrote %d glyphs to %s", int(bundle->size()), argv[3]);
+
+    platform.shutdown();
+    return 0;
+}
@@ -3,11 +3,14 @@
 #include "gl/hardware.h"
 #include "log.h"
 #include <algorithm>
+#include <fstream>
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdarg.h>
 #include <libgen.h>
 #include <unistd.h>
 #include <sys/resource.h>
+#include <sys/stat.h>
 #include <sys/syscall.h>
 
 #if defined(TANGRAM_LINUX)
@@ -31,6 +34,20 @@ LinuxPlatform::LinuxPlatform()
 LinuxPlatform::LinuxPlatform(UrlClient::Options urlClientOptions) :
     m_urlClient(std::make_unique<UrlClient>(urlClientOptions)) {
     m_fcConfig = FcInitLoadConfigAndFonts();
+
+    // Follow the XDG base directory spec for the program binary cache
+    std::string cachePath;
+    if (const char* xdgCache = getenv("XDG_CACHE_HOME")) {
+        cachePath = xdgCache;
+    } else if (const char* home = getenv("HOME")) {
+        cachePath = std::string(home) + "/.cache";
+    }
+    if (!cachePath.empty()) {
+        mkdir(cachePath.c_str(), 0755);
+        cachePath += "/tangram";
+        mkdir(cachePath.c_str(), 0755);
+        m_programCachePath = cachePath + "/";
+    }
 }
 
 LinuxPlatform::~LinuxPlatform() {
@@ -77,11 +94,55 @@ FontSourceHandle LinuxPlatform::systemFont(const std::string& _name,
     return FontSourceHandle(Url(fontFile));
 }
 
+std::vector<char> LinuxPlatform::loadProgramBinary(const std::string& _key) const {
+    std::vector<char> binary;
+    if (m_programCachePath.empty()) { return binary; }
+
+    std::ifstream file(m_programCachePath + _key + ".bin", std::ifstream::ate | std::ifstream::binary);
+    if (!file.is_open()) { return binary; }
+
+    binary.resize(file.tellg());
+    file.seekg(std::ifstream::beg);
+    file.read(binary.data(), binary.size());
+    if (!file) { binary.clear(); }
+
+    return binary;
+}
+
+void LinuxPlatform::storeProgramBinary(const std::string& _key, const std::vector<char>& _binary) {
+    if (m_programCachePath.empty()) { return; }
+
+    std::ofstream file(m_programCachePath + _key + ".bin", std::ofstream::binary | std::ofstream::trunc);
+    if (!file.is_open()) {
+        LOGW("Cannot write program binary to %s", m_programCachePath.c_str());
+        return;
+    }
+    file.write(_binary.data(), _binary.size());
+}
+
 bool LinuxPlatform::startUrlRequestImpl(const Url& _url, const UrlRequestHandle _request, UrlRequestId& _id) {
+    return startConditionalUrlRequestImpl(_url, {}, _request, _id);
+}
+
+bool LinuxPlatform::startConditionalUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                                   const UrlRequestHandle _request, UrlRequestId& _id) {
+
+    _id = m_urlClient->addRequest(_url.string(),
+                                  [this, _request](UrlResponse&& response) {
+                                      onUrlResponse(_request, std::move(response));
+                                  }, _cacheInfo);
+    return true;
+}
+
+bool LinuxPlatform::startStreamingUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                                 const UrlRequestHandle _request, UrlRequestId& _id) {
 
     _id = m_urlClient->addRequest(_url.string(),
                                   [this, _request](UrlResponse&& response) {
                                       onUrlResponse(_request, std::move(response));
+                                  }, _cacheInfo,
+                                  [this, _request](size_t offset, const char* data, size_t size) {
+                                      onUrlData(_request, offset, data, size);
                                   });
     return true;
 }
@@ -92,6 +153,12 @@ void LinuxPlatform::cancelUrlRequestImpl(const UrlRequestId _id) {
     }
 }
 
+void LinuxPlatform::setUrlRequestPriorityImpl(const UrlRequestId _id, double _priority) {
+    if (m_urlClient) {
+        m_urlClient->setRequestPriority(_id, _priority);
+    }
+}
+
 void setCurrentThreadPriority(int priority) {
     setpriority(PRIO_PROCESS, 0, priority);
 }
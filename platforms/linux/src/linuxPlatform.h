@@ -19,12 +19,23 @@ public:
     FontSourceHandle systemFont(const std::string& _name, const std::string& _weight,
                                 const std::string& _face) const override;
 
+    std::vector<char> loadProgramBinary(const std::string& _key) const override;
+    void storeProgramBinary(const std::string& _key, const std::vector<char>& _binary) override;
+
     bool startUrlRequestImpl(const Url& _url, const UrlRequestHandle _request, UrlRequestId& _id) override;
     void cancelUrlRequestImpl(const UrlRequestId _id) override;
+    void setUrlRequestPriorityImpl(const UrlRequestId _id, double _priority) override;
+    bool startConditionalUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                        const UrlRequestHandle _request, UrlRequestId& _id) override;
+    bool startStreamingUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                      const UrlRequestHandle _request, UrlRequestId& _id) override;
 
 protected:
     FcConfig* m_fcConfig = nullptr;
 
+    // Directory for shader program binaries, empty if no cache directory is available
+    std::string m_programCachePath;
+
     std::unique_ptr<UrlClient> m_urlClient;
 };
 
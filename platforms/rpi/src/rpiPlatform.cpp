@@ -64,10 +64,28 @@ FontSourceHandle RpiPlatform::systemFont(const std::string& _name, const std::st
 }
 
 bool RpiPlatform::startUrlRequestImpl(const Url& _url, const UrlRequestHandle _request, UrlRequestId& _id) {
+    return startConditionalUrlRequestImpl(_url, {}, _request, _id);
+}
+
+bool RpiPlatform::startConditionalUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                                 const UrlRequestHandle _request, UrlRequestId& _id) {
 
     _id = m_urlClient.addRequest(_url.string(),
                                  [this, _request](UrlResponse&& response) {
                                      onUrlResponse(_request, std::move(response));
+                                 }, _cacheInfo);
+    return true;
+}
+
+bool RpiPlatform::startStreamingUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                               const UrlRequestHandle _request, UrlRequestId& _id) {
+
+    _id = m_urlClient.addRequest(_url.string(),
+                                 [this, _request](UrlResponse&& response) {
+                                     onUrlResponse(_request, std::move(response));
+                                 }, _cacheInfo,
+                                 [this, _request](size_t offset, const char* data, size_t size) {
+                                     onUrlData(_request, offset, data, size);
                                  });
     return true;
 }
@@ -76,6 +94,10 @@ void RpiPlatform::cancelUrlRequestImpl(const UrlRequestId _id) {
     m_urlClient.cancelRequest(_id);
 }
 
+void RpiPlatform::setUrlRequestPriorityImpl(const UrlRequestId _id, double _priority) {
+    m_urlClient.setRequestPriority(_id, _priority);
+}
+
 RpiPlatform::~RpiPlatform() {}
 
 void setCurrentThreadPriority(int priority) {
@@ -120,6 +120,13 @@ void GL::getProgramiv(GLuint program, GLenum pname, GLint *params) {
 void GL::getShaderiv(GLuint shader, GLenum pname, GLint *params) {
     __evas_gl_glapi->glGetShaderiv(shader,pname, params);
 }
+void GL::getProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length,
+                          GLenum *binaryFormat, void *binary) {
+    __evas_gl_glapi->glGetProgramBinaryOES(program, bufSize, length, binaryFormat, binary);
+}
+void GL::programBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {
+    __evas_gl_glapi->glProgramBinaryOES(program, binaryFormat, binary, length);
+}
 
 // Buffers
 void GL::bindBuffer(GLenum target, GLuint buffer) {
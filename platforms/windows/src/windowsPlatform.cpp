@@ -55,10 +55,27 @@ std::vector<FontSourceHandle> WindowsPlatform::systemFontFallbacksHandle() const
 }
 
 bool WindowsPlatform::startUrlRequestImpl(const Url& _url, const UrlRequestHandle _request, UrlRequestId& _id) {
+    return startConditionalUrlRequestImpl(_url, {}, _request, _id);
+}
+
+bool WindowsPlatform::startConditionalUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                                     const UrlRequestHandle _request, UrlRequestId& _id) {
     auto onURLResponse = [this, _request](UrlResponse&& response) {
         onUrlResponse(_request, std::move(response));
     };
-    _id = m_urlClient->addRequest(_url.string(), onURLResponse);
+    _id = m_urlClient->addRequest(_url.string(), onURLResponse, _cacheInfo);
+    return false;
+}
+
+bool WindowsPlatform::startStreamingUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                                   const UrlRequestHandle _request, UrlRequestId& _id) {
+    auto onURLResponse = [this, _request](UrlResponse&& response) {
+        onUrlResponse(_request, std::move(response));
+    };
+    auto onURLData = [this, _request](size_t offset, const char* data, size_t size) {
+        onUrlData(_request, offset, data, size);
+    };
+    _id = m_urlClient->addRequest(_url.string(), onURLResponse, _cacheInfo, onURLData);
     return false;
 }
 
@@ -68,6 +85,12 @@ void WindowsPlatform::cancelUrlRequestImpl(const UrlRequestId _id) {
     }
 }
 
+void WindowsPlatform::setUrlRequestPriorityImpl(const UrlRequestId _id, double _priority) {
+    if (m_urlClient) {
+        m_urlClient->setRequestPriority(_id, _priority);
+    }
+}
+
 void setCurrentThreadPriority(int priority) {}
 
 void initGLExtensions() {
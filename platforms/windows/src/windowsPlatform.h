@@ -17,6 +17,11 @@ public:
     std::vector<FontSourceHandle> systemFontFallbacksHandle() const override;
     bool startUrlRequestImpl(const Url& _url, const UrlRequestHandle _request, UrlRequestId& _id) override;
     void cancelUrlRequestImpl(const UrlRequestId _id) override;
+    void setUrlRequestPriorityImpl(const UrlRequestId _id, double _priority) override;
+    bool startConditionalUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                        const UrlRequestHandle _request, UrlRequestId& _id) override;
+    bool startStreamingUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                      const UrlRequestHandle _request, UrlRequestId& _id) override;
 
 protected:
     std::unique_ptr<UrlClient> m_urlClient;
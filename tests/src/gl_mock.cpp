@@ -87,6 +87,11 @@ void GL::getProgramiv(GLuint program, GLenum pname, GLint *params) {
 }
 void GL::getShaderiv(GLuint shader, GLenum pname, GLint *params) {
 }
+void GL::getProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length,
+                          GLenum *binaryFormat, void *binary) {
+}
+void GL::programBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {
+}
 
 // Buffers
 void GL::bindBuffer(GLenum target, GLuint buffer) {
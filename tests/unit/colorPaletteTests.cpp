@@ -0,0 +1,86 @@
+#include "catch.hpp"
+
+#include "style/colorPalette.h"
+
+using namespace Tangram;
+
+struct TestVertex {
+    GLuint abgr;
+    GLuint selection;
+};
+
+struct TestCompactVertex {
+    TestCompactVertex(const TestVertex& v, uint16_t paletteIndex) : palette(paletteIndex) {}
+    uint16_t palette;
+};
+
+TEST_CASE("Color palette stores each pair of colors once", "[ColorPalette]") {
+    ColorPalette palette;
+
+    uint16_t a = 0, b = 0, c = 0, index = 0;
+    REQUIRE(palette.add(0xff0000ff, 0x00000001, a));
+    REQUIRE(palette.add(0xff00ff00, 0x00000001, b));
+    REQUIRE(palette.add(0xff0000ff, 0x00000002, c));
+
+    REQUIRE(a == 0);
+    REQUIRE(b == 1);
+    REQUIRE(c == 2);
+
+    REQUIRE(palette.add(0xff0000ff, 0x00000001, index));
+    REQUIRE(index == a);
+    REQUIRE(palette.add(0xff00ff00, 0x00000001, index));
+    REQUIRE(index == b);
+    REQUIRE(palette.size() == 3);
+
+    palette.clear();
+    REQUIRE(palette.empty());
+    REQUIRE(palette.add(0xff00ff00, 0x00000001, index));
+    REQUIRE(index == 0);
+}
+
+TEST_CASE("Color palette texture has a row of selection colors below each row of colors", "[ColorPalette]") {
+    ColorPalette palette;
+    uint16_t index = 0;
+
+    for (GLuint i = 0; i < 3; i++) {
+        palette.add(i, 0x100 + i, index);
+    }
+
+    auto texture = palette.createTexture();
+    REQUIRE(texture->width() == 3);
+    REQUIRE(texture->height() == 2);
+    REQUIRE(texture->bufferSize() == 3 * 2 * sizeof(GLuint));
+
+    for (GLuint i = 0; i < 300; i++) {
+        palette.add(i, 0x1000 + i, index);
+    }
+    REQUIRE(palette.size() == 303);
+
+    texture = palette.createTexture();
+    REQUIRE(texture->width() == ColorPalette::rowLength);
+    REQUIRE(texture->height() == 4);
+}
+
+TEST_CASE("Vertices are not compacted when their colors overflow the palette", "[ColorPalette]") {
+    ColorPalette palette;
+
+    std::vector<TestVertex> vertices;
+    for (GLuint i = 0; i < ColorPalette::maxEntries; i++) {
+        vertices.push_back({ i, 0 });
+        vertices.push_back({ i, 0 });
+    }
+
+    std::vector<TestCompactVertex> compact;
+    REQUIRE(compactVertices(vertices, palette, compact));
+    REQUIRE(compact.size() == vertices.size());
+    REQUIRE(compact.back().palette == ColorPalette::maxEntries - 1);
+
+    vertices.push_back({ ColorPalette::maxEntries, 0 });
+
+    palette.clear();
+    compact.clear();
+    REQUIRE_FALSE(compactVertices(vertices, palette, compact));
+
+    uint16_t index = 0;
+    REQUIRE_FALSE(palette.add(0xffffffff, 0, index));
+}
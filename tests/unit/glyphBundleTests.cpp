@@ -0,0 +1,53 @@
+#include "catch.hpp"
+
+#include "text/glyphBundle.h"
+
+#include <cstring>
+
+using namespace Tangram;
+
+TEST_CASE("GlyphBundle keys depend on the cell bitmap and the SDF radius", "[GlyphBundle]") {
+    // A 2x2 cell in an atlas with rows of 4 bytes
+    unsigned char atlas[8] = { 1, 2, 9, 9,
+                               3, 4, 9, 9 };
+    unsigned char other[8] = { 1, 2, 0, 0,
+                               3, 4, 0, 0 };
+
+    uint64_t key = GlyphBundle::key(atlas, 4, 2, 2, 6.f);
+
+    // Bytes outside of the cell are ignored
+    REQUIRE(key == GlyphBundle::key(other, 4, 2, 2, 6.f));
+
+    REQUIRE(key != GlyphBundle::key(atlas, 4, 2, 2, 12.f));
+    REQUIRE(key != GlyphBundle::key(atlas, 4, 1, 2, 6.f));
+
+    other[4] = 5;
+    REQUIRE(key != GlyphBundle::key(other, 4, 2, 2, 6.f));
+}
+
+TEST_CASE("GlyphBundle distance fields survive serialization", "[GlyphBundle]") {
+    unsigned char atlas[8] = { 10, 20, 0, 0,
+                               30, 40, 0, 0 };
+
+    GlyphBundle bundle;
+    uint64_t key = GlyphBundle::key(atlas, 4, 2, 2, 6.f);
+    bundle.add(key, atlas, 4, 2, 2);
+
+    GlyphBundle loaded;
+    REQUIRE(loaded.parse(bundle.serialize()));
+    REQUIRE(loaded.size() == 1);
+
+    auto sdf = loaded.find(key, 2, 2);
+    REQUIRE(sdf != nullptr);
+    unsigned char expected[4] = { 10, 20, 30, 40 };
+    REQUIRE(std::memcmp(sdf, expected, 4) == 0);
+
+    // Cells of another size never match
+    REQUIRE(loaded.find(key, 2, 1) == nullptr);
+    REQUIRE(loaded.find(key + 1, 2, 2) == nullptr);
+
+    // Truncated data is rejected
+    auto data = bundle.serialize();
+    data.pop_back();
+    REQUIRE_FALSE(loaded.parse(data));
+}
@@ -1,11 +1,14 @@
 #include "catch.hpp"
 #include "gl/dynamicQuadMesh.h"
+#include "labels/labelCollider.h"
 #include "labels/labelManager.h"
+#include "labels/spriteLabel.h"
 #include "labels/textLabel.h"
 #include "labels/textLabels.h"
 #include "map.h"
 #include "platform.h"
 #include "scene/scene.h"
+#include "style/pointStyle.h"
 #include "style/style.h"
 #include "style/textStyle.h"
 #include "tile/tile.h"
@@ -121,6 +124,8 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
     public:
         TestLabels(View& _v) {
             m_isect2d.resize({1, 1}, {_v.getWidth(), _v.getHeight()});
+            m_viewportSize = {_v.getWidth(), _v.getHeight()};
+            m_dirtyCells.assign(1, false);
         }
 
         ScreenTransform& addLabel(Label* _l, Tile* _t) {
@@ -128,7 +133,7 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
             tmpTransforms.emplace_back(m_transforms, m_labels.back().transformRange);
             return tmpTransforms.back().transform;
         }
-        void run(View& _v) { handleOcclusions(_v.state()); }
+        void run(View& _v, bool _reuse = false) { handleOcclusions(_v.state(), _reuse); }
         void clear() { m_labels.clear(); }
 
         std::vector<TestTransform> tmpTransforms;
@@ -215,5 +220,113 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
         REQUIRE(l2.anchorType() == LabelProperty::Anchor::bottom);
     }
 
+    {
+        TestLabels labels(view);
+        TextLabel l1 = makeLabelWithAnchorFallbacks(glm::vec2{0.5,0.5});
+        auto& t1 = labels.addLabel(&l1, &tile);
+        l1.update(tile.mvp(), view.state(), bounds, t1);
+
+        TextLabel l2 = makeLabelWithAnchorFallbacks(glm::vec2{0.5,0.5});
+        auto& t2 = labels.addLabel(&l2, &tile);
+        l2.update(tile.mvp(), view.state(), bounds, t2);
+
+        labels.run(view);
+        REQUIRE(l1.isOccluded() == false);
+        REQUIRE(l2.isOccluded() == true);
+
+        // Nothing moved: results of the last update are kept
+        labels.run(view, true);
+        REQUIRE(l1.isOccluded() == false);
+        REQUIRE(l2.isOccluded() == true);
+
+        // Removing L1 frees its cells, so L2 is tested again
+        labels.clear();
+        auto& t3 = labels.addLabel(&l2, &tile);
+        l2.update(tile.mvp(), view.state(), bounds, t3);
+
+        labels.run(view, true);
+        REQUIRE(l2.isOccluded() == false);
+    }
+
+}
+
+TEST_CASE( "Cull point labels outside of the viewport", "[Labels][Cull]" ) {
+
+    View view(256, 256);
+    view.setConstrainToWorldBounds(false);
+    view.setPosition(0, 0);
+    view.setZoom(0);
+    view.update();
+
+    Tile tile({0,0,0});
+    tile.update(0, view);
+
+    TextLabels labels(dummyStyle);
+    std::vector<std::unique_ptr<Label>> list;
+    list.push_back(makeLabel(glm::vec2{0.5,0.5}, Label::Type::point, "0"));
+    // Three and a half tiles right of the viewport center
+    list.push_back(makeLabel(glm::vec2{4.0,0.5}, Label::Type::point, "1"));
+    // Only point labels are culled
+    list.push_back(makeLabel(glm::vec2{4.0,0.5}, Label::Type::line, "2"));
+    labels.setLabels(list);
+
+    std::vector<uint8_t> culled;
+    labels.cullLabels(tile.mvp(), view.state().viewportSize, 256.f, culled);
+
+    REQUIRE(culled.size() == 3);
+    REQUIRE(culled[0] == 0);
+    REQUIRE(culled[1] == 1);
+    REQUIRE(culled[2] == 0);
+}
+
+TEST_CASE( "Compute placement zoom of labels within a tile", "[Labels][PlacementZoom]" ) {
+
+    std::vector<std::unique_ptr<Label>> labels;
+    labels.push_back(makeLabel(glm::vec2{0.5,0.5}, Label::Type::point, "0"));
+    // 20 pixels right of the first label when the tile is laid out at zoom 3,
+    // where it is 512 pixels wide
+    labels.push_back(makeLabel(glm::vec2{0.5 + 20./512,0.5}, Label::Type::point, "1"));
+
+    LabelCollider collider;
+    collider.addLabels(labels);
+    collider.process({0,0,2}, 1.f, 256.f);
+
+    REQUIRE(labels[0]->isOccluded() == false);
+    REQUIRE(labels[1]->isOccluded() == false);
+
+    REQUIRE(labels[0]->placementZoom() == 0.f);
+    // The 10 pixel wide labels touch at half the distance
+    REQUIRE(labels[1]->placementZoom() == Approx(2.f));
 }
+
+TEST_CASE( "Placement zoom of sprites includes their extrusion", "[Labels][PlacementZoom]" ) {
+
+    PointStyle pointStyle("points");
+    SpriteLabels spriteLabels(pointStyle);
+
+    Label::Options options;
+    options.anchors.anchor[0] = LabelProperty::Anchor::center;
+    options.anchors.count = 1;
+
+    // 10 pixel wide sprites that grow by 10 pixels until the next zoom level
+    SpriteLabel::VertexAttributes attrib{};
+    attrib.extrudeScale = 10.f;
+
+    std::vector<std::unique_ptr<Label>> labels;
+    labels.emplace_back(new SpriteLabel({0.5, 0.5, 0}, {10, 10}, options, attrib,
+                                        nullptr, spriteLabels, 0));
+    labels.emplace_back(new SpriteLabel({0.5 + 20./512, 0.5, 0}, {10, 10}, options, attrib,
+                                        nullptr, spriteLabels, 1));
+
+    LabelCollider collider;
+    collider.addLabels(labels);
+    collider.process({0,0,2}, 1.f, 256.f);
+
+    REQUIRE(labels[0]->isOccluded() == false);
+    REQUIRE(labels[1]->isOccluded() == false);
+
+    // At most 20 pixels wide: they may touch at the distance they have at zoom 3
+    REQUIRE(labels[1]->placementZoom() == Approx(3.f));
+}
+
 }
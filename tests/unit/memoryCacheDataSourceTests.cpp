@@ -0,0 +1,163 @@
+#include "catch.hpp"
+
+#include "data/memoryCacheDataSource.h"
+#include "data/networkDataSource.h"
+#include "mockPlatform.h"
+
+#include <ctime>
+#include <vector>
+
+using namespace Tangram;
+
+#define TAGS "[MemoryCacheDataSource]"
+
+// Responds to URL requests only when asked to
+class DeferredPlatform : public MockPlatform {
+public:
+    bool startUrlRequestImpl(const Url& _url, const UrlRequestHandle _handle, UrlRequestId& _id) override {
+        return startConditionalUrlRequestImpl(_url, {}, _handle, _id);
+    }
+
+    bool startConditionalUrlRequestImpl(const Url& _url, const UrlCacheInfo& _cacheInfo,
+                                        const UrlRequestHandle _handle, UrlRequestId& _id) override {
+        started.push_back(_handle);
+        validators.push_back(_cacheInfo);
+        _id = _handle;
+        return true;
+    }
+
+    void cancelUrlRequestImpl(const UrlRequestId _id) override {}
+
+    void respond(std::string _contents, UrlCacheInfo _cacheInfo, bool _notModified = false) {
+        UrlResponse response;
+        response.content.assign(_contents.begin(), _contents.end());
+        response.cacheInfo = _cacheInfo;
+        response.notModified = _notModified;
+        onUrlResponse(started.back(), std::move(response));
+    }
+
+    std::vector<UrlRequestHandle> started;
+    std::vector<UrlCacheInfo> validators;
+};
+
+struct Loaded {
+    std::string data;
+    bool dataChanged;
+};
+
+TEST_CASE("Revalidate stale tile data in the background", TAGS) {
+    DeferredPlatform platform;
+
+    auto memoryCache = std::make_unique<MemoryCacheDataSource>();
+    memoryCache->setCacheSize(1024 * 1024);
+    memoryCache->setNext(std::make_unique<NetworkDataSource>(platform, "https://tiles.test/{z}/{x}/{y}",
+                                                             NetworkDataSource::UrlOptions{}));
+
+    auto source = std::make_shared<TileSource>("test", std::move(memoryCache));
+
+    std::vector<Loaded> loaded;
+    TileTaskCb callback{[&](std::shared_ptr<TileTask> _task) {
+        auto& task = static_cast<BinaryTileTask&>(*_task);
+        loaded.push_back({std::string(task.rawTileData->begin(), task.rawTileData->end()), task.dataChanged()});
+    }};
+
+    auto load = [&]() { source->loadTileData(source->createTask(TileID(0, 0, 0)), callback); };
+
+    UrlCacheInfo stale;
+    stale.etag = "\"v1\"";
+    stale.expires = 1;
+
+    load();
+    REQUIRE(platform.started.size() == 1);
+    platform.respond("v1", stale);
+
+    REQUIRE(loaded.size() == 1);
+    CHECK(loaded[0].data == "v1");
+
+    // Cached data is served, and revalidated with its ETag
+    load();
+    REQUIRE(loaded.size() == 2);
+    CHECK(loaded[1].data == "v1");
+    REQUIRE(platform.started.size() == 2);
+    CHECK(platform.validators[1].etag == "\"v1\"");
+
+    SECTION("Unchanged data") {
+        UrlCacheInfo fresh;
+        fresh.expires = int64_t(std::time(nullptr)) + 3600;
+        platform.respond("", fresh, true);
+
+        CHECK(loaded.size() == 2);
+
+        // Fresh again
+        load();
+        CHECK(loaded.size() == 3);
+        CHECK(platform.started.size() == 2);
+    }
+
+    SECTION("Changed data") {
+        UrlCacheInfo changed;
+        changed.etag = "\"v2\"";
+        changed.expires = int64_t(std::time(nullptr)) + 3600;
+        platform.respond("v2", changed);
+
+        REQUIRE(loaded.size() == 3);
+        CHECK(loaded[2].data == "v2");
+        CHECK(loaded[2].dataChanged);
+
+        load();
+        REQUIRE(loaded.size() == 4);
+        CHECK(loaded[3].data == "v2");
+        CHECK_FALSE(loaded[3].dataChanged);
+        CHECK(platform.started.size() == 2);
+    }
+}
+
+// Serves stale data like a persistent cache and revalidates it when asked to
+struct RevalidatingSource : TileSource::DataSource {
+    bool loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override {
+        auto& task = static_cast<BinaryTileTask&>(*_task);
+        loads++;
+        task.rawTileData = std::make_shared<std::vector<char>>(3, 'x');
+        task.cacheInfo.expires = 1;
+        revalidation = createRevalidationTask(task);
+        callback = _cb;
+        _cb.func(_task);
+        return true;
+    }
+
+    void notModified(int64_t _expires) {
+        revalidation->notModified = true;
+        revalidation->cacheInfo.expires = _expires;
+        callback.func(revalidation);
+    }
+
+    int loads = 0;
+    std::shared_ptr<BinaryTileTask> revalidation;
+    TileTaskCb callback;
+};
+
+TEST_CASE("Keep the expiry of data revalidated by a later source", TAGS) {
+    auto memoryCache = std::make_unique<MemoryCacheDataSource>();
+    memoryCache->setCacheSize(1024 * 1024);
+    memoryCache->setNext(std::make_unique<RevalidatingSource>());
+    auto& next = static_cast<RevalidatingSource&>(*memoryCache->next);
+
+    auto source = std::make_shared<TileSource>("test", std::move(memoryCache));
+
+    std::vector<std::shared_ptr<TileTask>> loaded;
+    TileTaskCb callback{[&](std::shared_ptr<TileTask> _task) { loaded.push_back(_task); }};
+
+    source->loadTileData(source->createTask(TileID(0, 0, 0)), callback);
+    REQUIRE(loaded.size() == 1);
+    REQUIRE(next.loads == 1);
+
+    // The not modified task is not passed on to the tile
+    next.notModified(int64_t(std::time(nullptr)) + 3600);
+    REQUIRE(loaded.size() == 1);
+
+    auto task = source->createTask(TileID(0, 0, 0));
+    source->loadTileData(task, callback);
+    REQUIRE(loaded.size() == 2);
+    CHECK(next.loads == 1);
+    CHECK_FALSE(static_cast<BinaryTileTask&>(*task).cacheInfo.isStale(std::time(nullptr)));
+}
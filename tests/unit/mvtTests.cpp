@@ -0,0 +1,126 @@
+#include "catch.hpp"
+
+#include "data/formats/mvt.h"
+
+#include <zlib.h>
+
+#include <string>
+#include <vector>
+
+using namespace Tangram;
+
+#define TAGS "[Mvt]"
+
+static void writeVarint(std::string& _out, uint64_t _value) {
+    while (_value >= 0x80) {
+        _out.push_back(char((_value & 0x7f) | 0x80));
+        _value >>= 7;
+    }
+    _out.push_back(char(_value));
+}
+
+static void writeMessage(std::string& _out, int _tag, const std::string& _message) {
+    writeVarint(_out, (_tag << 3) | 2);
+    writeVarint(_out, _message.size());
+    _out += _message;
+}
+
+// A layer with _count point features
+static std::string pointLayer(const std::string& _name, int _count) {
+    std::string layer;
+    writeMessage(layer, 1, _name);
+
+    for (int i = 0; i < _count; i++) {
+        std::string geometry;
+        writeVarint(geometry, (1 << 3) | 1); // MoveTo, one point
+        writeVarint(geometry, i * 2);
+        writeVarint(geometry, i * 2);
+
+        std::string feature;
+        writeVarint(feature, (3 << 3) | 0);
+        writeVarint(feature, 1); // Point
+        writeMessage(feature, 4, geometry);
+
+        writeMessage(layer, 2, feature);
+    }
+    writeVarint(layer, (5 << 3) | 0);
+    writeVarint(layer, 4096);
+
+    return layer;
+}
+
+static std::string testTile() {
+    std::string tile;
+    writeMessage(tile, 3, pointLayer("water", 3));
+    writeMessage(tile, 3, pointLayer("roads", 200));
+    writeMessage(tile, 3, pointLayer("places", 1));
+    return tile;
+}
+
+static std::string gzip(const std::string& _data) {
+    z_stream strm = {};
+    deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+
+    std::string out(deflateBound(&strm, _data.size()), '\0');
+    strm.next_in = (Bytef*)_data.data();
+    strm.avail_in = _data.size();
+    strm.next_out = (Bytef*)&out[0];
+    strm.avail_out = out.size();
+    deflate(&strm, Z_FINISH);
+    out.resize(strm.total_out);
+    deflateEnd(&strm);
+
+    return out;
+}
+
+static std::shared_ptr<TileData> parseChunks(Mvt::StreamParser& _parser, const std::string& _data, size_t _chunkSize) {
+    for (size_t offset = 0; offset < _data.size(); offset += _chunkSize) {
+        REQUIRE(_parser.add(_data.data() + offset, std::min(_chunkSize, _data.size() - offset)));
+    }
+    return _parser.finish();
+}
+
+TEST_CASE("Parse the layers of a tile that arrives in chunks", TAGS) {
+    auto tile = testTile();
+
+    for (size_t chunkSize : {size_t(1), size_t(7), size_t(100), tile.size()}) {
+        Mvt::StreamParser parser(0);
+        auto tileData = parseChunks(parser, tile, chunkSize);
+
+        REQUIRE(tileData);
+        REQUIRE(parser.received() == tile.size());
+        REQUIRE(tileData->layers.size() == 3);
+        CHECK(tileData->layers[0].name == "water");
+        CHECK(tileData->layers[0].features.size() == 3);
+        CHECK(tileData->layers[1].name == "roads");
+        CHECK(tileData->layers[1].features.size() == 200);
+        CHECK(tileData->layers[2].name == "places");
+        CHECK(tileData->layers[2].features.size() == 1);
+    }
+}
+
+TEST_CASE("Inflate gzip compressed tile data while it arrives", TAGS) {
+    auto tile = gzip(testTile());
+    REQUIRE(Mvt::isGzip(tile.data(), tile.size()));
+
+    Mvt::StreamParser parser(0);
+    auto tileData = parseChunks(parser, tile, 13);
+
+    REQUIRE(tileData);
+    REQUIRE(tileData->layers.size() == 3);
+    CHECK(tileData->layers[1].features.size() == 200);
+}
+
+TEST_CASE("Do not return a tile whose data ended within a layer", TAGS) {
+    auto tile = testTile();
+
+    Mvt::StreamParser parser(0);
+    auto tileData = parseChunks(parser, tile.substr(0, tile.size() - 10), 64);
+    CHECK(tileData == nullptr);
+
+    // Parse the data again after reset
+    parser.reset();
+    tileData = parseChunks(parser, tile, 64);
+    REQUIRE(tileData);
+    CHECK(tileData->layers.size() == 3);
+}
@@ -0,0 +1,45 @@
+#include "catch.hpp"
+
+#include "gl/hardware.h"
+#include "gl/programBinaryCache.h"
+#include "mockPlatform.h"
+
+using namespace Tangram;
+
+static const std::string vertSrc = "void main() { gl_Position = vec4(0.); }";
+static const std::string fragSrc = "void main() { gl_FragColor = vec4(1.); }";
+static const std::string driver = "Mesa\nllvmpipe\n3.0\n";
+
+TEST_CASE("Program binary keys are stable", "[ProgramBinaryCache]") {
+    auto key = ProgramBinaryCache::makeKey(vertSrc, fragSrc, driver);
+
+    REQUIRE(key == ProgramBinaryCache::makeKey(vertSrc, fragSrc, driver));
+
+    // Keys are persisted, so they must not change between runs or platforms.
+    REQUIRE(key == "v1-bf268ef4420fd388");
+}
+
+TEST_CASE("Program binary keys depend on sources and driver", "[ProgramBinaryCache]") {
+    auto key = ProgramBinaryCache::makeKey(vertSrc, fragSrc, driver);
+
+    REQUIRE(key != ProgramBinaryCache::makeKey(fragSrc, vertSrc, driver));
+    REQUIRE(key != ProgramBinaryCache::makeKey(vertSrc, fragSrc + " ", driver));
+    REQUIRE(key != ProgramBinaryCache::makeKey(vertSrc, fragSrc, "Mesa\nllvmpipe\n3.1\n"));
+
+    // Moving text between sources must change the key.
+    REQUIRE(ProgramBinaryCache::makeKey("ab", "c", "") != ProgramBinaryCache::makeKey("a", "bc", ""));
+}
+
+TEST_CASE("Missing program binaries are cache misses", "[ProgramBinaryCache]") {
+    MockPlatform platform;
+    ProgramBinaryCache cache(platform);
+
+    auto key = ProgramBinaryCache::makeKey(vertSrc, fragSrc, driver);
+    REQUIRE(cache.loadProgram(key) == 0);
+
+    cache.recordBuild(false, 2.f);
+    cache.recordBuild(true, 0.5f);
+    REQUIRE(cache.stats().coldBuilds == 1);
+    REQUIRE(cache.stats().warmBuilds == 1);
+    REQUIRE(cache.stats().coldTime == Approx(2.f));
+}
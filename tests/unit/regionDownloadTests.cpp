@@ -0,0 +1,171 @@
+#include "catch.hpp"
+
+#include "data/networkDataSource.h"
+#include "data/regionDownload.h"
+#include "mockPlatform.h"
+#include "tile/tileTask.h"
+
+#include <condition_variable>
+#include <mutex>
+
+using namespace Tangram;
+
+#define TAGS "[RegionDownload]"
+
+static const char tile_url[] = "https://tiles.test/{z}/{x}/{y}.mvt";
+
+static std::shared_ptr<TileSource> makeSource(MockPlatform& _platform) {
+    return std::make_shared<TileSource>("region", std::make_unique<NetworkDataSource>(_platform, tile_url,
+                                                                                      NetworkDataSource::UrlOptions{}));
+}
+
+static void putTile(MockPlatform& _platform, TileID _tileID, std::string _contents) {
+    _platform.putMockUrlContents(Url(NetworkDataSource::buildUrlForTile(_tileID, tile_url, {}, 0)), _contents);
+}
+
+TEST_CASE("Enumerate the tiles of a region", TAGS) {
+    RegionDownloadOptions options;
+
+    options.setBounds(LngLat(10, 10), LngLat(20, 20));
+    auto tiles = RegionDownload::regionTiles(options.polygon, 0, 2);
+
+    REQUIRE(tiles.size() == 3);
+    CHECK(tiles[0] == TileID(0, 0, 0));
+    CHECK(tiles[1] == TileID(1, 0, 1));
+    CHECK(tiles[2] == TileID(2, 1, 2));
+
+    // Triangle that does not reach the north-west quadrant
+    std::vector<LngLat> triangle = { LngLat(-10, -10), LngLat(10, -10), LngLat(10, 5) };
+    tiles = RegionDownload::regionTiles(triangle, 1, 1);
+
+    REQUIRE(tiles.size() == 3);
+    CHECK(tiles[0] == TileID(1, 0, 1));
+    CHECK(tiles[1] == TileID(0, 1, 1));
+    CHECK(tiles[2] == TileID(1, 1, 1));
+
+    // Tiles inside a polygon that covers them completely
+    options.setBounds(LngLat(-170, -80), LngLat(170, 80));
+    tiles = RegionDownload::regionTiles(options.polygon, 2, 2);
+
+    CHECK(tiles.size() == 16);
+}
+
+TEST_CASE("Bound the number of tiles of a region", TAGS) {
+    RegionDownloadOptions options;
+
+    options.setBounds(LngLat(10, 10), LngLat(20, 20));
+    CHECK(RegionDownload::maxRegionTiles(options.polygon, 0, 2) == 3);
+
+    // The triangle covers three of the four tiles of its bounding box
+    std::vector<LngLat> triangle = { LngLat(-10, -10), LngLat(10, -10), LngLat(10, 5) };
+    CHECK(RegionDownload::maxRegionTiles(triangle, 1, 1) == 4);
+
+    // Counted without enumerating the tiles
+    options.setBounds(LngLat(-170, -80), LngLat(170, 80));
+    CHECK(RegionDownload::maxRegionTiles(options.polygon, 20, 20) > (uint64_t(1) << 39));
+
+    CHECK(RegionDownload::maxRegionTiles({}, 0, 2) == 0);
+}
+
+TEST_CASE("Download the tiles of a region", TAGS) {
+    MockPlatform platform;
+    auto source = makeSource(platform);
+
+    putTile(platform, TileID(0, 0, 0), "tile0");
+    putTile(platform, TileID(1, 0, 1), "tile1");
+
+    RegionDownloadOptions options;
+    options.setBounds(LngLat(10, 10), LngLat(20, 20));
+    options.maxZoom = 2;
+    options.maxConcurrentRequests = 2;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    RegionDownloadProgress result;
+    size_t callbacks = 0;
+
+    auto download = std::make_shared<RegionDownload>(source, options, [&](const RegionDownloadProgress& _progress) {
+        std::lock_guard<std::mutex> lock(mutex);
+        result = _progress;
+        callbacks++;
+        condition.notify_all();
+    });
+    download->start();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return result.finished; });
+    }
+
+    // Tile 2/1/2 is missing
+    CHECK(result.tilesTotal == 3);
+    CHECK(result.tilesLoaded == 2);
+    CHECK(result.tilesFailed == 1);
+    CHECK(result.bytes == 10);
+    CHECK(result.canceled == false);
+    CHECK(callbacks == 4);
+
+    download->cancel();
+    CHECK(download->progress().canceled == false);
+}
+
+TEST_CASE("Cancel a rate limited region download", TAGS) {
+    MockPlatform platform;
+    auto source = makeSource(platform);
+
+    putTile(platform, TileID(0, 0, 0), "tile0");
+
+    RegionDownloadOptions options;
+    options.setBounds(LngLat(10, 10), LngLat(20, 20));
+    options.maxZoom = 2;
+    options.maxRequestsPerSecond = 0.1f;
+
+    auto download = std::make_shared<RegionDownload>(source, options, nullptr);
+    download->start();
+    download->cancel();
+
+    auto progress = download->progress();
+    CHECK(progress.canceled == true);
+    CHECK(progress.finished == true);
+    CHECK(progress.tilesLoaded + progress.tilesFailed <= 1);
+}
+
+TEST_CASE("Tiles of sources without binary data fail to download", TAGS) {
+    // Like ClientDataSource, creates tasks that hold TileData instead of raw data
+    struct PlainTaskSource : TileSource {
+        PlainTaskSource() : TileSource("plain", nullptr) {}
+
+        std::shared_ptr<TileTask> createTask(TileID _tileId) override {
+            return std::make_shared<TileTask>(_tileId, shared_from_this());
+        }
+        void loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override {
+            _task->startedLoading();
+            _cb.func(_task);
+        }
+    };
+    auto source = std::make_shared<PlainTaskSource>();
+
+    RegionDownloadOptions options;
+    options.setBounds(LngLat(10, 10), LngLat(20, 20));
+    options.maxZoom = 1;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    RegionDownloadProgress progress;
+
+    auto download = std::make_shared<RegionDownload>(source, options, [&](const RegionDownloadProgress& _progress) {
+        std::lock_guard<std::mutex> lock(mutex);
+        progress = _progress;
+        condition.notify_all();
+    });
+    download->start();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return progress.finished; });
+    }
+
+    CHECK(progress.tilesTotal == 2);
+    CHECK(progress.tilesLoaded == 0);
+    CHECK(progress.tilesFailed == 2);
+}
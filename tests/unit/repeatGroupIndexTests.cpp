@@ -0,0 +1,54 @@
+#include "catch.hpp"
+
+#include "labels/repeatGroupIndex.h"
+
+using namespace Tangram;
+
+TEST_CASE("RepeatGroupIndex finds labels within the repeat distance", "[RepeatGroupIndex]") {
+    RepeatGroupIndex index;
+
+    REQUIRE_FALSE(index.within(1, {100, 100}, 50));
+
+    index.insert(1, {100, 100}, 50);
+
+    REQUIRE(index.within(1, {100, 100}, 50));
+    // Neighbouring cells
+    REQUIRE(index.within(1, {130, 130}, 50));
+    REQUIRE(index.within(1, {65, 70}, 50));
+    // The distance is exclusive
+    REQUIRE_FALSE(index.within(1, {150, 100}, 50));
+    REQUIRE_FALSE(index.within(1, {200, 200}, 50));
+
+    // Other groups
+    REQUIRE_FALSE(index.within(2, {100, 100}, 50));
+
+    // Distances larger than the cells of the group
+    REQUIRE(index.within(1, {400, 100}, 500));
+
+    // Negative positions
+    index.insert(1, {-20, -20}, 50);
+    REQUIRE(index.within(1, {10, -10}, 50));
+
+    index.clear();
+    REQUIRE_FALSE(index.within(1, {100, 100}, 50));
+}
+
+TEST_CASE("RepeatGroupIndex finds labels of large groups", "[RepeatGroupIndex]") {
+    RepeatGroupIndex index;
+
+    // Labels along a long road
+    for (int i = 0; i < 100; i++) {
+        index.insert(1, {i * 60.f, 100}, 50);
+    }
+
+    REQUIRE(index.within(1, {0, 100}, 50));
+    REQUIRE(index.within(1, {5980, 100}, 50));
+    REQUIRE(index.within(1, {3030, 130}, 50));
+    REQUIRE_FALSE(index.within(1, {3030, 200}, 50));
+    REQUIRE_FALSE(index.within(1, {6100, 100}, 50));
+    REQUIRE_FALSE(index.within(1, {-60, 100}, 50));
+
+    // Distances that span many cells
+    REQUIRE(index.within(1, {3030, 600}, 501));
+    REQUIRE_FALSE(index.within(1, {3030, 600}, 500));
+}
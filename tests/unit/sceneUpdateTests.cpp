@@ -231,3 +231,65 @@ TEST_CASE("Scene update statuses") {
         CHECK(SceneLoader::applyUpdates(config, updates).error == Error::scene_update_value_yaml_syntax_error);
     }
 }
+
+const static std::string styledSceneString = R"END(
+styles:
+    dashed:
+        base: lines
+        dash: [1, 1]
+layers:
+    roads:
+        data: { source: osm }
+        draw:
+            lines: { color: white, width: 1px }
+        paths:
+            filter: { kind: path }
+            draw:
+                lines: { style: dashed }
+    water:
+        data: { source: osm }
+        draw:
+            polygons: { color: blue }
+)END";
+
+Scene::StyleHashes styleHashesWithUpdates(const std::vector<SceneUpdate>& _updates) {
+    Node config;
+    REQUIRE(loadConfig(styledSceneString, config));
+    SceneLoader::applyUpdates(config, _updates);
+    return SceneLoader::applyStyleDependencies(config);
+}
+
+TEST_CASE("Scene updates only change the hashes of affected styles") {
+    auto base = styleHashesWithUpdates({});
+
+    REQUIRE(base.find("lines") != base.end());
+    REQUIRE(base.find("dashed") != base.end());
+    REQUIRE(base.find("polygons") != base.end());
+
+    SECTION("draw parameter") {
+        auto hashes = styleHashesWithUpdates({{"layers.water.draw.polygons.color", "red"}});
+        CHECK(hashes.find("polygons")->second != base.find("polygons")->second);
+        CHECK(hashes.find("lines")->second == base.find("lines")->second);
+        CHECK(hashes.find("dashed")->second == base.find("dashed")->second);
+    }
+
+    SECTION("draw group inherited by a sublayer with another style") {
+        // The 'lines' group of 'paths' inherits the color but draws with 'dashed'
+        auto hashes = styleHashesWithUpdates({{"layers.roads.draw.lines.color", "red"}});
+        CHECK(hashes.find("lines")->second != base.find("lines")->second);
+        CHECK(hashes.find("dashed")->second != base.find("dashed")->second);
+        CHECK(hashes.find("polygons")->second == base.find("polygons")->second);
+    }
+
+    SECTION("layer filter") {
+        auto hashes = styleHashesWithUpdates({{"layers.roads.paths.filter", "{ kind: track }"}});
+        CHECK(hashes.find("lines")->second != base.find("lines")->second);
+        CHECK(hashes.find("polygons")->second == base.find("polygons")->second);
+    }
+
+    SECTION("style definition") {
+        auto hashes = styleHashesWithUpdates({{"styles.dashed.dash", "[2, 1]"}});
+        CHECK(hashes.find("dashed")->second != base.find("dashed")->second);
+        CHECK(hashes.find("lines")->second == base.find("lines")->second);
+    }
+}
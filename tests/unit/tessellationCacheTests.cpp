@@ -0,0 +1,89 @@
+#include "catch.hpp"
+
+#include "util/builders.h"
+
+using namespace Tangram;
+
+static Polygon square(float _size) {
+    return { { {0, 0}, {_size, 0}, {_size, _size}, {0, _size}, {0, 0} } };
+}
+
+TEST_CASE("Cached polygon triangulation matches uncached build", "[TessellationCache]") {
+    Polygon polygon = square(1.f);
+
+    PolygonBuilder uncached;
+    Builders::buildPolygon(polygon, 0.f, uncached);
+
+    TessellationCache cache;
+    PolygonBuilder cached;
+    cached.tessellationCache = &cache;
+
+    Builders::buildPolygon(polygon, 0.f, cached);
+    REQUIRE(cache.misses() == 1);
+    REQUIRE(cache.hits() == 0);
+    REQUIRE(cached.indices == uncached.indices);
+    REQUIRE(cached.numVertices == uncached.numVertices);
+
+    cached.clear();
+    Builders::buildPolygon(polygon, 0.f, cached);
+    REQUIRE(cache.misses() == 1);
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cached.indices == uncached.indices);
+}
+
+TEST_CASE("Tessellation cache is keyed by geometry", "[TessellationCache]") {
+    TessellationCache cache;
+    PolygonBuilder builder;
+    builder.tessellationCache = &cache;
+
+    // Equal geometry of different features shares one entry
+    Polygon a = square(1.f);
+    Polygon b = square(1.f);
+    Builders::buildPolygon(a, 0.f, builder);
+    Builders::buildPolygon(b, 0.f, builder);
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.hits() == 1);
+
+    Polygon c = square(0.5f);
+    Builders::buildPolygon(c, 0.f, builder);
+    REQUIRE(cache.size() == 2);
+    REQUIRE(TessellationCache::hash(a) == TessellationCache::hash(b));
+    REQUIRE(TessellationCache::hash(a) != TessellationCache::hash(c));
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("Tessellation cache is bounded by its entry count", "[TessellationCache]") {
+    std::vector<Polygon> polygons;
+    for (size_t i = 0; i <= TessellationCache::max_entries; i++) {
+        polygons.push_back(square(1.f + i));
+    }
+
+    TessellationCache cache;
+    PolygonBuilder builder;
+    builder.tessellationCache = &cache;
+
+    for (auto& polygon : polygons) {
+        builder.clear();
+        Builders::buildPolygon(polygon, 0.f, builder);
+    }
+    REQUIRE(cache.size() == TessellationCache::max_entries);
+
+    // Polygons that did not fit are still triangulated
+    PolygonBuilder uncached;
+    Builders::buildPolygon(polygons.back(), 0.f, uncached);
+    builder.clear();
+    Builders::buildPolygon(polygons.back(), 0.f, builder);
+    REQUIRE(builder.indices == uncached.indices);
+}
+
+TEST_CASE("Estimated memory of a triangulation covers its indices", "[TessellationCache]") {
+    Polygon polygon = square(4.f);
+    polygon.push_back({ {1, 1}, {1, 2}, {2, 2}, {2, 1}, {1, 1} });
+
+    PolygonBuilder builder;
+    Builders::buildPolygon(polygon, 0.f, builder);
+
+    REQUIRE(TessellationCache::memoryUsage(polygon) > builder.earcut.indices.size() * sizeof(uint16_t));
+}
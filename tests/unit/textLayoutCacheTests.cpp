@@ -0,0 +1,75 @@
+#include "catch.hpp"
+
+#include "text/textLayoutCache.h"
+
+#include <array>
+
+using namespace Tangram;
+
+static TextLayoutCache::Key layoutKey(const char* _text, float _maxLineWidth = 0) {
+    return { nullptr, 1.f, icu::UnicodeString::fromUTF8(_text), _maxLineWidth, 0, 0, 1 };
+}
+
+static std::shared_ptr<const TextLayout> layoutWithAtlas(size_t _atlas, uint32_t _generation) {
+    auto layout = std::make_shared<TextLayout>();
+    layout->quads.resize(3);
+    layout->textRanges = {{ Range(0, 3), Range(3, 0), Range(3, 0) }};
+    layout->size = glm::vec2(10, 4);
+    layout->atlases.emplace_back(_atlas, _generation);
+    return layout;
+}
+
+TEST_CASE("TextLayoutCache returns layouts by text and layout parameters", "[TextLayoutCache]") {
+    TextLayoutCache cache(4);
+    std::array<uint32_t, 2> generations = {{ 0, 0 }};
+
+    auto layout = layoutWithAtlas(0, 0);
+    cache.put(layoutKey("Main Street"), layout);
+
+    REQUIRE(cache.get(layoutKey("Main Street"), generations.data()) == layout);
+    REQUIRE(cache.get(layoutKey("Main Street", 15), generations.data()) == nullptr);
+    REQUIRE(cache.get(layoutKey("Main St"), generations.data()) == nullptr);
+
+    auto stats = cache.stats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.entries == 1);
+    REQUIRE(stats.memoryUsage >= 3 * sizeof(GlyphQuad));
+}
+
+TEST_CASE("TextLayoutCache drops layouts of cleared glyph atlases", "[TextLayoutCache]") {
+    TextLayoutCache cache(4);
+    std::array<uint32_t, 2> generations = {{ 0, 0 }};
+
+    cache.put(layoutKey("Main Street"), layoutWithAtlas(1, 0));
+
+    generations[0] += 1;
+    REQUIRE(cache.get(layoutKey("Main Street"), generations.data()) != nullptr);
+
+    generations[1] += 1;
+    REQUIRE(cache.get(layoutKey("Main Street"), generations.data()) == nullptr);
+    REQUIRE(cache.stats().entries == 0);
+    REQUIRE(cache.stats().memoryUsage == 0);
+}
+
+TEST_CASE("TextLayoutCache evicts least recently used layouts", "[TextLayoutCache]") {
+    TextLayoutCache cache(2);
+    std::array<uint32_t, 1> generations = {{ 0 }};
+
+    cache.put(layoutKey("a"), layoutWithAtlas(0, 0));
+    cache.put(layoutKey("b"), layoutWithAtlas(0, 0));
+
+    // Touch the first entry so that the second one is evicted
+    REQUIRE(cache.get(layoutKey("a"), generations.data()) != nullptr);
+
+    cache.put(layoutKey("c"), layoutWithAtlas(0, 0));
+
+    REQUIRE(cache.stats().entries == 2);
+    REQUIRE(cache.get(layoutKey("a"), generations.data()) != nullptr);
+    REQUIRE(cache.get(layoutKey("b"), generations.data()) == nullptr);
+    REQUIRE(cache.get(layoutKey("c"), generations.data()) != nullptr);
+
+    cache.clear();
+    REQUIRE(cache.stats().entries == 0);
+    REQUIRE(cache.stats().memoryUsage == 0);
+}
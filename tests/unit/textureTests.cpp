@@ -3,6 +3,8 @@
 #include "gl/texture.h"
 #include "gl/glyphTexture.h"
 
+#include <cstring>
+
 using namespace Tangram;
 
 struct TestTexture : public GlyphTexture {
@@ -113,3 +115,25 @@ TEST_CASE("Merging of dirty Regions - Merge three regions, when 3rd region is ad
     }
 
 }
+
+TEST_CASE("Glyph cells are copied in and out of the texture buffer", "[Texture]") {
+    TestTexture texture(8);
+
+    unsigned char cell[6] = { 1, 2, 3,
+                              4, 5, 6 };
+    texture.writeCell(2, 3, 3, 2, cell);
+
+    REQUIRE(texture.buffer()[2 + 3 * 8] == 1);
+    REQUIRE(texture.buffer()[4 + 3 * 8] == 3);
+    REQUIRE(texture.buffer()[2 + 4 * 8] == 4);
+    REQUIRE(texture.buffer()[5 + 3 * 8] == 0);
+
+    // Only the rows of the cell need to be uploaded
+    REQUIRE(texture.dirtyRanges().size() == 1);
+    REQUIRE(texture.dirtyRanges()[0].min == 3);
+    REQUIRE(texture.dirtyRanges()[0].max == 5);
+
+    unsigned char read[6] = {};
+    texture.readCell(2, 3, 3, 2, read);
+    REQUIRE(std::memcmp(read, cell, sizeof(cell)) == 0);
+}
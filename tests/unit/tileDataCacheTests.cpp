@@ -0,0 +1,102 @@
+#include "catch.hpp"
+
+#include "data/propertyItem.h"
+#include "data/tileData.h"
+#include "data/tileDataCache.h"
+
+using namespace Tangram;
+
+static const size_t emptyTileDataUsage = TileDataCache::memoryUsage(TileData());
+
+TEST_CASE("TileDataCache returns TileData by source key, generation and TileID", "[TileDataCache]") {
+    TileDataCache cache(4 * emptyTileDataUsage);
+
+    auto tileData = std::make_shared<TileData>();
+    cache.put("osm", 1, TileID(1, 2, 3), tileData);
+
+    REQUIRE(cache.get("osm", 1, TileID(1, 2, 3)) == tileData);
+    REQUIRE(cache.get("osm", 2, TileID(1, 2, 3)) == nullptr);
+    REQUIRE(cache.get("other", 1, TileID(1, 2, 3)) == nullptr);
+    REQUIRE(cache.get("osm", 1, TileID(2, 2, 3)) == nullptr);
+}
+
+TEST_CASE("TileDataCache evicts least recently used TileData", "[TileDataCache]") {
+    TileDataCache cache(2 * emptyTileDataUsage);
+
+    cache.put("osm", 1, TileID(0, 0, 1), std::make_shared<TileData>());
+    cache.put("osm", 1, TileID(1, 0, 1), std::make_shared<TileData>());
+
+    // Touch the first entry so that the second one is evicted
+    REQUIRE(cache.get("osm", 1, TileID(0, 0, 1)) != nullptr);
+
+    cache.put("osm", 1, TileID(0, 1, 1), std::make_shared<TileData>());
+
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.get("osm", 1, TileID(0, 0, 1)) != nullptr);
+    REQUIRE(cache.get("osm", 1, TileID(1, 0, 1)) == nullptr);
+    REQUIRE(cache.get("osm", 1, TileID(0, 1, 1)) != nullptr);
+
+    cache.setMaxUsage(emptyTileDataUsage);
+    REQUIRE(cache.size() == 1);
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.getMemoryUsage() == 0);
+}
+
+TEST_CASE("TileDataCache is bounded by the estimated size of TileData", "[TileDataCache]") {
+    auto large = std::make_shared<TileData>();
+    large->layers.emplace_back("buildings");
+    for (int i = 0; i < 100; i++) {
+        large->layers[0].features.emplace_back();
+        large->layers[0].features.back().polygons.push_back({ Line(64) });
+    }
+    size_t largeUsage = TileDataCache::memoryUsage(*large);
+    // Includes the triangle indices of the polygons, which are retained once built
+    REQUIRE(largeUsage > 100 * (64 * sizeof(Point) + 3 * 62 * sizeof(uint16_t)));
+
+    TileDataCache cache(largeUsage + emptyTileDataUsage);
+
+    cache.put("osm", 1, TileID(0, 0, 1), std::make_shared<TileData>());
+    cache.put("osm", 1, TileID(1, 0, 1), large);
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.getMemoryUsage() == largeUsage + emptyTileDataUsage);
+
+    // New entries evict the least recently used ones until they fit
+    cache.put("osm", 1, TileID(0, 1, 1), std::make_shared<TileData>());
+    cache.put("osm", 1, TileID(1, 1, 1), std::make_shared<TileData>());
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.get("osm", 1, TileID(1, 0, 1)) == nullptr);
+    REQUIRE(cache.getMemoryUsage() == 2 * emptyTileDataUsage);
+}
+
+TEST_CASE("TileDataCache with zero entries retains nothing", "[TileDataCache]") {
+    TileDataCache cache;
+
+    cache.put("osm", 1, TileID(0, 0, 0), std::make_shared<TileData>());
+
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.get("osm", 1, TileID(0, 0, 0)) == nullptr);
+}
+
+TEST_CASE("TileDataCache parses TileData of a key once", "[TileDataCache]") {
+    TileDataCache cache(4 * emptyTileDataUsage);
+
+    int parses = 0;
+    auto parse = [&]() {
+        parses++;
+        return std::make_shared<TileData>();
+    };
+
+    auto tileData = cache.getOrParse("osm", 1, TileID(0, 0, 0), parse);
+
+    REQUIRE(tileData != nullptr);
+    CHECK(cache.getOrParse("osm", 1, TileID(0, 0, 0), parse) == tileData);
+    CHECK(cache.get("osm", 1, TileID(0, 0, 0)) == tileData);
+    CHECK(parses == 1);
+
+    // Failed parses are not retained
+    CHECK(cache.getOrParse("osm", 1, TileID(1, 0, 1), []() { return nullptr; }) == nullptr);
+    CHECK(cache.getOrParse("osm", 1, TileID(1, 0, 1), parse) != nullptr);
+    CHECK(parses == 2);
+}
@@ -9,10 +9,11 @@
 #include "view/view.h"
 
 #include <deque>
+#include <set>
 
 using namespace Tangram;
 
-ViewState viewState { true, glm::vec2(0), 1, 0, 1.f, glm::vec2(0), 256.f };
+ViewState viewState { true, glm::vec2(0), 1, 0, 1.f, glm::vec2(0), 256.f, 0.f, 0.f };
 
 struct TestTileWorker : TileTaskQueue {
     int processedCount = 0;
@@ -113,7 +114,8 @@ public:
     using Base = TileManager;
     using Base::Base;
 
-    void updateTiles(const ViewState& _view, std::set<TileID> _visibleTiles) {
+    void updateTiles(const ViewState& _view, std::set<TileID> _visibleTiles,
+                     std::set<TileID> _prefetchTiles = {}) {
         // Mimic TileManager::updateTileSets(View& _view)
         m_tiles.clear();
         m_tilesInProgress = 0;
@@ -121,7 +123,8 @@ public:
 
         TileSet& tileSet = m_tileSets[0];
 
-        tileSet.visibleTiles = _visibleTiles;
+        tileSet.visibleTiles.assign(_visibleTiles.begin(), _visibleTiles.end());
+        tileSet.prefetchTiles.assign(_prefetchTiles.begin(), _prefetchTiles.end());
 
         TileManager::updateTileSet(tileSet, _view);
 
@@ -309,3 +312,168 @@ TEST_CASE( "Use proxy Tile - circular proxies", "[TileManager][updateTileSets]"
     REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(0,0,0));
 
 }
+
+TEST_CASE( "Prefetch Tile", "[TileManager][updateTileSets]" ) {
+    TestTileWorker worker;
+    MockPlatform platform;
+    TestTileManager tileManager(platform, worker);
+
+    auto source = std::make_shared<TestTileSource>();
+    std::vector<std::shared_ptr<TileSource>> sources = { source };
+    tileManager.setTileSources(sources);
+
+    std::set<TileID> visibleTiles_1 = {TileID{0,0,1}};
+    std::set<TileID> visibleTiles_2 = {TileID{1,0,1}};
+
+    /// Load tile 0/0/1 and prefetch 1/0/1
+    tileManager.updateTiles(viewState, visibleTiles_1, visibleTiles_2);
+
+    REQUIRE(source->tileTaskCount == 2);
+    REQUIRE(worker.tasks.size() == 2);
+    // Visible tile is loaded first
+    REQUIRE(worker.tasks[0]->tileId() == TileID(0,0,1));
+    REQUIRE(worker.tasks[1]->isPrefetch());
+    REQUIRE(worker.tasks[0]->loadsBefore(*worker.tasks[1]));
+    REQUIRE(worker.tasks[0]->requestPriority() < worker.tasks[1]->requestPriority());
+
+    worker.processTask();
+    worker.processTask();
+
+    /// Prefetched tile is not rendered
+    tileManager.updateTiles(viewState, visibleTiles_1, visibleTiles_2);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(0,0,1));
+
+    /// Prefetched tile is ready when it becomes visible
+    tileManager.updateTiles(viewState, visibleTiles_2);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(1,0,1));
+    REQUIRE(source->tileTaskCount == 2);
+
+    /// Prefetch 1/1/1 and cancel it when it is no longer predicted
+    std::set<TileID> prefetchTiles = {TileID{1,1,1}};
+    tileManager.updateTiles(viewState, visibleTiles_2, prefetchTiles);
+
+    REQUIRE(source->tileTaskCount == 3);
+    REQUIRE(worker.tasks.size() == 1);
+    REQUIRE(worker.tasks[0]->isCanceled() == false);
+
+    tileManager.updateTiles(viewState, visibleTiles_2);
+
+    REQUIRE(worker.tasks[0]->isCanceled() == true);
+}
+
+TEST_CASE( "Skip update of an unchanged view", "[TileManager][updateTileSets]" ) {
+    TestTileWorker worker;
+    MockPlatform platform;
+    TileManager tileManager(platform, worker);
+
+    auto source = std::make_shared<TestTileSource>();
+    std::vector<std::shared_ptr<TileSource>> sources = { source };
+    tileManager.setTileSources(sources);
+
+    View view(256, 256);
+    view.setZoom(0);
+    view.update();
+
+    REQUIRE(tileManager.needsUpdate(view) == true);
+    tileManager.updateTileSets(view);
+
+    /// Tiles are loading
+    view.update();
+    REQUIRE(worker.tasks.size() > 0);
+    REQUIRE(tileManager.needsUpdate(view) == true);
+
+    while (!worker.tasks.empty()) { worker.processTask(); }
+    tileManager.updateTileSets(view);
+
+    REQUIRE(tileManager.getVisibleTiles().size() > 0);
+    REQUIRE(tileManager.hasLoadingTiles() == false);
+
+    /// Nothing changed
+    view.update();
+    REQUIRE(tileManager.needsUpdate(view) == false);
+
+    /// Source visibility changed
+    source->setVisible(false);
+    REQUIRE(tileManager.needsUpdate(view) == true);
+    source->setVisible(true);
+    REQUIRE(tileManager.needsUpdate(view) == false);
+
+    /// Forced, e.g. after the GL context was recreated
+    tileManager.setNeedsUpdate();
+    REQUIRE(tileManager.needsUpdate(view) == true);
+    tileManager.updateTileSets(view);
+    view.update();
+    REQUIRE(tileManager.needsUpdate(view) == false);
+
+    /// View changed
+    view.setZoom(1);
+    view.update();
+    REQUIRE(tileManager.needsUpdate(view) == true);
+}
+
+TEST_CASE( "Reload Tile whose data changed", "[TileManager][updateTileSets]" ) {
+    TestTileWorker worker;
+    MockPlatform platform;
+    TestTileManager tileManager(platform, worker);
+
+    auto source = std::make_shared<TestTileSource>();
+    std::vector<std::shared_ptr<TileSource>> sources = { source };
+    tileManager.setTileSources(sources);
+
+    std::set<TileID> visibleTiles = {TileID{0,0,0}};
+    tileManager.updateTiles(viewState, visibleTiles);
+    worker.processTask();
+    tileManager.updateTiles(viewState, visibleTiles);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    auto tile = tileManager.getVisibleTiles()[0];
+
+    // Revalidation found changed data
+    TileID tileId{0,0,0};
+    TestTileSource::Task revalidation(tileId, source);
+    source->tileDataChanged(revalidation);
+
+    REQUIRE(source->hasChangedTiles());
+
+    tileManager.updateTiles(viewState, visibleTiles);
+    REQUIRE_FALSE(source->hasChangedTiles());
+
+    // The previous tile is shown while reloading
+    REQUIRE(source->tileTaskCount == 2);
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(tileManager.getVisibleTiles()[0] == tile);
+    REQUIRE(tileManager.hasLoadingTiles());
+
+    worker.processTask();
+    tileManager.updateTiles(viewState, visibleTiles);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(tileManager.getVisibleTiles()[0] != tile);
+    REQUIRE(tileManager.hasTileSetChanged());
+    REQUIRE(tileManager.hasLoadingTiles() == false);
+}
+
+TEST_CASE( "Prefetched tasks load after other tasks in distance order", "[TileManager][updateTileSets]" ) {
+    auto source = std::make_shared<TestTileSource>();
+    TileID id{0,0,1};
+
+    double maxPriority = 2 * MapProjection::EARTH_CIRCUMFERENCE_METERS *
+        MapProjection::EARTH_CIRCUMFERENCE_METERS * TileTask::max_priority_scale;
+
+    TileTask visible(id, source), near(id, source), far(id, source);
+    visible.setPriority(maxPriority);
+    near.setPriority(1e6, true);
+    // One square meter further away
+    far.setPriority(1e6 + 1, true);
+
+    REQUIRE(visible.loadsBefore(near));
+    REQUIRE(near.loadsBefore(far));
+    REQUIRE_FALSE(far.loadsBefore(near));
+
+    REQUIRE(visible.requestPriority() < near.requestPriority());
+    REQUIRE(near.requestPriority() < far.requestPriority());
+}
@@ -0,0 +1,75 @@
+#include "catch.hpp"
+
+#include "urlHostLimits.h"
+
+using namespace Tangram;
+
+#define TAGS "[UrlHostLimits]"
+
+TEST_CASE("Limit the active requests per host", TAGS) {
+    UrlHostLimits limits(20, 2, 64);
+
+    REQUIRE(limits.canStart("https://a.com"));
+    REQUIRE_FALSE(limits.start("https://a.com"));
+    REQUIRE_FALSE(limits.start("https://a.com"));
+
+    CHECK(limits.hostFull("https://a.com"));
+    CHECK_FALSE(limits.canStart("https://a.com"));
+    CHECK(limits.canStart("https://b.com"));
+    CHECK(limits.connectionTasks() == 2);
+
+    limits.finish("https://a.com", false);
+    CHECK(limits.canStart("https://a.com"));
+    CHECK(limits.activeTasks("https://a.com") == 1);
+    CHECK(limits.connectionTasks() == 1);
+}
+
+TEST_CASE("Limit the requests over separate connections", TAGS) {
+    UrlHostLimits limits(3, 2, 64);
+
+    limits.start("https://a.com");
+    limits.start("https://a.com");
+    limits.start("https://b.com");
+
+    CHECK_FALSE(limits.hostFull("https://c.com"));
+    CHECK(limits.connectionsFull("https://c.com"));
+    CHECK_FALSE(limits.canStart("https://c.com"));
+
+    limits.finish("https://b.com", false);
+    CHECK(limits.canStart("https://c.com"));
+}
+
+TEST_CASE("Multiplexed requests use the limit for multiplexed hosts and no connection", TAGS) {
+    UrlHostLimits limits(2, 2, 4);
+
+    limits.start("https://b.com");
+    limits.start("https://b.com");
+    CHECK(limits.connectionsFull("https://a.com"));
+
+    limits.setMultiplexed("https://a.com");
+    CHECK(limits.canStart("https://a.com"));
+
+    for (int i = 0; i < 4; i++) {
+        REQUIRE(limits.canStart("https://a.com"));
+        REQUIRE(limits.start("https://a.com"));
+    }
+    CHECK(limits.hostFull("https://a.com"));
+    CHECK(limits.connectionTasks() == 2);
+
+    limits.finish("https://a.com", true);
+    CHECK(limits.canStart("https://a.com"));
+    CHECK(limits.connectionTasks() == 2);
+}
+
+TEST_CASE("Requests started before a host multiplexes keep their connection", TAGS) {
+    UrlHostLimits limits(20, 6, 64);
+
+    bool multiplexed = limits.start("https://a.com");
+    REQUIRE_FALSE(multiplexed);
+    limits.setMultiplexed("https://a.com");
+    CHECK(limits.connectionTasks() == 1);
+
+    limits.finish("https://a.com", multiplexed);
+    CHECK(limits.connectionTasks() == 0);
+    CHECK(limits.activeTasks("https://a.com") == 0);
+}
@@ -0,0 +1,147 @@
+#include "catch.hpp"
+
+#include "data/urlRequestCoalescer.h"
+#include "mockPlatform.h"
+
+#include <map>
+#include <vector>
+
+using namespace Tangram;
+
+#define TAGS "[UrlRequestCoalescer]"
+
+// Responds to URL requests only when asked to
+class DeferredPlatform : public MockPlatform {
+public:
+    bool startUrlRequestImpl(const Url& _url, const UrlRequestHandle _handle, UrlRequestId& _id) override {
+        started.push_back(_handle);
+        _id = _handle;
+        return true;
+    }
+
+    void cancelUrlRequestImpl(const UrlRequestId _id) override {
+        canceled.push_back(_id);
+    }
+
+    void setUrlRequestPriorityImpl(const UrlRequestId _id, double _priority) override {
+        priorities[_id] = _priority;
+    }
+
+    void respond(UrlRequestHandle _handle, std::string _contents) {
+        UrlResponse response;
+        response.content.assign(_contents.begin(), _contents.end());
+        onUrlResponse(_handle, std::move(response));
+    }
+
+    void stream(UrlRequestHandle _handle, size_t _offset, std::string _data) {
+        onUrlData(_handle, _offset, _data.data(), _data.size());
+    }
+
+    std::vector<UrlRequestHandle> started;
+    std::vector<UrlRequestId> canceled;
+    std::map<UrlRequestId, double> priorities;
+};
+
+TEST_CASE("Share a URL request between callers of the same key", TAGS) {
+    DeferredPlatform platform;
+    auto coalescer = std::make_shared<UrlRequestCoalescer>(platform);
+
+    std::vector<std::string> responses;
+    auto callback = [&]() {
+        return [&](UrlResponse&& _response) {
+            responses.emplace_back(_response.content.begin(), _response.content.end());
+        };
+    };
+
+    coalescer->startRequest("tile/0/0/0", Url("https://a.tiles.test/0/0/0"), callback());
+    coalescer->startRequest("tile/0/0/0", Url("https://b.tiles.test/0/0/0"), callback());
+    coalescer->startRequest("tile/1/0/0", Url("https://a.tiles.test/1/0/0"), callback());
+
+    REQUIRE(platform.started.size() == 2);
+    CHECK(coalescer->stats().requests == 2);
+    CHECK(coalescer->stats().coalesced == 1);
+
+    platform.respond(platform.started[0], "tile0");
+
+    REQUIRE(responses.size() == 2);
+    CHECK(responses[0] == "tile0");
+    CHECK(responses[1] == "tile0");
+
+    // A request for a key that is no longer in flight is started again
+    coalescer->startRequest("tile/0/0/0", Url("https://a.tiles.test/0/0/0"), callback());
+    CHECK(platform.started.size() == 3);
+}
+
+TEST_CASE("Cancel a shared URL request with its last caller", TAGS) {
+    DeferredPlatform platform;
+    auto coalescer = std::make_shared<UrlRequestCoalescer>(platform);
+
+    int responses = 0;
+    auto first = coalescer->startRequest("tile", Url("https://tiles.test/0/0/0"), [&](UrlResponse&&) { responses++; });
+    auto second = coalescer->startRequest("tile", Url("https://tiles.test/0/0/0"), [&](UrlResponse&&) { responses++; });
+
+    REQUIRE(platform.started.size() == 1);
+
+    coalescer->cancelRequest(first);
+    CHECK(platform.canceled.empty());
+
+    coalescer->cancelRequest(second);
+    CHECK(platform.canceled.size() == 1);
+
+    platform.respond(platform.started[0], "tile");
+    CHECK(responses == 0);
+}
+
+TEST_CASE("Load a shared URL request with the highest priority of its callers", TAGS) {
+    DeferredPlatform platform;
+    auto coalescer = std::make_shared<UrlRequestCoalescer>(platform);
+
+    auto first = coalescer->startRequest("tile", Url("https://tiles.test/0/0/0"), [](UrlResponse&&) {});
+    auto second = coalescer->startRequest("tile", Url("https://tiles.test/0/0/0"), [](UrlResponse&&) {});
+
+    REQUIRE(platform.started.size() == 1);
+    auto request = platform.started[0];
+
+    coalescer->setRequestPriority(first, 10);
+    coalescer->setRequestPriority(second, 5);
+    CHECK(platform.priorities[request] == 5);
+
+    coalescer->setRequestPriority(first, 2);
+    CHECK(platform.priorities[request] == 2);
+
+    // The remaining caller determines the priority
+    coalescer->cancelRequest(first);
+    CHECK(platform.priorities[request] == 5);
+}
+
+TEST_CASE("Pass the content of a shared URL request to one stream callback", TAGS) {
+    DeferredPlatform platform;
+    auto coalescer = std::make_shared<UrlRequestCoalescer>(platform);
+
+    std::string first, second;
+    int responses = 0;
+    auto handle = coalescer->startRequest("tile", Url("https://tiles.test/0/0/0"), {}, [&](UrlResponse&&) { responses++; },
+                                          [&](size_t, const char* _data, size_t _size) { first.append(_data, _size); });
+    coalescer->startRequest("tile", Url("https://tiles.test/0/0/0"), {}, [&](UrlResponse&&) { responses++; },
+                            [&](size_t, const char* _data, size_t _size) { second.append(_data, _size); });
+
+    REQUIRE(platform.started.size() == 1);
+    auto request = platform.started[0];
+
+    platform.stream(request, 0, "ti");
+    CHECK(first == "ti");
+    CHECK(second.empty());
+
+    // The remaining caller receives the rest of the stream
+    coalescer->cancelRequest(handle);
+    platform.stream(request, 2, "le");
+    CHECK(first == "ti");
+    CHECK(second == "le");
+
+    platform.respond(request, "tile");
+    CHECK(responses == 1);
+
+    // No content is passed after the response
+    platform.stream(request, 4, "!");
+    CHECK(second == "le");
+}
@@ -0,0 +1,54 @@
+#include "catch.hpp"
+
+#include "util/mapProjection.h"
+#include "view/view.h"
+
+#include <set>
+
+using namespace Tangram;
+
+#define TAGS "[View]"
+
+static std::set<TileID> visibleTiles(float _pitchDegrees, float _maxTileScreenSize) {
+    View view(1920, 1080);
+    view.setZoom(16.5f);
+    view.setMaxPitch(90.f);
+    view.setPitch(_pitchDegrees * PI / 180.f);
+    view.setMaxTileScreenSize(_maxTileScreenSize);
+    view.setCenterCoordinates(LngLat(-74.00, 40.71));
+    view.update();
+
+    std::set<TileID> tiles;
+    view.getVisibleTiles([&](TileID _tileID) { tiles.insert(_tileID); });
+    return tiles;
+}
+
+static bool hasOverlappingTiles(const std::set<TileID>& _tiles) {
+    for (auto tileID : _tiles) {
+        while (tileID.z > 0) {
+            tileID = tileID.getParent();
+            if (_tiles.count(tileID)) { return true; }
+        }
+    }
+    return false;
+}
+
+TEST_CASE("Select visible tiles by their screen size", TAGS) {
+
+    // Tiles of an untilted view are displayed at less than 512 pixels
+    auto tiles = visibleTiles(0, 512);
+    CHECK(tiles == visibleTiles(0, 0));
+
+    for (float pitch : { 45.f, 70.f, 80.f }) {
+        auto detailed = visibleTiles(pitch, 256);
+        auto coarse = visibleTiles(pitch, 1024);
+
+        CHECK(!hasOverlappingTiles(detailed));
+        CHECK(!hasOverlappingTiles(coarse));
+        CHECK(coarse.size() < detailed.size());
+
+        for (const auto& tileID : coarse) {
+            CHECK(tileID.z <= 16);
+        }
+    }
+}